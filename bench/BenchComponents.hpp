@@ -0,0 +1,110 @@
+#ifndef BENCHCOMPONENTS_HPP_
+#define BENCHCOMPONENTS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <benchmark/benchmark.h>
+
+namespace Bench {
+    struct position : public Engine::Component
+    {
+        public:
+            float x = 0;
+            float y = 0;
+
+            position() = default;
+            position(float aX, float aY)
+                : x(aX),
+                  y(aY)
+            {}
+
+            static constexpr auto fields = std::make_tuple(&position::x, &position::y);
+    };
+
+    struct velocity : public Engine::Component
+    {
+        public:
+            float x = 1;
+            float y = 1;
+
+            static constexpr auto fields = std::make_tuple(&velocity::x, &velocity::y);
+    };
+
+    struct health : public Engine::Component
+    {
+        public:
+            int value = 100;
+    };
+
+    struct mass : public Engine::Component
+    {
+        public:
+            float value = 1;
+    };
+
+    /**
+     * @brief A component in a PackedArray, to compare the storages
+     */
+    struct packedPosition : public position
+    {
+        public:
+            using storageTag = Engine::Core::PackedStorage;
+    };
+
+    struct packedVelocity : public velocity
+    {
+        public:
+            using storageTag = Engine::Core::PackedStorage;
+    };
+
+    /**
+     * @brief A component in a PagedArray, to compare the storages
+     */
+    struct pagedPosition : public position
+    {
+        public:
+            using storageTag = Engine::Core::PagedStorage;
+    };
+
+    /**
+     * @brief Plain components without the Component base, stored as SoA columns
+     */
+    struct columnPosition
+    {
+        public:
+            float x = 0;
+            float y = 0;
+
+            static constexpr auto fields = std::make_tuple(&columnPosition::x, &columnPosition::y);
+    };
+
+    struct columnVelocity
+    {
+        public:
+            float x = 1;
+            float y = 1;
+
+            static constexpr auto fields = std::make_tuple(&columnVelocity::x, &columnVelocity::y);
+    };
+
+    /**
+     * @brief The entity counts every scaling benchmark runs with
+     */
+    inline void entityCounts(benchmark::internal::Benchmark *aBenchmark)
+    {
+        aBenchmark->RangeMultiplier(10)->Range(1000, 1000000);
+    }
+
+    /**
+     * @brief Check if an entity gets the optional components for a density in percent
+     */
+    inline bool inDensity(std::size_t aEntity, std::int64_t aDensity)
+    {
+        return static_cast<std::int64_t>(aEntity % 100) < aDensity;
+    }
+} // namespace Bench
+
+#endif /* !BENCHCOMPONENTS_HPP_ */
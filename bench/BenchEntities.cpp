@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#include "BenchComponents.hpp"
+
+namespace {
+    void createKillChurn(benchmark::State &aState)
+    {
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        Engine::Core::World world;
+        std::vector<Engine::Core::Entity> entities(count);
+
+        world.registerComponents<Bench::position, Bench::velocity>();
+        for (auto _ : aState) {
+            for (auto &entity : entities) {
+                entity = world.createEntity();
+            }
+            for (const auto &entity : entities) {
+                world.killEntity(entity);
+            }
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    void createKillBatch(benchmark::State &aState)
+    {
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        Engine::Core::World world;
+
+        world.registerComponents<Bench::position, Bench::velocity>();
+        for (auto _ : aState) {
+            const auto entities = world.createEntities(count);
+
+            world.killEntities(entities);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    void spawnBatch(benchmark::State &aState)
+    {
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        Engine::Core::World world;
+
+        world.registerComponents<Bench::position, Bench::velocity>();
+        for (auto _ : aState) {
+            const auto entities = world.spawnBatch<Bench::position, Bench::velocity>(count, [](std::size_t aIdx) {
+                return std::tuple(Bench::position(static_cast<float>(aIdx), 0), Bench::velocity {});
+            });
+
+            world.killEntities(entities);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    template<typename Position>
+    void addComponent(benchmark::State &aState)
+    {
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        Engine::Core::World world;
+
+        world.registerComponent<Position>();
+        const auto entities = world.createEntities(count);
+
+        for (auto _ : aState) {
+            for (const auto &entity : entities) {
+                world.addComponentToEntity(entity, Position {});
+            }
+            aState.PauseTiming();
+            for (const auto &entity : entities) {
+                world.removeComponentFromEntity<Position>(entity);
+            }
+            aState.ResumeTiming();
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    template<typename Position>
+    void emplaceComponent(benchmark::State &aState)
+    {
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        Engine::Core::World world;
+
+        world.registerComponent<Position>();
+        const auto entities = world.createEntities(count);
+
+        for (auto _ : aState) {
+            for (const auto &entity : entities) {
+                world.emplaceComponentToEntity<Position>(entity);
+            }
+            aState.PauseTiming();
+            for (const auto &entity : entities) {
+                world.removeComponentFromEntity<Position>(entity);
+            }
+            aState.ResumeTiming();
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Create the entities one by one with a component, the storage grows from empty
+     */
+    template<typename Position>
+    void growComponent(benchmark::State &aState)
+    {
+        const auto count = static_cast<std::size_t>(aState.range(0));
+
+        for (auto _ : aState) {
+            Engine::Core::World world;
+
+            world.registerComponent<Position>();
+            for (std::size_t idx = 0; idx < count; idx++) {
+                world.emplaceComponentToEntity<Position>(world.createEntity());
+            }
+            benchmark::DoNotOptimize(&world);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    void archetypeAddComponent(benchmark::State &aState)
+    {
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        Engine::Core::ArchetypeWorld world;
+        std::vector<Engine::Core::ArchetypeWorld::id> entities(count);
+
+        world.registerComponents<Bench::position, Bench::velocity>();
+        for (auto &entity : entities) {
+            entity = world.createEntity();
+            world.addComponentToEntity(entity, Bench::position {});
+        }
+        for (auto _ : aState) {
+            for (const auto &entity : entities) {
+                world.addComponentToEntity(entity, Bench::velocity {});
+            }
+            aState.PauseTiming();
+            for (const auto &entity : entities) {
+                world.removeComponentFromEntity<Bench::velocity>(entity);
+            }
+            aState.ResumeTiming();
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+} // namespace
+
+BENCHMARK(createKillChurn)->Apply(Bench::entityCounts);
+BENCHMARK(createKillBatch)->Apply(Bench::entityCounts);
+BENCHMARK(spawnBatch)->Apply(Bench::entityCounts);
+BENCHMARK(addComponent<Bench::position>)->Name("addComponent/sparse")->Apply(Bench::entityCounts);
+BENCHMARK(addComponent<Bench::packedPosition>)->Name("addComponent/packed")->Apply(Bench::entityCounts);
+BENCHMARK(emplaceComponent<Bench::position>)->Name("emplaceComponent/sparse")->Apply(Bench::entityCounts);
+BENCHMARK(emplaceComponent<Bench::packedPosition>)->Name("emplaceComponent/packed")->Apply(Bench::entityCounts);
+BENCHMARK(emplaceComponent<Bench::pagedPosition>)->Name("emplaceComponent/paged")->Apply(Bench::entityCounts);
+BENCHMARK(growComponent<Bench::position>)->Name("growComponent/sparse")->Apply(Bench::entityCounts);
+BENCHMARK(growComponent<Bench::packedPosition>)->Name("growComponent/packed")->Apply(Bench::entityCounts);
+BENCHMARK(growComponent<Bench::pagedPosition>)->Name("growComponent/paged")->Apply(Bench::entityCounts);
+BENCHMARK(archetypeAddComponent)->Apply(Bench::entityCounts);
@@ -0,0 +1,69 @@
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "BenchComponents.hpp"
+
+namespace {
+    struct benchEvent : public Engine::Event::Event
+    {
+        public:
+            explicit benchEvent(int aValue)
+                : value(aValue)
+            {}
+
+            int value;
+    };
+
+    void pushDrain(benchmark::State &aState)
+    {
+        const auto count = static_cast<int>(aState.range(0));
+        Engine::Event::EventManager manager;
+
+        manager.initEventHandler<benchEvent>();
+        for (auto _ : aState) {
+            for (int idx = 0; idx < count; idx++) {
+                manager.pushEvent(benchEvent {idx});
+            }
+            manager.swapBuffers();
+            manager.forEachEvent<benchEvent>([](std::size_t, const benchEvent &aEvent) {
+                benchmark::DoNotOptimize(aEvent.value);
+            });
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Every producer pushes its share of the events at once, then the frame is swapped
+     */
+    void pushProducers(benchmark::State &aState)
+    {
+        const auto producers = static_cast<std::size_t>(aState.range(0));
+        const auto perProducer = static_cast<int>(aState.range(1));
+        Engine::Event::EventManager manager;
+
+        manager.initEventHandler<benchEvent>();
+        for (auto _ : aState) {
+            std::vector<std::thread> threads;
+
+            threads.reserve(producers);
+            for (std::size_t producer = 0; producer < producers; producer++) {
+                threads.emplace_back([&manager, perProducer] {
+                    for (int idx = 0; idx < perProducer; idx++) {
+                        manager.pushEvent(benchEvent {idx});
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            manager.swapBuffers();
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0) * aState.range(1));
+    }
+} // namespace
+
+BENCHMARK(pushDrain)->Apply(Bench::entityCounts);
+BENCHMARK(pushProducers)
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {10000}})
+    ->ArgNames({"producers", "events"})
+    ->UseRealTime();
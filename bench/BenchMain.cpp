@@ -0,0 +1,4 @@
+#include <benchmark/benchmark.h>
+
+// Run with --benchmark_out=<file> --benchmark_out_format=json to keep the results
+BENCHMARK_MAIN();
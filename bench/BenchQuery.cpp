@@ -0,0 +1,247 @@
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "BenchComponents.hpp"
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+namespace {
+    /**
+     * @brief Fill a World: every entity has a position, the density in percent of them get the other components
+     */
+    template<typename Position, typename Velocity>
+    void populate(Engine::Core::World &aWorld, std::size_t aCount, std::int64_t aDensity)
+    {
+        aWorld.registerComponents<Position, Velocity, Bench::health, Bench::mass>();
+        for (const auto &entity : aWorld.createEntities(aCount)) {
+            aWorld.addComponentToEntity(entity, Position {});
+            if (Bench::inDensity(entity.index, aDensity)) {
+                aWorld.addComponentToEntity(entity, Velocity {});
+                aWorld.addComponentToEntity(entity, Bench::health {});
+                aWorld.addComponentToEntity(entity, Bench::mass {});
+            }
+        }
+    }
+
+    template<typename Position, typename Velocity, typename... Others>
+    void forEach(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+
+        populate<Position, Velocity>(world, static_cast<std::size_t>(aState.range(0)), aState.range(1));
+        for (auto _ : aState) {
+            world.query<Position, Velocity, Others...>().forEach([](Position &aPosition, Velocity &aVelocity,
+                                                                    Others &...aOthers) {
+                aPosition.x += aVelocity.x;
+                aPosition.y += aVelocity.y;
+                benchmark::DoNotOptimize(&aPosition);
+                (benchmark::DoNotOptimize(&aOthers), ...);
+            });
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    template<typename Position>
+    void forEachSingle(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+
+        populate<Position, Bench::velocity>(world, static_cast<std::size_t>(aState.range(0)), aState.range(1));
+        for (auto _ : aState) {
+            world.query<Position>().forEach([](Position &aPosition) {
+                aPosition.x += 1;
+                benchmark::DoNotOptimize(&aPosition);
+            });
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    void forEachParallel(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        Engine::Core::JobSystem jobs(static_cast<std::size_t>(aState.range(1)));
+
+        populate<Bench::position, Bench::velocity>(world, static_cast<std::size_t>(aState.range(0)), 100);
+        for (auto _ : aState) {
+            world.query<Bench::position, Bench::velocity>().forEachParallel(
+                [](Bench::position &aPosition, Bench::velocity &aVelocity) {
+                    aPosition.x += aVelocity.x;
+                    aPosition.y += aVelocity.y;
+                    benchmark::DoNotOptimize(&aPosition);
+                },
+                0, jobs);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Visit the positions written since the last iteration, the density in percent of them are written each
+     * iteration: spread over the entities, or the first ones when clustered
+     */
+    void changedSince(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        const auto clustered = aState.range(2) != 0;
+        std::vector<std::size_t> writes;
+
+        populate<Bench::position, Bench::velocity>(world, count, 100);
+        for (std::size_t idx = 0; idx < count; idx++) {
+            if (clustered ? idx * 100 < count * static_cast<std::size_t>(aState.range(1))
+                          : Bench::inDensity(idx, aState.range(1))) {
+                writes.push_back(idx);
+            }
+        }
+        auto &positions = world.getComponent<Bench::position>();
+
+        for (auto _ : aState) {
+            const auto lastTick = world.getChangeTick();
+
+            world.advanceChangeTick();
+            for (const auto idx : writes) {
+                positions[idx].x += 1;
+            }
+            world.query<const Bench::position>().changedSince(lastTick).forEach([](const Bench::position &aPosition) {
+                benchmark::DoNotOptimize(&aPosition);
+            });
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Add a scaled column to another, the kernel of an integration step
+     */
+    void integrate(std::span<float> aOut, std::span<const float> aIn, float aScale)
+    {
+        std::size_t idx = 0;
+
+#if defined(__AVX2__)
+        const auto scale = _mm256_set1_ps(aScale);
+
+        for (; idx + 8 <= aOut.size(); idx += 8) {
+            const auto out = _mm256_loadu_ps(aOut.data() + idx);
+
+            _mm256_storeu_ps(aOut.data() + idx, _mm256_fmadd_ps(_mm256_loadu_ps(aIn.data() + idx), scale, out));
+        }
+#endif
+        for (; idx < aOut.size(); idx++) {
+            aOut[idx] += aIn[idx] * aScale;
+        }
+    }
+
+    void forEachBatch(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+
+        populate<Bench::columnPosition, Bench::columnVelocity>(world, static_cast<std::size_t>(aState.range(0)),
+                                                               aState.range(1));
+        for (auto _ : aState) {
+            world.query<Bench::columnPosition, const Bench::columnVelocity>().forEachBatch(
+                [](auto aPosition, auto aVelocity) {
+                    integrate(aPosition.template field<&Bench::columnPosition::x>(),
+                              aVelocity.template field<&Bench::columnVelocity::x>(), 0.016F);
+                    integrate(aPosition.template field<&Bench::columnPosition::y>(),
+                              aVelocity.template field<&Bench::columnVelocity::y>(), 0.016F);
+                });
+            benchmark::ClobberMemory();
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Propagate the positions from the parents to the children of trees with four children per entity, level
+     * by level on a number of threads
+     */
+    void forEachByDepth(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        Engine::Core::JobSystem jobs(static_cast<std::size_t>(aState.range(1)));
+        const auto &hierarchy = world.getHierarchy();
+
+        populate<Bench::position, Bench::velocity>(world, static_cast<std::size_t>(aState.range(0)), 100);
+        for (std::size_t idx = 1; idx < world.getCurrentId(); idx++) {
+            world.setParent(world.getEntity(idx), world.getEntity((idx - 1) / 4));
+        }
+        auto &positions = world.getComponent<Bench::position>();
+
+        for (auto _ : aState) {
+            world.query<Bench::position, const Bench::velocity>().forEachByDepthParallel(
+                [&positions, &hierarchy](std::size_t aIdx, Bench::position &aPosition,
+                                         const Bench::velocity &aVelocity) {
+                    const auto &parent = positions.get(hierarchy.getParent(aIdx));
+
+                    aPosition.x = parent.x + aVelocity.x;
+                    aPosition.y = parent.y + aVelocity.y;
+                },
+                0, jobs);
+            benchmark::ClobberMemory();
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    void archetypeForEach(benchmark::State &aState)
+    {
+        Engine::Core::ArchetypeWorld world;
+
+        world.registerComponents<Bench::position, Bench::velocity, Bench::health, Bench::mass>();
+        for (std::size_t idx = 0; idx < static_cast<std::size_t>(aState.range(0)); idx++) {
+            const auto entity = world.createEntity();
+
+            world.addComponentToEntity(entity, Bench::position {});
+            if (Bench::inDensity(idx, aState.range(1))) {
+                world.addComponentToEntity(entity, Bench::velocity {});
+            }
+        }
+        for (auto _ : aState) {
+            world.query<Bench::position, Bench::velocity>().forEach(
+                [](Bench::position &aPosition, Bench::velocity &aVelocity) {
+                    aPosition.x += aVelocity.x;
+                    aPosition.y += aVelocity.y;
+                    benchmark::DoNotOptimize(&aPosition);
+                });
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief The entity counts, times the densities in percent of the entities matching the query
+     */
+    void countsAndDensities(benchmark::internal::Benchmark *aBenchmark)
+    {
+        for (const std::int64_t count : {1000, 10000, 100000, 1000000}) {
+            for (const std::int64_t density : {10, 100}) {
+                aBenchmark->Args({count, density});
+            }
+        }
+        aBenchmark->ArgNames({"entities", "density"});
+    }
+} // namespace
+
+BENCHMARK(forEachSingle<Bench::position>)->Name("forEach1/sparse")->Apply(countsAndDensities);
+BENCHMARK(forEachSingle<Bench::packedPosition>)->Name("forEach1/packed")->Apply(countsAndDensities);
+BENCHMARK(forEachSingle<Bench::pagedPosition>)->Name("forEach1/paged")->Apply(countsAndDensities);
+BENCHMARK(forEach<Bench::position, Bench::velocity>)->Name("forEach2/sparse")->Apply(countsAndDensities);
+BENCHMARK(forEach<Bench::packedPosition, Bench::packedVelocity>)
+    ->Name("forEach2/packed")
+    ->Apply(countsAndDensities);
+BENCHMARK(forEach<Bench::position, Bench::velocity, Bench::health>)
+    ->Name("forEach3/sparse")
+    ->Apply(countsAndDensities);
+BENCHMARK(forEach<Bench::position, Bench::velocity, Bench::health, Bench::mass>)
+    ->Name("forEach4/sparse")
+    ->Apply(countsAndDensities);
+BENCHMARK(changedSince)
+    ->ArgsProduct({{100000, 1000000}, {5, 100}, {0, 1}})
+    ->ArgNames({"entities", "density", "clustered"});
+BENCHMARK(forEachBatch)->Name("forEach2/columns")->Apply(countsAndDensities);
+BENCHMARK(archetypeForEach)->Name("forEach2/archetype")->Apply(countsAndDensities);
+BENCHMARK(forEachParallel)
+    ->ArgsProduct({{100000, 1000000}, {1, 2, 4, 8, 16, 32}})
+    ->ArgNames({"entities", "threads"})
+    ->UseRealTime();
+BENCHMARK(forEachByDepth)
+    ->ArgsProduct({{100000, 1000000}, {1, 4, 16}})
+    ->ArgNames({"entities", "threads"})
+    ->UseRealTime();
@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+#include "BenchComponents.hpp"
+
+namespace {
+    template<typename Position = Bench::position, typename Velocity = Bench::velocity>
+    void populate(Engine::Core::World &aWorld, std::size_t aCount)
+    {
+        aWorld.registerComponents<Position, Velocity>();
+        for (const auto &entity : aWorld.createEntities(aCount)) {
+            aWorld.addComponentToEntity(entity, Position {});
+            aWorld.addComponentToEntity(entity, Velocity {});
+        }
+    }
+
+    void snapshot(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+
+        populate(world, static_cast<std::size_t>(aState.range(0)));
+        for (auto _ : aState) {
+            benchmark::DoNotOptimize(world.snapshot());
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    void restore(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+
+        populate(world, static_cast<std::size_t>(aState.range(0)));
+        const auto data = world.snapshot();
+
+        for (auto _ : aState) {
+            world.restore(data);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Restore a new World from a snapshot file, against restore from memory and building it entity by entity
+     */
+    void restoreFile(benchmark::State &aState)
+    {
+        const auto path = std::filesystem::temp_directory_path() / "stellarBenchSnapshot.bin";
+        {
+            Engine::Core::World world;
+
+            populate(world, static_cast<std::size_t>(aState.range(0)));
+            world.snapshot(path);
+        }
+        for (auto _ : aState) {
+            Engine::Core::World world;
+
+            world.registerComponents<Bench::position, Bench::velocity>();
+            world.restore(path);
+        }
+        std::filesystem::remove(path);
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Restore a new World of columns from a snapshot file, the columns are adopted from the mapping
+     */
+    void restoreColumnsFile(benchmark::State &aState)
+    {
+        const auto path = std::filesystem::temp_directory_path() / "stellarBenchColumns.bin";
+        {
+            Engine::Core::World world;
+
+            populate<Bench::columnPosition, Bench::columnVelocity>(world, static_cast<std::size_t>(aState.range(0)));
+            world.snapshot(path);
+        }
+        for (auto _ : aState) {
+            Engine::Core::World world;
+
+            world.registerComponents<Bench::columnPosition, Bench::columnVelocity>();
+            world.restore(path);
+        }
+        std::filesystem::remove(path);
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    void rebuild(benchmark::State &aState)
+    {
+        for (auto _ : aState) {
+            Engine::Core::World world;
+
+            populate(world, static_cast<std::size_t>(aState.range(0)));
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+} // namespace
+
+BENCHMARK(snapshot)->Apply(Bench::entityCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK(restore)->Apply(Bench::entityCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK(restoreFile)->Apply(Bench::entityCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK(restoreColumnsFile)->Apply(Bench::entityCounts)->Unit(benchmark::kMillisecond);
+BENCHMARK(rebuild)->Apply(Bench::entityCounts)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,144 @@
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include "BenchComponents.hpp"
+
+namespace {
+    /**
+     * @brief A position with a collision radius
+     */
+    struct body : public Engine::Component
+    {
+        public:
+            body(float aX, float aY, float aRadius)
+                : x(aX),
+                  y(aY),
+                  radius(aRadius)
+            {}
+
+            float x;
+            float y;
+            float radius;
+    };
+
+    /**
+     * @brief Spread bodies at a constant density, each overlaps a few others
+     */
+    float populate(Engine::Core::World &aWorld, std::size_t aCount)
+    {
+        const auto side = std::sqrt(static_cast<float>(aCount)) * 8;
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> coordinate(0, side);
+
+        aWorld.registerComponents<body>();
+        for (const auto &entity : aWorld.createEntities(aCount)) {
+            aWorld.addComponentToEntity(entity, body {coordinate(random), coordinate(random), 2});
+        }
+        return side;
+    }
+
+    template<typename Index>
+    Index &enable(Engine::Core::World &aWorld, float aSide)
+    {
+        if constexpr (std::is_same_v<Index, Engine::Core::HashGrid>) {
+            return aWorld.enableSpatial<body, Index>(8.F);
+        } else {
+            return aWorld.enableSpatial<body, Index>(Engine::Core::Aabb {0, 0, aSide, aSide}, 8);
+        }
+    }
+
+    /**
+     * @brief The broad phase written as a query nested in a query, the baseline of findPairs
+     */
+    void pairsBruteForce(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+
+        populate(world, static_cast<std::size_t>(aState.range(0)));
+        for (auto _ : aState) {
+            std::size_t pairs = 0;
+
+            world.query<const body>().forEach([&world, &pairs](std::size_t aIdx, const body &aBody) {
+                world.query<const body>().forEach([&pairs, aIdx, &aBody](std::size_t aOther, const body &aOtherBody) {
+                    const auto dx = aBody.x - aOtherBody.x;
+                    const auto dy = aBody.y - aOtherBody.y;
+                    const auto reach = aBody.radius + aOtherBody.radius;
+
+                    pairs += static_cast<std::size_t>(aOther > aIdx && dx * dx + dy * dy <= reach * reach);
+                });
+            });
+            benchmark::DoNotOptimize(pairs);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    template<typename Index>
+    void findPairs(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        Engine::Core::JobSystem jobs(1);
+        const auto side = populate(world, static_cast<std::size_t>(aState.range(0)));
+        const auto &index = enable<Index>(world, side);
+
+        world.updateSpatial(jobs);
+        for (auto _ : aState) {
+            benchmark::DoNotOptimize(index.findPairs(jobs));
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    template<typename Index>
+    void queryRadius(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        Engine::Core::JobSystem jobs(1);
+        const auto side = populate(world, static_cast<std::size_t>(aState.range(0)));
+        const auto &index = enable<Index>(world, side);
+        std::vector<std::size_t> found;
+
+        world.updateSpatial(jobs);
+        for (auto _ : aState) {
+            found.clear();
+            index.queryRadius(side / 2, side / 2, 32, found);
+            benchmark::DoNotOptimize(found.data());
+        }
+    }
+
+    /**
+     * @brief Move a tenth of the bodies then bring the index up to date
+     */
+    template<typename Index>
+    void update(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        Engine::Core::JobSystem jobs(1);
+        const auto side = populate(world, static_cast<std::size_t>(aState.range(0)));
+
+        enable<Index>(world, side);
+        world.updateSpatial(jobs);
+        for (auto _ : aState) {
+            world.advanceChangeTick();
+            world.query<body>().forEach([](std::size_t aIdx, body &aBody) {
+                if (aIdx % 10 == 0) {
+                    aBody.x += 1;
+                }
+            });
+            world.updateSpatial(jobs);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0) / 10);
+    }
+} // namespace
+
+BENCHMARK(pairsBruteForce)->RangeMultiplier(10)->Range(1000, 10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(findPairs<Engine::Core::HashGrid>)
+    ->Name("findPairs/grid")
+    ->Apply(Bench::entityCounts)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(findPairs<Engine::Core::LooseQuadtree>)
+    ->Name("findPairs/quadtree")
+    ->Apply(Bench::entityCounts)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(queryRadius<Engine::Core::HashGrid>)->Name("queryRadius/grid")->Apply(Bench::entityCounts);
+BENCHMARK(queryRadius<Engine::Core::LooseQuadtree>)->Name("queryRadius/quadtree")->Apply(Bench::entityCounts);
+BENCHMARK(update<Engine::Core::HashGrid>)->Name("updateSpatial/grid")->Apply(Bench::entityCounts);
+BENCHMARK(update<Engine::Core::LooseQuadtree>)->Name("updateSpatial/quadtree")->Apply(Bench::entityCounts);
@@ -0,0 +1,93 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "BenchComponents.hpp"
+
+namespace {
+    template<typename Component>
+    struct layer : public Engine::Component
+    {
+        public:
+            float value = 0;
+    };
+
+    /**
+     * @brief A system with an empty body, only the dispatch and the query cost
+     */
+    void emptySystem(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+
+        world.registerComponent<Bench::position>();
+        for (const auto &entity : world.createEntities(static_cast<std::size_t>(aState.range(0)))) {
+            world.addComponentToEntity(entity, Bench::position {});
+        }
+        auto system = Engine::Core::createSystem<Bench::position>(world, "empty", [](Bench::position &) {});
+
+        world.addSystem(system);
+        for (auto _ : aState) {
+            world.runSystems();
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+
+    /**
+     * @brief Eight systems on disjoint components, the scheduler runs them concurrently
+     */
+    void disjointSystems(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        Engine::Core::JobSystem jobs;
+        const auto count = static_cast<std::size_t>(aState.range(0));
+        const auto addLayer = [&world, count]<std::size_t Layer>() {
+            using component = layer<std::integral_constant<std::size_t, Layer>>;
+
+            world.registerComponent<component>();
+            for (std::size_t idx = 0; idx < count; idx++) {
+                world.addComponentToEntity(idx, component {});
+            }
+            auto system = Engine::Core::createSystem<component>(world, "layer" + std::to_string(Layer),
+                                                                [](component &aComponent) {
+                                                                    aComponent.value += 1;
+                                                                });
+
+            world.addSystem(system);
+        };
+
+        world.createEntities(count);
+        [&addLayer]<std::size_t... Layers>(std::index_sequence<Layers...>) {
+            (addLayer.template operator()<Layers>(), ...);
+        }(std::make_index_sequence<8> {});
+        for (auto _ : aState) {
+            world.runSystems(jobs);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0) * 8);
+    }
+
+    /**
+     * @brief The cost of the scheduler alone: many systems on no entity
+     */
+    void dispatchOverhead(benchmark::State &aState)
+    {
+        Engine::Core::World world;
+        Engine::Core::JobSystem jobs;
+
+        world.registerComponent<Bench::position>();
+        for (std::int64_t idx = 0; idx < aState.range(0); idx++) {
+            auto system = Engine::Core::createSystem<const Bench::position>(world, "system" + std::to_string(idx),
+                                                                            [](const Bench::position &) {});
+
+            world.addSystem(system);
+        }
+        for (auto _ : aState) {
+            world.runSystems(jobs);
+        }
+        aState.SetItemsProcessed(aState.iterations() * aState.range(0));
+    }
+} // namespace
+
+BENCHMARK(emptySystem)->Apply(Bench::entityCounts);
+BENCHMARK(disjointSystems)->Apply(Bench::entityCounts)->UseRealTime();
+BENCHMARK(dispatchOverhead)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
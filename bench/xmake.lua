@@ -0,0 +1,38 @@
+-- Add the packages required
+add_requires("benchmark", "boost", "fmt", "spdlog", {system = false})
+
+-- Create the Stellar-Engine-Bench project
+target("bench")
+
+    -- Set the project kind to binary
+    set_kind("binary")
+
+    -- Set the target directory to bin
+    set_targetdir("../bin")
+
+    -- Check if the platform is Windows
+    if is_plat("windows") then
+        -- Set the C++ standard to C++20 for MSVC
+        add_cxxflags("/std:c++20", {force = true})
+    else
+        -- For other platforms (e.g., Linux)
+        add_cxxflags("-std=c++20", "-lstdc++")
+    end
+
+    -- Benchmarks are only meaningful optimized
+    set_optimize("fastest")
+
+    -- Add the source files
+    add_files("**.cpp")
+
+    -- Add Stellar-Engine as a dependency
+    add_deps("Stellar-Engine")
+
+    -- Add the include directories
+    add_includedirs("../includes", "../includes/Core", "../includes/Core/Components", "../includes/Core/Events", "../includes/Core/Systems", {public = true})
+
+    -- Add the packages required
+    add_packages("benchmark", "boost", "fmt", "spdlog")
+
+    -- Write the results as JSON next to the binary, run with --benchmark_out=<file> to choose another file
+    set_runargs("--benchmark_out=bench.json", "--benchmark_out_format=json")
@@ -1,8 +1,15 @@
 #ifndef APP_HPP_
 #define APP_HPP_
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 #include "Core/Events/Event.hpp"
+#include "Core/Jobs/JobSystem.hpp"
 #include "Exception.hpp"
 #include "World.hpp"
 #include <boost/container/flat_map.hpp>
@@ -17,6 +24,32 @@ namespace Engine {
     template<typename T> // must not be a component or a system or an event
     concept KeyConcept = !ComponentConcept<T> && !Event::EventConcept<T>;
 
+    /**
+     * @brief The timings of the steps of a world, in seconds
+     */
+    struct WorldStats
+    {
+        public:
+            std::size_t steps = 0;
+            double lastStepTime = 0;
+            double maxStepTime = 0;
+            double totalStepTime = 0;
+
+            /**
+             * @brief Get the average duration of a step
+             */
+            [[nodiscard]] double getAverageStepTime() const
+            {
+                return steps == 0 ? 0 : totalStepTime / static_cast<double>(steps);
+            }
+    };
+
+    /**
+     * @brief The App holds the worlds of the process and steps them concurrently on the job system
+     * @details Adding and removing worlds is safe while stepAll runs on another thread: a world added during a step is
+     * stepped from the next one, a world removed during a step is destroyed once the step is over. The other methods
+     * must not run concurrently with stepAll
+     */
     template<KeyConcept Key = std::size_t>
     class App
     {
@@ -24,9 +57,26 @@ namespace Engine {
             using world = std::unique_ptr<Core::World>;
             using worlds = boost::container::flat_map<Key, world>;
 
+            static constexpr std::size_t anyWorker = Core::JobSystem::npos;
+
         private:
+            /**
+             * @brief The scheduling of a world
+             */
+            struct WorldState
+            {
+                    bool paused = false;
+                    std::size_t affinity = anyWorker;
+                    WorldStats stats;
+            };
+
             worlds _worlds;
+            boost::container::flat_map<Key, std::unique_ptr<WorldState>> _states;
             Key _currentWorld;
+            std::mutex _mutex;
+            bool _stepping = false;
+            std::vector<std::pair<world, std::unique_ptr<WorldState>>> _removedWhileStepping;
+            std::chrono::steady_clock::time_point _lastRun {};
 
         public:
 #pragma region constructors / destructors
@@ -60,10 +110,13 @@ namespace Engine {
              */
             world &addWorld(const Key &aKey, world &&aWorld)
             {
+                std::lock_guard<std::mutex> lock(_mutex);
+
                 if (_worlds.find(aKey) != _worlds.end()) {
                     throw AppExceptionKeyAlreadyExists("The key already exists");
                 }
                 _worlds[aKey] = std::move(aWorld);
+                _states[aKey] = std::make_unique<WorldState>();
                 return _worlds[aKey];
             }
 
@@ -75,11 +128,7 @@ namespace Engine {
              */
             world &addWorld(const Key &aKey)
             {
-                if (_worlds.find(aKey) != _worlds.end()) {
-                    throw AppExceptionKeyAlreadyExists("The key already exists");
-                }
-                _worlds[aKey] = std::make_unique<Core::World>();
-                return _worlds[aKey];
+                return addWorld(aKey, std::make_unique<Core::World>());
             }
 
             /**
@@ -90,10 +139,17 @@ namespace Engine {
              */
             void removeWorld(const Key &aKey)
             {
-                if (_worlds.find(aKey) == _worlds.end()) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                const auto found = _worlds.find(aKey);
+
+                if (found == _worlds.end()) {
                     throw AppExceptionKeyNotFound("The key doesn't exist");
                 }
-                _worlds.erase(aKey);
+                if (_stepping) {
+                    _removedWhileStepping.emplace_back(std::move(found->second), std::move(_states[aKey]));
+                }
+                _worlds.erase(found);
+                _states.erase(aKey);
             }
 
             /**
@@ -135,7 +191,149 @@ namespace Engine {
                 }
                 _currentWorld = key;
             }
+
+            /**
+             * @brief Step every world that isn't paused, concurrently, and wait for all of them
+             * @details Each world runs its systems in a job of the job system, on its pinned worker if it has an
+             * affinity. The systems of a world are themselves scheduled on the same job system
+             * @throw Rethrows the first exception thrown by a world, the other worlds still finish their step
+             * @param aDeltaTime The frame time given to every world, in seconds
+             * @param aJobSystem The job system running the worlds
+             */
+            void stepAll(double aDeltaTime, Core::JobSystem &aJobSystem = Core::JobSystem::getInstance())
+            {
+                std::vector<std::pair<Core::World *, WorldState *>> active;
+                Core::JobCounter counter;
+
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    for (auto &[key, state] : _states) {
+                        if (!state->paused && _worlds[key]) {
+                            active.emplace_back(_worlds[key].get(), state.get());
+                        }
+                    }
+                    _stepping = true;
+                }
+                for (auto [stepped, state] : active) {
+                    auto job = [stepped, stats = &state->stats, aDeltaTime, &aJobSystem] {
+                        const auto start = std::chrono::steady_clock::now();
+
+                        stepped->step(aDeltaTime, aJobSystem);
+
+                        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+                        stats->steps++;
+                        stats->lastStepTime = elapsed.count();
+                        stats->totalStepTime += elapsed.count();
+                        stats->maxStepTime = std::max(stats->maxStepTime, elapsed.count());
+                    };
+
+                    if (state->affinity == anyWorker) {
+                        aJobSystem.submit(std::move(job), counter);
+                    } else {
+                        aJobSystem.submitTo(state->affinity, std::move(job), counter);
+                    }
+                }
+                try {
+                    aJobSystem.wait(counter);
+                } catch (...) {
+                    endStep();
+                    throw;
+                }
+                endStep();
+            }
+
+            /**
+             * @brief Step every world that isn't paused, with the real time elapsed since the last call as frame time
+             *
+             * @param aJobSystem The job system running the worlds
+             */
+            void runAll(Core::JobSystem &aJobSystem = Core::JobSystem::getInstance())
+            {
+                const auto now = std::chrono::steady_clock::now();
+                const auto deltaTime = _lastRun == std::chrono::steady_clock::time_point {}
+                                           ? 0
+                                           : std::chrono::duration<double>(now - _lastRun).count();
+
+                _lastRun = now;
+                stepAll(deltaTime, aJobSystem);
+            }
+
+            /**
+             * @brief Stop stepping a world, its state is kept as is
+             * @throw AppExceptionKeyNotFound If the key doesn't exist
+             */
+            void pauseWorld(const Key &aKey)
+            {
+                getState(aKey).paused = true;
+            }
+
+            /**
+             * @brief Step a paused world again
+             * @throw AppExceptionKeyNotFound If the key doesn't exist
+             */
+            void resumeWorld(const Key &aKey)
+            {
+                getState(aKey).paused = false;
+            }
+
+            /**
+             * @brief Check if a world is paused
+             * @throw AppExceptionKeyNotFound If the key doesn't exist
+             */
+            [[nodiscard]] bool isWorldPaused(const Key &aKey)
+            {
+                return getState(aKey).paused;
+            }
+
+            /**
+             * @brief Pin the steps of a world to a worker, e.g. to keep its data in the caches of one core
+             * @throw AppExceptionKeyNotFound If the key doesn't exist
+             * @param aKey The key of the world
+             * @param aWorker The worker (modulo the number of workers), anyWorker to let any worker step it
+             */
+            void setWorldAffinity(const Key &aKey, std::size_t aWorker)
+            {
+                getState(aKey).affinity = aWorker;
+            }
+
+            /**
+             * @brief Get the timings of the steps of a world
+             * @throw AppExceptionKeyNotFound If the key doesn't exist
+             */
+            [[nodiscard]] WorldStats getWorldStats(const Key &aKey)
+            {
+                return getState(aKey).stats;
+            }
 #pragma endregion methods
+
+        private:
+            WorldState &getState(const Key &aKey)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                const auto found = _states.find(aKey);
+
+                if (found == _states.end()) {
+                    throw AppExceptionKeyNotFound("The key doesn't exist");
+                }
+                return *found->second;
+            }
+
+            /**
+             * @brief End a step, the worlds removed during the step are destroyed here
+             */
+            void endStep()
+            {
+                std::vector<std::pair<world, std::unique_ptr<WorldState>>> removed;
+
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    _stepping = false;
+                    removed.swap(_removedWhileStepping);
+                }
+            }
     };
 } // namespace Engine
 
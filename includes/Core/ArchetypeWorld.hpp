@@ -0,0 +1,415 @@
+#ifndef ARCHETYPEWORLD_HPP_
+#define ARCHETYPEWORLD_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Core/Archetypes/Archetype.hpp"
+#include "Core/Components/Component.hpp"
+#include "Exception.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "QueryCallback.hpp"
+#include "TypeRegistry.hpp"
+#include <boost/container/flat_map.hpp>
+
+namespace Engine::Core {
+    DEFINE_EXCEPTION(ArchetypeWorldException);
+    DEFINE_EXCEPTION_FROM(ArchetypeWorldExceptionComponentAlreadyRegistered, ArchetypeWorldException);
+    DEFINE_EXCEPTION_FROM(ArchetypeWorldExceptionComponentNotRegistered, ArchetypeWorldException);
+    DEFINE_EXCEPTION_FROM(ArchetypeWorldExceptionComponentNotFound, ArchetypeWorldException);
+    DEFINE_EXCEPTION_FROM(ArchetypeWorldExceptionEntityNotFound, ArchetypeWorldException);
+
+    /**
+     * @brief The archetype world is the chunked counterpart of World
+     * @details Entities having the same set of components are stored together, in fixed-size chunks of SoA columns.
+     * Queries match whole archetypes then stream through the columns of each chunk. Adding or removing a component
+     * moves the entity (and all of its components) to another archetype, the cost of these moves is tracked by
+     * getStats(). Structural changes (create, kill, add, remove) must not happen while iterating a query
+     */
+    class ArchetypeWorld
+    {
+        public:
+            using id = std::size_t;
+            using idsContainer = std::vector<id>;
+
+            /**
+             * @brief Counters of the archetype moves, to measure the cost of the structural changes
+             */
+            struct Stats
+            {
+                    std::size_t moves = 0;
+                    std::size_t componentsMoved = 0;
+                    std::size_t bytesMoved = 0;
+            };
+
+        private:
+            struct EntityLocation
+            {
+                    Archetype *archetype = nullptr;
+                    std::size_t row = 0;
+            };
+
+            Core::TypeRegistry<ComponentFamily, ComponentInfo> _componentInfos;
+            std::vector<std::unique_ptr<Archetype>> _archetypes;
+            boost::container::flat_map<Archetype::signature, Archetype *> _archetypeIndex;
+            std::vector<EntityLocation> _locations;
+            idsContainer _ids;
+            id _nextId = 0;
+            Stats _stats;
+
+            template<ComponentConcept... Components>
+            class Query
+            {
+                private:
+                    std::reference_wrapper<ArchetypeWorld> _world;
+                    std::array<std::size_t, sizeof...(Components)> _componentIds;
+                    Archetype::signature _required;
+
+                public:
+                    explicit Query(ArchetypeWorld &world)
+                        : _world(world),
+                          _componentIds {world.template getComponentId<Components>()...},
+                          _required(_componentIds.begin(), _componentIds.end())
+                    {
+                        std::sort(_required.begin(), _required.end());
+                    }
+
+                    /**
+                     * @brief Call the function once per non-empty chunk of the matching archetypes
+                     *
+                     * @param aFunc Callable as func(std::span<const id>, std::span<Components>...)
+                     */
+                    template<typename Func>
+                    void forEachChunk(Func &&aFunc)
+                    {
+                        for (const auto &archetype : _world.get()._archetypes) {
+                            if (!archetype->matches(_required)) {
+                                continue;
+                            }
+                            forEachChunkOf(*archetype, aFunc, std::index_sequence_for<Components...> {});
+                        }
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having all the components
+                     *
+                     * @param aDeltaTime The delta time forwarded to the function
+                     * @param aFunc Callable as func(world, deltaTime, idx, components...), func(idx, components...)
+                     * or func(components...)
+                     */
+                    template<QueryCallback<ArchetypeWorld, id, Components...> Func>
+                    void forEach(double aDeltaTime, Func &&aFunc)
+                    {
+                        auto &world = _world.get();
+
+                        forEachChunk([&world, aDeltaTime, &aFunc](std::span<const id> aIds,
+                                                                  std::span<Components>... aColumns) {
+                            for (std::size_t row = 0; row < aIds.size(); row++) {
+                                invokeQueryCallback(aFunc, world, aDeltaTime, aIds[row], aColumns[row]...);
+                            }
+                        });
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having all the components, with a null delta time
+                     *
+                     * @param aFunc Callable as func(idx, components...) or func(components...)
+                     */
+                    template<QueryCallback<ArchetypeWorld, id, Components...> Func>
+                    void forEach(Func &&aFunc)
+                    {
+                        forEach(0, std::forward<Func>(aFunc));
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having all the components, on the job system
+                     * @details The chunks of the matching archetypes are split in batches run concurrently, the call
+                     * returns once every batch is done. The function must be safe to call from several threads at
+                     * once
+                     * @param aDeltaTime The delta time forwarded to the function
+                     * @param aFunc Callable like for forEach
+                     * @param aChunksPerBatch The number of chunks per job, 0 to let the job system choose
+                     * @param aJobSystem The job system running the batches
+                     */
+                    template<QueryCallback<ArchetypeWorld, id, Components...> Func>
+                    void forEachParallel(double aDeltaTime, Func &&aFunc, std::size_t aChunksPerBatch = 0,
+                                         JobSystem &aJobSystem = JobSystem::getInstance())
+                    {
+                        std::vector<std::pair<const Archetype *, const Chunk *>> chunks;
+
+                        for (const auto &archetype : _world.get()._archetypes) {
+                            if (!archetype->matches(_required)) {
+                                continue;
+                            }
+                            for (const auto &chunk : archetype->getChunks()) {
+                                if (chunk->count() != 0) {
+                                    chunks.emplace_back(archetype.get(), chunk.get());
+                                }
+                            }
+                        }
+
+                        auto &world = _world.get();
+
+                        aJobSystem.parallelFor(
+                            0, chunks.size(), aChunksPerBatch,
+                            [this, &chunks, &aFunc, &world, aDeltaTime](std::size_t aBegin, std::size_t aEnd) {
+                                for (auto idx = aBegin; idx < aEnd; idx++) {
+                                    callChunk(*chunks[idx].first, *chunks[idx].second,
+                                              [&aFunc, &world, aDeltaTime](std::span<const id> aIds,
+                                                                           std::span<Components>... aColumns) {
+                                                  for (std::size_t row = 0; row < aIds.size(); row++) {
+                                                      invokeQueryCallback(aFunc, world, aDeltaTime, aIds[row],
+                                                                          aColumns[row]...);
+                                                  }
+                                              },
+                                              std::index_sequence_for<Components...> {});
+                                }
+                            });
+                    }
+
+                    /**
+                     * @brief Get all the entities having all the components
+                     */
+                    auto getAllEntities()
+                    {
+                        std::vector<id> entities;
+
+                        forEachChunk([&entities](std::span<const id> aIds, std::span<Components>... /*columns*/) {
+                            entities.insert(entities.end(), aIds.begin(), aIds.end());
+                        });
+                        return entities;
+                    }
+
+                private:
+                    template<typename Func, std::size_t... Is>
+                    void forEachChunkOf(const Archetype &aArchetype, Func &aFunc, std::index_sequence<Is...> /*seq*/)
+                    {
+                        const std::array<std::size_t, sizeof...(Components)> columns {
+                            aArchetype.columnOf(_componentIds[Is])...};
+
+                        for (const auto &chunk : aArchetype.getChunks()) {
+                            const auto count = chunk->count();
+
+                            if (count == 0) {
+                                continue;
+                            }
+                            aFunc(std::span<const id>(Archetype::entitiesOf(*chunk), count),
+                                  std::span<Components>(aArchetype.template column<Components>(*chunk, columns[Is]),
+                                                        count)...);
+                        }
+                    }
+
+                    template<typename Func, std::size_t... Is>
+                    void callChunk(const Archetype &aArchetype, const Chunk &aChunk, Func &&aFunc,
+                                   std::index_sequence<Is...> /*seq*/) const
+                    {
+                        const auto count = aChunk.count();
+
+                        aFunc(std::span<const id>(Archetype::entitiesOf(aChunk), count),
+                              std::span<Components>(aArchetype.template column<Components>(
+                                                        aChunk, aArchetype.columnOf(_componentIds[Is])),
+                                                    count)...);
+                    }
+            };
+
+        public:
+#pragma region constructors / destructors
+            ArchetypeWorld();
+            ~ArchetypeWorld() = default;
+
+            ArchetypeWorld(const ArchetypeWorld &other) = delete;
+            ArchetypeWorld &operator=(const ArchetypeWorld &other) = delete;
+
+            ArchetypeWorld(ArchetypeWorld &&other) noexcept = default;
+            ArchetypeWorld &operator=(ArchetypeWorld &&other) noexcept = default;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+
+            template<ComponentConcept... Components>
+            Query<Components...> query()
+            {
+                return Query<Components...>(*this);
+            }
+
+            /**
+             * @brief Add a component type to the World
+             *
+             * @tparam Component Type of the component
+             * @throw ArchetypeWorldExceptionComponentAlreadyRegistered If the component is already registered
+             */
+            template<ComponentConcept Component>
+            void registerComponent()
+            {
+                if (_componentInfos.template find<Component>() != _componentInfos.npos) {
+                    throw ArchetypeWorldExceptionComponentAlreadyRegistered("Component already registered");
+                }
+                _componentInfos.template insert<Component>(ComponentInfo::create<Component>(_componentInfos.size()));
+            }
+
+            /**
+             * @brief Add multiple component types to the World
+             *
+             * @tparam Components The components to add
+             */
+            template<ComponentConcept... Components>
+            void registerComponents()
+            {
+                (registerComponent<Components>(), ...);
+            }
+
+            /**
+             * @brief Check if the entity has all the components
+             *
+             * @tparam Components The components to check
+             * @param aIndex The index of the entity
+             */
+            template<ComponentConcept... Components>
+            [[nodiscard]] bool hasComponents(id aIndex) const
+            {
+                const auto &location = locationOf(aIndex);
+
+                return (... && (location.archetype->columnOf(getComponentId<Components>()) != Archetype::npos));
+            }
+
+            /**
+             * @brief Get the component of an entity
+             * @details The reference is invalidated by the next structural change of the entity's archetype
+             * @throw ArchetypeWorldExceptionComponentNotFound If the entity doesn't have the component
+             * @param aIndex The index of the entity
+             */
+            template<ComponentConcept Component>
+            Component &getComponentOfEntity(id aIndex)
+            {
+                const auto &location = locationOf(aIndex);
+                const auto column = location.archetype->columnOf(getComponentId<Component>());
+
+                if (column == Archetype::npos) {
+                    throw ArchetypeWorldExceptionComponentNotFound("Entity doesn't have the component");
+                }
+                return *std::launder(static_cast<Component *>(location.archetype->componentAt(column, location.row)));
+            }
+
+            /**
+             * @brief Add a component to an entity, moves the entity to the archetype having the component
+             *
+             * @param aIndex The index of the entity
+             * @param aComponent The component to add
+             * @return Component& The component added
+             */
+            template<ComponentConcept Component>
+            Component &addComponentToEntity(id aIndex, Component &&aComponent)
+            {
+                return emplaceComponentToEntity<Component>(aIndex, std::forward<Component>(aComponent));
+            }
+
+            /**
+             * @brief Build and add a component to an entity, moves the entity to the archetype having the component
+             *
+             * @param aIndex The index of the entity
+             * @param aArgs The arguments to pass to the component constructor
+             * @return Component& The component added
+             */
+            template<ComponentConcept Component, typename... Args>
+            Component &emplaceComponentToEntity(id aIndex, Args &&...aArgs)
+            {
+                const auto componentId = getComponentId<Component>();
+                const auto &location = locationOf(aIndex);
+                auto column = location.archetype->columnOf(componentId);
+
+                if (column != Archetype::npos) {
+                    auto *component =
+                        std::launder(static_cast<Component *>(location.archetype->componentAt(column, location.row)));
+
+                    *component = Component(std::forward<Args>(aArgs)...);
+                    return *component;
+                }
+                auto *destination = addEdge(*location.archetype, componentId);
+
+                moveEntity(aIndex, *destination);
+                column = destination->columnOf(componentId);
+                return *new (destination->componentAt(column, _locations[aIndex].row))
+                    Component(std::forward<Args>(aArgs)...);
+            }
+
+            /**
+             * @brief Remove a component from an entity, moves the entity to the archetype without the component
+             * @details Does nothing if the entity doesn't have the component
+             * @param aIndex The index of the entity
+             */
+            template<ComponentConcept Component>
+            void removeComponentFromEntity(id aIndex)
+            {
+                const auto componentId = getComponentId<Component>();
+                const auto &location = locationOf(aIndex);
+
+                if (location.archetype->columnOf(componentId) == Archetype::npos) {
+                    return;
+                }
+                moveEntity(aIndex, *removeEdge(*location.archetype, componentId));
+            }
+
+            /**
+             * @brief Create an entity, it starts in the archetype without components
+             *
+             * @return id The id of the entity
+             */
+            id createEntity();
+
+            /**
+             * @brief Kill an entity, destroy its components and add the id as a free id
+             *
+             * @param aIndex The index of the entity to kill
+             */
+            void killEntity(id aIndex);
+
+            /**
+             * @brief Get the Current Id object
+             *
+             * @return std::size_t The current id
+             */
+            [[nodiscard]] std::size_t getCurrentId() const;
+
+            /**
+             * @brief Get the number of archetypes created so far
+             */
+            [[nodiscard]] std::size_t getArchetypeCount() const;
+
+            /**
+             * @brief Get the counters of the archetype moves
+             */
+            [[nodiscard]] const Stats &getStats() const;
+
+            /**
+             * @brief Reset the counters of the archetype moves
+             */
+            void resetStats();
+
+        private:
+            template<ComponentConcept Component>
+            [[nodiscard]] std::size_t getComponentId() const
+            {
+                const auto componentId = _componentInfos.template find<Component>();
+
+                if (componentId == _componentInfos.npos) {
+                    throw ArchetypeWorldExceptionComponentNotRegistered("Component not registered");
+                }
+                return componentId;
+            }
+
+            [[nodiscard]] EntityLocation &locationOf(id aIndex);
+            [[nodiscard]] const EntityLocation &locationOf(id aIndex) const;
+            Archetype *findOrCreateArchetype(const Archetype::signature &aSignature);
+            Archetype *addEdge(Archetype &aSource, std::size_t aComponentId);
+            Archetype *removeEdge(Archetype &aSource, std::size_t aComponentId);
+            void moveEntity(id aIndex, Archetype &aDestination);
+#pragma endregion methods
+    };
+} // namespace Engine::Core
+
+#endif /* !ARCHETYPEWORLD_HPP_ */
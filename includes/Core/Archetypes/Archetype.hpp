@@ -0,0 +1,230 @@
+#ifndef ARCHETYPE_HPP_
+#define ARCHETYPE_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "Core/Components/Component.hpp"
+#include "Exception.hpp"
+#include <boost/container/flat_map.hpp>
+
+namespace Engine::Core {
+    DEFINE_EXCEPTION(ArchetypeException);
+    DEFINE_EXCEPTION_FROM(ArchetypeExceptionRowTooLarge, ArchetypeException);
+
+    /**
+     * @brief Type-erased description of a component type, used to move and destroy the components stored in raw
+     * chunk memory
+     */
+    struct ComponentInfo
+    {
+            std::size_t id = 0;
+            std::size_t size = 0;
+            std::size_t alignment = 0;
+            void (*moveConstruct)(void *aDst, void *aSrc) = nullptr;
+            void (*destroy)(void *aPtr) = nullptr;
+
+            template<ComponentConcept Component>
+            static ComponentInfo create(std::size_t aId)
+            {
+                return ComponentInfo {
+                    aId,
+                    sizeof(Component),
+                    alignof(Component),
+                    [](void *aDst, void *aSrc) {
+                        new (aDst) Component(std::move(*static_cast<Component *>(aSrc)));
+                    },
+                    [](void *aPtr) {
+                        static_cast<Component *>(aPtr)->~Component();
+                    },
+                };
+            }
+    };
+
+    /**
+     * @brief A fixed-size block of memory holding the rows of an archetype as SoA columns
+     * @details The first column holds the entity ids, then one column per component of the archetype
+     */
+    class Chunk final
+    {
+        public:
+            static constexpr std::size_t chunkSize = 16 * 1024;
+            static constexpr std::size_t chunkAlignment = 64;
+
+        private:
+            std::byte *_data;
+            std::size_t _count = 0;
+
+        public:
+#pragma region constructors / destructors
+            Chunk();
+            ~Chunk();
+
+            Chunk(const Chunk &other) = delete;
+            Chunk &operator=(const Chunk &other) = delete;
+
+            Chunk(Chunk &&other) noexcept = delete;
+            Chunk &operator=(Chunk &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            [[nodiscard]] std::byte *data() const
+            {
+                return _data;
+            }
+
+            [[nodiscard]] std::size_t count() const
+            {
+                return _count;
+            }
+
+            void setCount(std::size_t aCount)
+            {
+                _count = aCount;
+            }
+#pragma endregion methods
+    };
+
+    /**
+     * @brief An archetype stores all the entities having exactly the same set of components
+     * @details Rows are packed: removing a row moves the last row of the archetype in the hole, so a row index is
+     * only valid until the next structural change of the archetype
+     */
+    class Archetype final
+    {
+        public:
+            using signature = std::vector<std::size_t>;
+            using edges = boost::container::flat_map<std::size_t, Archetype *>;
+
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        private:
+            signature _signature;
+            std::vector<ComponentInfo> _infos;
+            std::vector<std::size_t> _offsets;
+            std::size_t _capacity = 0;
+            std::size_t _size = 0;
+            std::vector<std::unique_ptr<Chunk>> _chunks;
+            edges _addEdges;
+            edges _removeEdges;
+
+        public:
+#pragma region constructors / destructors
+            /**
+             * @brief Construct a new Archetype and compute the layout of its chunks
+             *
+             * @param aInfos The components of the archetype, sorted by id
+             * @throw ArchetypeExceptionRowTooLarge If a single row doesn't fit in a chunk
+             */
+            explicit Archetype(std::vector<ComponentInfo> aInfos);
+            ~Archetype();
+
+            Archetype(const Archetype &other) = delete;
+            Archetype &operator=(const Archetype &other) = delete;
+
+            Archetype(Archetype &&other) noexcept = delete;
+            Archetype &operator=(Archetype &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            /**
+             * @brief Get the column of a component in this archetype
+             *
+             * @param aComponentId The id of the component
+             * @return std::size_t The column, npos if the archetype doesn't have the component
+             */
+            [[nodiscard]] std::size_t columnOf(std::size_t aComponentId) const;
+
+            /**
+             * @brief Check if the archetype has all the given components
+             *
+             * @param aRequired The sorted ids of the components
+             */
+            [[nodiscard]] bool matches(const signature &aRequired) const;
+
+            /**
+             * @brief Append a row for the entity, the components of the row are left unconstructed
+             *
+             * @param aEntity The entity owning the row
+             * @return std::size_t The new row
+             */
+            std::size_t pushRow(std::size_t aEntity);
+
+            /**
+             * @brief Destroy the components of a row then move the last row in its place
+             *
+             * @param aRow The row to remove
+             * @return std::size_t The entity now stored at aRow, npos if the removed row was the last one
+             */
+            std::size_t removeRow(std::size_t aRow);
+
+            [[nodiscard]] void *componentAt(std::size_t aColumn, std::size_t aRow) const
+            {
+                const auto &chunk = *_chunks[aRow / _capacity];
+
+                return chunk.data() + _offsets[aColumn] + ((aRow % _capacity) * _infos[aColumn].size);
+            }
+
+            [[nodiscard]] std::size_t entityAt(std::size_t aRow) const
+            {
+                return entitiesOf(*_chunks[aRow / _capacity])[aRow % _capacity];
+            }
+
+            [[nodiscard]] const signature &getSignature() const
+            {
+                return _signature;
+            }
+
+            [[nodiscard]] const std::vector<ComponentInfo> &getInfos() const
+            {
+                return _infos;
+            }
+
+            [[nodiscard]] const std::vector<std::unique_ptr<Chunk>> &getChunks() const
+            {
+                return _chunks;
+            }
+
+            /**
+             * @brief Get the first element of a column in a chunk
+             *
+             * @tparam Component The type stored in the column
+             */
+            template<typename Component>
+            [[nodiscard]] Component *column(const Chunk &aChunk, std::size_t aColumn) const
+            {
+                return std::launder(reinterpret_cast<Component *>(aChunk.data() + _offsets[aColumn]));
+            }
+
+            [[nodiscard]] static std::size_t *entitiesOf(const Chunk &aChunk)
+            {
+                return std::launder(reinterpret_cast<std::size_t *>(aChunk.data()));
+            }
+
+            [[nodiscard]] std::size_t size() const
+            {
+                return _size;
+            }
+
+            [[nodiscard]] std::size_t capacity() const
+            {
+                return _capacity;
+            }
+
+            edges &getAddEdges()
+            {
+                return _addEdges;
+            }
+
+            edges &getRemoveEdges()
+            {
+                return _removeEdges;
+            }
+#pragma endregion methods
+    };
+} // namespace Engine::Core
+
+#endif /* !ARCHETYPE_HPP_ */
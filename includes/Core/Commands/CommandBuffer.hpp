@@ -0,0 +1,226 @@
+#ifndef COMMANDBUFFER_HPP_
+#define COMMANDBUFFER_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Core/Components/Component.hpp"
+#include "Core/Entity.hpp"
+#include "Core/TypeRegistry.hpp"
+
+namespace Engine::Core {
+    class World;
+
+    /**
+     * @brief Record structural changes (spawns, kills, component adds and removes) to apply them later on a World
+     * @details The components are moved into a linear arena made of fixed blocks that are kept between flushes, so
+     * recording doesn't allocate once the buffer is warm. A buffer is meant to be used by a single thread: the World
+     * keeps one per worker of the job system and applies all of them at once in World::flushCommands. The commands
+     * keep the generation of their entity, a command whose handle is stale by the flush is dropped
+     */
+    class CommandBuffer final
+    {
+        public:
+            using id = std::size_t;
+
+            /**
+             * @brief Set on the index of the handles returned by spawn until the buffer is flushed
+             */
+            static constexpr id pendingBit = id(1) << (std::numeric_limits<id>::digits - 1);
+            static constexpr std::size_t bufferShift = 40;
+            static constexpr id spawnMask = (id(1) << bufferShift) - 1;
+            static constexpr std::size_t blockSize = 64 * 1024;
+
+            /**
+             * @brief A recorded component add or remove
+             */
+            struct Command
+            {
+                    std::size_t componentId;
+                    Entity entity;
+                    void *payload;
+                    void (*apply)(World &aWorld, id aEntity, void *aPayload);
+                    void (*destroy)(void *aPayload);
+            };
+
+        private:
+            struct Block
+            {
+                    std::unique_ptr<std::byte[]> data;
+                    std::size_t size;
+                    std::size_t used;
+            };
+
+            std::size_t _index;
+            std::vector<Block> _blocks;
+            std::size_t _currentBlock = 0;
+            std::vector<Command> _commands;
+            std::vector<Entity> _kills;
+            std::size_t _spawns = 0;
+
+        public:
+#pragma region constructors / destructors
+            /**
+             * @brief Construct a new Command Buffer
+             *
+             * @param aIndex The index of the buffer in its World, stored in the pending handles it returns
+             */
+            explicit CommandBuffer(std::size_t aIndex = 0)
+                : _index(aIndex)
+            {}
+
+            ~CommandBuffer()
+            {
+                clear();
+            }
+
+            CommandBuffer(const CommandBuffer &other) = delete;
+            CommandBuffer &operator=(const CommandBuffer &other) = delete;
+
+            CommandBuffer(CommandBuffer &&other) noexcept = default;
+            CommandBuffer &operator=(CommandBuffer &&other) noexcept = default;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            /**
+             * @brief Record the creation of an entity
+             *
+             * @return Entity A pending handle, usable with the other commands of any buffer of the World until the
+             * flush
+             */
+            Entity spawn()
+            {
+                return Entity {pendingBit | (_index << bufferShift) | _spawns++, 0};
+            }
+
+            /**
+             * @brief Record the creation of an entity with its components
+             *
+             * @param aComponents The components of the entity
+             * @return Entity A pending handle, usable with the other commands until the flush
+             */
+            template<ComponentConcept... Components>
+            Entity spawn(Components &&...aComponents)
+            {
+                const auto entity = spawn();
+
+                (add(entity, std::forward<Components>(aComponents)), ...);
+                return entity;
+            }
+
+            /**
+             * @brief Record the death of an entity, applied after every other command of the flush
+             *
+             * @param aEntity The entity, or a pending handle
+             */
+            void kill(Entity aEntity)
+            {
+                _kills.push_back(aEntity);
+            }
+
+            /**
+             * @brief Record the addition of a component to an entity
+             *
+             * @param aEntity The entity, or a pending handle
+             * @param aComponent The component, moved in the buffer
+             */
+            template<ComponentConcept Component>
+            void add(Entity aEntity, Component &&aComponent)
+            {
+                emplace<std::remove_cvref_t<Component>>(aEntity, std::forward<Component>(aComponent));
+            }
+
+            /**
+             * @brief Record the addition of a component built from the given arguments
+             *
+             * @param aEntity The entity, or a pending handle
+             * @param aArgs The arguments of the constructor of the component, the component is built right away
+             */
+            template<ComponentConcept Component, typename... Args>
+            void emplace(Entity aEntity, Args &&...aArgs)
+            {
+                auto *payload = new (allocate(sizeof(Component), alignof(Component)))
+                    Component(std::forward<Args>(aArgs)...);
+
+                _commands.push_back(Command {TypeId<ComponentFamily>::get<Component>(), aEntity, payload,
+                                             &applyAdd<World, Component>, &destroyPayload<Component>});
+            }
+
+            /**
+             * @brief Record the removal of a component from an entity
+             *
+             * @param aEntity The entity, or a pending handle
+             */
+            template<ComponentConcept Component>
+            void remove(Entity aEntity)
+            {
+                _commands.push_back(Command {TypeId<ComponentFamily>::get<Component>(), aEntity, nullptr,
+                                             &applyRemove<World, Component>, nullptr});
+            }
+
+            /**
+             * @brief Check if a handle is a pending handle returned by spawn
+             */
+            [[nodiscard]] static bool isPending(Entity aEntity) noexcept
+            {
+                return (aEntity.index & pendingBit) != 0;
+            }
+
+            /**
+             * @brief Check if the buffer has nothing to apply
+             */
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return _spawns == 0 && _commands.empty() && _kills.empty();
+            }
+
+            [[nodiscard]] std::size_t getSpawnCount() const noexcept
+            {
+                return _spawns;
+            }
+
+            [[nodiscard]] const std::vector<Command> &getCommands() const noexcept
+            {
+                return _commands;
+            }
+
+            [[nodiscard]] const std::vector<Entity> &getKills() const noexcept
+            {
+                return _kills;
+            }
+
+            /**
+             * @brief Drop every command, the components still in the arena are destroyed but the blocks are kept
+             */
+            void clear();
+#pragma endregion methods
+
+        private:
+            void *allocate(std::size_t aSize, std::size_t aAlignment);
+
+            template<typename WorldT, typename Component>
+            static void applyAdd(WorldT &aWorld, id aEntity, void *aPayload)
+            {
+                aWorld.template addComponentToEntity<Component>(aEntity,
+                                                                std::move(*static_cast<Component *>(aPayload)));
+            }
+
+            template<typename WorldT, typename Component>
+            static void applyRemove(WorldT &aWorld, id aEntity, void * /*payload*/)
+            {
+                aWorld.template removeComponentFromEntity<Component>(aEntity);
+            }
+
+            template<typename Component>
+            static void destroyPayload(void *aPayload)
+            {
+                static_cast<Component *>(aPayload)->~Component();
+            }
+    };
+} // namespace Engine::Core
+
+#endif /* !COMMANDBUFFER_HPP_ */
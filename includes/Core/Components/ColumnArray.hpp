@@ -0,0 +1,767 @@
+#ifndef COLUMNARRAY_HPP_
+#define COLUMNARRAY_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Component.hpp"
+#include "SparseArray.hpp"
+
+namespace Engine::Core {
+    /**
+     * @brief A plain component stored as SoA columns: default constructible, with a static fields tuple listing all
+     * of its members
+     * @code
+     * struct Position
+     * {
+     *         float x = 0;
+     *         float y = 0;
+     *         float z = 0;
+     *
+     *         static constexpr auto fields = std::make_tuple(&Position::x, &Position::y, &Position::z);
+     * };
+     * @endcode
+     * The same tuple makes the component serializable, see ComponentSerializer
+     */
+    template<typename Component>
+    concept ColumnComponent = PlainComponent<Component> && std::is_default_constructible_v<Component>
+                              && requires { Component::fields; };
+
+    template<ColumnComponent Component>
+    class ColumnArray;
+
+    /**
+     * @brief A reference on the component of an entity in a ColumnArray, the fields are scattered in the columns
+     *
+     * @tparam Component The type of the component
+     */
+    template<ColumnComponent Component>
+    class ColumnRef final
+    {
+        private:
+            ColumnArray<Component> *_storage;
+            std::size_t _index;
+
+        public:
+            ColumnRef(ColumnArray<Component> &aStorage, std::size_t aIndex)
+                : _storage(&aStorage),
+                  _index(aIndex)
+            {}
+
+            /**
+             * @brief Gather the fields of the component
+             */
+            operator Component() const
+            {
+                return _storage->load(_index);
+            }
+
+            /**
+             * @brief Scatter a component in the columns
+             */
+            ColumnRef &operator=(const Component &aValue)
+            {
+                _storage->store(_index, aValue);
+                return *this;
+            }
+
+            /**
+             * @brief Get a field of the component, in its column
+             * @code
+             * ref.field<&Position::x>() += 1;
+             * @endcode
+             */
+            template<auto Field>
+            auto &field() const
+            {
+                return _storage->template column<Field>()[_index];
+            }
+
+            [[nodiscard]] std::size_t index() const noexcept
+            {
+                return _index;
+            }
+    };
+
+    /**
+     * @brief A run of consecutive entities of a query, as spans over the columns of a component
+     * @details The spans of the batches of a query have the same length and start at the same entity, element i of
+     * each span belongs to entity first() + i. The span of a field starts on ColumnArray::columnAlignment when
+     * first() * sizeof(field) is a multiple of it, like the full batches of a query whose batch size is a multiple of
+     * 16 for 4-byte fields
+     *
+     * @tparam Component The type of the component, const for read-only spans
+     */
+    template<typename Component>
+    class ColumnBatch final
+    {
+        private:
+            using storageType = std::conditional_t<std::is_const_v<Component>,
+                                                   const ColumnArray<std::remove_const_t<Component>>,
+                                                   ColumnArray<std::remove_const_t<Component>>>;
+
+            storageType *_storage;
+            std::size_t _first;
+            std::size_t _size;
+
+        public:
+            ColumnBatch(storageType &aStorage, std::size_t aFirst, std::size_t aSize)
+                : _storage(&aStorage),
+                  _first(aFirst),
+                  _size(aSize)
+            {}
+
+            /**
+             * @brief Get the span of a field over the entities of the batch
+             * @code
+             * auto x = batch.field<&Position::x>();
+             * @endcode
+             */
+            template<auto Field>
+            [[nodiscard]] auto field() const
+            {
+                return _storage->template column<Field>().subspan(_first, _size);
+            }
+
+            /**
+             * @brief Get the span of the column at an index of the fields tuple
+             */
+            template<std::size_t Index>
+            [[nodiscard]] auto column() const
+            {
+                return _storage->template columnAt<Index>().subspan(_first, _size);
+            }
+
+            /**
+             * @brief Get the first entity of the batch
+             */
+            [[nodiscard]] std::size_t first() const noexcept
+            {
+                return _first;
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return _size;
+            }
+    };
+
+    /**
+     * @brief ColumnArray stores a plain component as one column per field, indexed by entity like a SparseArray
+     * @details Each column is aligned on columnAlignment bytes and has a padded capacity, so a kernel can run AVX2 or
+     * AVX-512 loops over the spans of a batch (see World::Query::forEachBatch). The slots of the entities without the
+     * component are zeroed. Growing the array moves the columns. A component is read by value (gathered from the
+     * columns) and written through a ColumnRef or set, the references of the other storages don't exist here. Restored
+     * from a snapshot file, the columns can be the pages of its private mapping (see deserialize)
+     *
+     * @tparam Component The type of the components to store
+     */
+    template<ColumnComponent Component>
+    class ColumnArray final : public ISparseArray
+    {
+        public:
+            using compRef = ColumnRef<Component>;
+            using constCompRef = Component;
+            using vectIndex = std::size_t;
+
+            /**
+             * @brief The alignment of the columns, a cache line and an AVX-512 register
+             */
+            static constexpr std::size_t columnAlignment = 64;
+
+        private:
+            using fieldsType = std::remove_cvref_t<decltype(Component::fields)>;
+
+            static constexpr std::size_t fieldCount = std::tuple_size_v<fieldsType>;
+
+            template<std::size_t Index>
+            using fieldType = std::remove_cvref_t<
+                decltype(std::declval<Component &>().*std::get<Index>(Component::fields))>;
+
+            std::pmr::polymorphic_allocator<> _allocator;
+            std::array<std::byte *, fieldCount> _columns {};
+            std::pmr::vector<std::uint8_t> _present;
+            std::size_t _capacity = 0;
+            std::size_t _count = 0;
+            std::shared_ptr<void> _backing;
+
+        public:
+#pragma region constructors / destructors
+            ColumnArray() = default;
+
+            /**
+             * @brief Construct a new Column Array allocating its columns from a memory resource
+             *
+             * @param aResource The memory resource, must outlive the array
+             */
+            explicit ColumnArray(std::pmr::memory_resource *aResource)
+                : _allocator(aResource),
+                  _present(aResource)
+            {}
+
+            ~ColumnArray() override
+            {
+                releaseColumns();
+            }
+
+            ColumnArray(const ColumnArray &other) = delete;
+            ColumnArray &operator=(const ColumnArray &other) = delete;
+
+            ColumnArray(ColumnArray &&other) noexcept
+                : ISparseArray(std::move(other)),
+                  _allocator(other._allocator),
+                  _columns(std::exchange(other._columns, {})),
+                  _present(std::move(other._present)),
+                  _capacity(std::exchange(other._capacity, 0)),
+                  _count(std::exchange(other._count, 0)),
+                  _backing(std::move(other._backing))
+            {}
+
+            ColumnArray &operator=(ColumnArray &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+#pragma region operators
+            /**
+             * @brief Get the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return compRef A reference on the component of the entity
+             */
+            compRef operator[](vectIndex aIndex)
+            {
+                return get(aIndex);
+            }
+
+            /**
+             * @brief Get a copy of the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return constCompRef The component of the entity
+             */
+            constCompRef operator[](vectIndex aIndex) const
+            {
+                return get(aIndex);
+            }
+#pragma endregion operators
+
+#pragma region methods
+            /**
+             * @brief Get the component of the given entity, stamped as changed
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return compRef A reference on the component of the entity
+             */
+            compRef get(vectIndex aIndex)
+            {
+                check(aIndex);
+                markChanged(aIndex);
+                return compRef(*this, aIndex);
+            }
+
+            /**
+             * @brief Get a copy of the component of the given entity, read-only access doesn't stamp it as changed
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return constCompRef The component of the entity
+             */
+            constCompRef get(vectIndex aIndex) const
+            {
+                check(aIndex);
+                return load(aIndex);
+            }
+
+            /**
+             * @brief Set the component of the given entity, replacing the one it has
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @param aIndex The entity
+             * @param aValue The component
+             */
+            void set(vectIndex aIndex, Component &&aValue)
+            {
+                if (aIndex >= _present.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                place(aIndex, aValue);
+            }
+
+            /**
+             * @brief Check if the given entity has the component
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             */
+            bool has(vectIndex aIndex) const
+            {
+                if (aIndex >= _present.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                return _present[aIndex] != 0;
+            }
+
+            /**
+             * @brief Check if the given entity has the component, without throwing
+             */
+            [[nodiscard]] bool contains(vectIndex aIndex) const noexcept
+            {
+                return aIndex < _present.size() && _present[aIndex] != 0;
+            }
+
+            /**
+             * @brief Make the slot of an entity exist, the columns grow if needed
+             * @param aIndex The entity
+             */
+            void init(vectIndex aIndex) override
+            {
+                if (aIndex >= _present.size()) {
+                    reserveSlots(aIndex + 1);
+                    _present.resize(aIndex + 1, 0);
+                }
+            }
+
+            /**
+             * @brief Make room for the slots of more entities
+             *
+             * @param aCount The number of components about to be added
+             */
+            void reserve(std::size_t aCount) override
+            {
+                reserveSlots(_present.size() + aCount);
+            }
+
+            /**
+             * @brief Build the component of the given entity and scatter it in the columns, the array grows if needed
+             * @param aIndex The entity
+             * @param aArgs The arguments of the constructor of the component
+             * @return compRef A reference on the component of the entity
+             */
+            template<typename... Args>
+            compRef emplace(vectIndex aIndex, Args &&...aArgs)
+            {
+                init(aIndex);
+                place(aIndex, Component(std::forward<Args>(aArgs)...));
+                return compRef(*this, aIndex);
+            }
+
+            /**
+             * @brief Erase the component of the given entity, its fields are zeroed
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @param aIndex The entity
+             */
+            void erase(vectIndex aIndex) override
+            {
+                if (aIndex >= _present.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                if (_present[aIndex] != 0) {
+                    _present[aIndex] = 0;
+                    zero(aIndex, aIndex + 1);
+                    _count--;
+                    markAbsent(aIndex);
+                }
+            }
+
+            /**
+             * @brief Destroy all the components and release the columns
+             */
+            void clear() override
+            {
+                for (vectIndex idx = 0; idx < _present.size(); idx++) {
+                    if (_present[idx] != 0) {
+                        markAbsent(idx);
+                    }
+                }
+                releaseColumns();
+                _present.clear();
+                _count = 0;
+            }
+
+            /**
+             * @brief Get the number of components set (not the number of slots)
+             */
+            [[nodiscard]] std::size_t count() const override
+            {
+                return _count;
+            }
+
+            /**
+             * @brief Get the number of slots, the length of the columns
+             */
+            [[nodiscard]] vectIndex size() const noexcept
+            {
+                return _present.size();
+            }
+
+            /**
+             * @brief Get the column of a field over every slot
+             * @code
+             * std::span<float> x = storage.column<&Position::x>();
+             * @endcode
+             */
+            template<auto Field>
+            [[nodiscard]] auto column()
+            {
+                return columnAt<fieldIndex<Field>()>();
+            }
+
+            template<auto Field>
+            [[nodiscard]] auto column() const
+            {
+                return columnAt<fieldIndex<Field>()>();
+            }
+
+            /**
+             * @brief Get the column at an index of the fields tuple over every slot
+             */
+            template<std::size_t Index>
+            [[nodiscard]] std::span<fieldType<Index>> columnAt()
+            {
+                return {reinterpret_cast<fieldType<Index> *>(_columns[Index]), _present.size()};
+            }
+
+            template<std::size_t Index>
+            [[nodiscard]] std::span<const fieldType<Index>> columnAt() const
+            {
+                return {reinterpret_cast<const fieldType<Index> *>(_columns[Index]), _present.size()};
+            }
+
+            /**
+             * @brief Gather the fields of the component of an entity, without checking it
+             */
+            [[nodiscard]] Component load(vectIndex aIndex) const
+            {
+                Component value {};
+
+                forEachField([this, &value, aIndex]<std::size_t Index>() {
+                    value.*std::get<Index>(Component::fields) = columnAt<Index>()[aIndex];
+                });
+                return value;
+            }
+
+            /**
+             * @brief Scatter the fields of a component in the slot of an entity, without checking it
+             */
+            void store(vectIndex aIndex, const Component &aValue)
+            {
+                forEachField([this, &aValue, aIndex]<std::size_t Index>() {
+                    columnAt<Index>()[aIndex] = aValue.*std::get<Index>(Component::fields);
+                });
+            }
+
+            /**
+             * @brief Check if the columns are the pages of a mapped snapshot, until the array grows
+             */
+            [[nodiscard]] bool isMapped() const noexcept
+            {
+                return _backing != nullptr;
+            }
+
+            [[nodiscard]] bool isSerializable() const override
+            {
+                return true;
+            }
+
+            [[nodiscard]] std::string getSerialName() const override
+            {
+                return serialName<Component>();
+            }
+
+            /**
+             * @brief Write the components in the format of serializeStorage
+             * @details When at least half of the entities have the component the columns are written as they are,
+             * in the Indexed layout, with one memcpy each. Otherwise they are Packed, with one memcpy per run of
+             * consecutive entities having the component
+             */
+            void serialize(SnapshotWriter &aWriter, std::size_t aEntityCount) const override
+            {
+                constexpr std::size_t bits = 64;
+                std::vector<std::uint64_t> presence((aEntityCount + bits - 1) / bits, 0);
+                std::vector<std::pair<std::size_t, std::size_t>> runs;
+                std::size_t written = 0;
+
+                for (std::size_t idx = 0; idx < aEntityCount; idx++) {
+                    if (contains(idx)) {
+                        presence[idx / bits] |= std::uint64_t(1) << (idx % bits);
+                        addToRuns(runs, idx);
+                        written++;
+                    }
+                }
+                const auto layout = written * 2 >= aEntityCount ? ColumnLayout::Indexed : ColumnLayout::Packed;
+
+                aWriter.write(static_cast<std::uint64_t>(written));
+                aWriter.write(layout);
+                aWriter.align();
+                aWriter.write(presence.data(), presence.size() * sizeof(std::uint64_t));
+                forEachField([this, &aWriter, &runs, written, layout, aEntityCount]<std::size_t Index>() {
+                    const auto source = columnAt<Index>();
+
+                    aWriter.align();
+                    if (layout == ColumnLayout::Indexed) {
+                        // The slots past the entities are the zeros of the new bytes
+                        auto *column = aWriter.grow(indexedSlots(aEntityCount) * sizeof(fieldType<Index>));
+
+                        if (!source.empty()) {
+                            std::memcpy(column, source.data(),
+                                        std::min(source.size(), aEntityCount) * sizeof(fieldType<Index>));
+                        }
+                        return;
+                    }
+                    auto *column = aWriter.grow(written * sizeof(fieldType<Index>));
+
+                    for (const auto &[first, size] : runs) {
+                        std::memcpy(column, &source[first], size * sizeof(fieldType<Index>));
+                        column += size * sizeof(fieldType<Index>);
+                    }
+                });
+            }
+
+            /**
+             * @brief Read the components written by serialize, or by serializeStorage from another storage
+             * @details Indexed columns are adopted as they are when the reader has a backing, like the private
+             * mapping of World::restore(const std::filesystem::path &): the array keeps the mapping alive and its
+             * writes copy the pages they touch, the others stay shared with the page cache. Otherwise an Indexed
+             * column is copied with one memcpy, a Packed one with one memcpy per run of consecutive entities
+             * @throw SnapshotExceptionCorrupted If the block is malformed
+             */
+            void deserialize(SnapshotReader &aReader, std::size_t aEntityCount) override
+            {
+                constexpr std::size_t bits = 64;
+                const auto count = aReader.read<std::uint64_t>();
+                const auto layout = aReader.read<ColumnLayout>();
+
+                aReader.align();
+                const auto presence = aReader.read((aEntityCount + bits - 1) / bits * sizeof(std::uint64_t));
+                std::vector<std::pair<std::size_t, std::size_t>> runs;
+                std::size_t found = 0;
+
+                if (count > aEntityCount) {
+                    throw SnapshotExceptionCorrupted("More components than entities in the snapshot");
+                }
+                if (layout != ColumnLayout::Packed && layout != ColumnLayout::Indexed) {
+                    throw SnapshotExceptionCorrupted("Unknown column layout");
+                }
+                for (std::size_t idx = 0; idx < aEntityCount && found < count; idx++) {
+                    std::uint64_t word = 0;
+
+                    std::memcpy(&word, presence.data() + idx / bits * sizeof(std::uint64_t), sizeof(std::uint64_t));
+                    if ((word >> (idx % bits) & 1) != 0) {
+                        addToRuns(runs, idx);
+                        found++;
+                    }
+                }
+                if (found != count) {
+                    throw SnapshotExceptionCorrupted("The presence bitmap doesn't match the component count");
+                }
+                if (layout == ColumnLayout::Indexed) {
+                    readIndexed(aReader, aEntityCount);
+                } else {
+                    if (aEntityCount != 0) {
+                        init(aEntityCount - 1);
+                    }
+                    forEachField([this, &aReader, &runs, count]<std::size_t Index>() {
+                        auto target = columnAt<Index>();
+
+                        aReader.align();
+                        const auto *column = aReader.read(count * sizeof(fieldType<Index>)).data();
+
+                        for (const auto &[first, size] : runs) {
+                            std::memcpy(&target[first], column, size * sizeof(fieldType<Index>));
+                            column += size * sizeof(fieldType<Index>);
+                        }
+                    });
+                }
+                for (const auto &[first, size] : runs) {
+                    for (auto idx = first; idx < first + size; idx++) {
+                        claim(idx);
+                    }
+                }
+            }
+#pragma endregion methods
+
+        private:
+            template<auto Field>
+            static consteval std::size_t fieldIndex()
+            {
+                std::size_t found = fieldCount;
+
+                [&found]<std::size_t... Indexes>(std::index_sequence<Indexes...>) {
+                    ((found = matches<Field, Indexes>() && found == fieldCount ? Indexes : found), ...);
+                }(std::make_index_sequence<fieldCount> {});
+                if (found == fieldCount) {
+                    throw "The field isn't in the fields tuple of the component";
+                }
+                return found;
+            }
+
+            template<auto Field, std::size_t Index>
+            static consteval bool matches()
+            {
+                if constexpr (std::is_same_v<decltype(Field), std::remove_cvref_t<decltype(std::get<Index>(
+                                                                  Component::fields))>>) {
+                    return Field == std::get<Index>(Component::fields);
+                } else {
+                    return false;
+                }
+            }
+
+            template<typename Func>
+            static void forEachField(Func &&aFunc)
+            {
+                [&aFunc]<std::size_t... Indexes>(std::index_sequence<Indexes...>) {
+                    (aFunc.template operator()<Indexes>(), ...);
+                }(std::make_index_sequence<fieldCount> {});
+            }
+
+            void check(vectIndex aIndex) const
+            {
+                if (aIndex >= _present.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                if (_present[aIndex] == 0) {
+                    throw SparseArrayExceptionEmpty("index is empty: " + std::to_string(aIndex));
+                }
+            }
+
+            void place(vectIndex aIndex, const Component &aValue)
+            {
+                store(aIndex, aValue);
+                claim(aIndex);
+            }
+
+            /**
+             * @brief Stamp the slot of an entity as holding a component, its fields are already in the columns
+             */
+            void claim(vectIndex aIndex)
+            {
+                if (_present[aIndex] != 0) {
+                    markChanged(aIndex);
+                } else {
+                    _present[aIndex] = 1;
+                    _count++;
+                    markPresent(aIndex);
+                }
+            }
+
+            /**
+             * @brief Read the Indexed columns of a block, adopted when they are aligned in the writable data of a
+             * backed reader and the array is empty, copied otherwise
+             */
+            void readIndexed(SnapshotReader &aReader, std::size_t aEntityCount)
+            {
+                const auto slots = indexedSlots(aEntityCount);
+                std::array<const std::byte *, fieldCount> sources {};
+                std::array<std::byte *, fieldCount> adopted {};
+                bool adoptable = aReader.getBacking() != nullptr && slots != 0 && _count == 0
+                                 && _present.size() <= slots;
+
+                forEachField([&aReader, &sources, &adopted, &adoptable, slots]<std::size_t Index>() {
+                    aReader.align();
+                    const auto bytes = aReader.read(slots * sizeof(fieldType<Index>));
+
+                    sources[Index] = bytes.data();
+                    adopted[Index] = aReader.adopt(bytes);
+                    adoptable = adoptable && reinterpret_cast<std::uintptr_t>(adopted[Index]) % columnAlignment == 0;
+                });
+                if (aEntityCount == 0) {
+                    return;
+                }
+                if (adoptable) {
+                    releaseColumns();
+                    _columns = adopted;
+                    _capacity = slots;
+                    _backing = aReader.getBacking();
+                    init(aEntityCount - 1);
+                    return;
+                }
+                init(aEntityCount - 1);
+                forEachField([this, &sources, aEntityCount]<std::size_t Index>() {
+                    std::memcpy(_columns[Index], sources[Index], aEntityCount * sizeof(fieldType<Index>));
+                });
+            }
+
+            /**
+             * @brief Append an entity to a list of runs of consecutive entities, as (first, size) pairs
+             */
+            static void addToRuns(std::vector<std::pair<std::size_t, std::size_t>> &aRuns, std::size_t aIndex)
+            {
+                if (!aRuns.empty() && aRuns.back().first + aRuns.back().second == aIndex) {
+                    aRuns.back().second++;
+                } else {
+                    aRuns.emplace_back(aIndex, 1);
+                }
+            }
+
+            void zero(std::size_t aBegin, std::size_t aEnd)
+            {
+                forEachField([this, aBegin, aEnd]<std::size_t Index>() {
+                    std::memset(_columns[Index] + aBegin * sizeof(fieldType<Index>), 0,
+                                (aEnd - aBegin) * sizeof(fieldType<Index>));
+                });
+            }
+
+            /**
+             * @brief Grow the columns to hold some slots, the capacity doubles and is padded to a whole cache line of
+             * each column
+             */
+            void reserveSlots(std::size_t aSlots)
+            {
+                if (aSlots <= _capacity) {
+                    return;
+                }
+                const auto capacity = (std::max(aSlots, _capacity * 2) + columnAlignment - 1) / columnAlignment
+                                      * columnAlignment;
+
+                forEachField([this, capacity]<std::size_t Index>() {
+                    auto *column = static_cast<std::byte *>(
+                        _allocator.allocate_bytes(capacity * sizeof(fieldType<Index>), columnAlignment));
+
+                    if (_columns[Index] != nullptr) {
+                        std::memcpy(column, _columns[Index], _capacity * sizeof(fieldType<Index>));
+                        releaseColumn<Index>();
+                    }
+                    std::memset(column + _capacity * sizeof(fieldType<Index>), 0,
+                                (capacity - _capacity) * sizeof(fieldType<Index>));
+                    _columns[Index] = column;
+                });
+                _capacity = capacity;
+                _backing.reset();
+            }
+
+            void releaseColumns()
+            {
+                forEachField([this]<std::size_t Index>() {
+                    if (_columns[Index] != nullptr) {
+                        releaseColumn<Index>();
+                        _columns[Index] = nullptr;
+                    }
+                });
+                _capacity = 0;
+                _backing.reset();
+            }
+
+            /**
+             * @brief Free a column, unless it is in the pages of a mapped snapshot
+             */
+            template<std::size_t Index>
+            void releaseColumn()
+            {
+                if (_backing == nullptr) {
+                    _allocator.deallocate_bytes(_columns[Index], _capacity * sizeof(fieldType<Index>),
+                                                columnAlignment);
+                }
+            }
+    };
+} // namespace Engine::Core
+
+#endif /* !COLUMNARRAY_HPP_ */
@@ -16,7 +16,21 @@ namespace Engine {
             Component &operator=(Component &&) noexcept = default;
     };
 
+    /**
+     * @brief Tag of the component types, see Core::TypeId
+     */
+    struct ComponentFamily
+    {};
+
+    /**
+     * @brief A plain-data component: a trivially copyable struct without the Component base, so without a vptr
+     * @details A plain component listing its members in a static fields tuple is stored as SoA columns, see
+     * Core::ColumnArray
+     */
+    template<typename T>
+    concept PlainComponent = std::is_class_v<T> && std::is_trivially_copyable_v<T> && !std::is_base_of_v<Component, T>;
+
     template<typename T>
-    concept ComponentConcept = std::is_base_of_v<Component, T>;
+    concept ComponentConcept = std::is_base_of_v<Component, T> || PlainComponent<T>;
 } // namespace Engine
 #endif /* !COMPONENT_HPP_ */
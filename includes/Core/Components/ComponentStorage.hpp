@@ -0,0 +1,85 @@
+#ifndef COMPONENTSTORAGE_HPP_
+#define COMPONENTSTORAGE_HPP_
+
+#include "ColumnArray.hpp"
+#include "Component.hpp"
+#include "PackedArray.hpp"
+#include "PagedArray.hpp"
+#include "SparseArray.hpp"
+
+namespace Engine::Core {
+    /**
+     * @brief Storage tag selecting a SparseArray, one slot per entity (the default)
+     */
+    struct SparseStorage
+    {
+            template<ComponentConcept Component>
+            using type = SparseArray<Component>;
+    };
+
+    /**
+     * @brief Storage tag selecting a PackedArray, for components held by few entities
+     */
+    struct PackedStorage
+    {
+            template<ComponentConcept Component>
+            using type = PackedArray<Component>;
+    };
+
+    /**
+     * @brief Storage tag selecting a PagedArray, for components referenced across frames: they never move
+     */
+    struct PagedStorage
+    {
+            template<ComponentConcept Component>
+            using type = PagedArray<Component>;
+    };
+
+    /**
+     * @brief Storage tag selecting a ColumnArray, the default of the plain components listing their fields
+     */
+    struct ColumnStorage
+    {
+            template<ColumnComponent Component>
+            using type = ColumnArray<Component>;
+    };
+
+    /**
+     * @brief Select the storage of a component type
+     * @details A component picks its storage by declaring a storage tag:
+     * @code
+     * struct Bullet : public Engine::Component
+     * {
+     *         using storageTag = Engine::Core::PackedStorage;
+     * };
+     * @endcode
+     * A plain component with a fields tuple (see ColumnComponent) defaults to a ColumnArray. The trait can also be
+     * specialized for the components that can't be modified
+     *
+     * @tparam Component The type of the component
+     */
+    template<ComponentConcept Component>
+    struct ComponentStorage
+    {
+            using type = SparseStorage::type<Component>;
+    };
+
+    template<ColumnComponent Component>
+        requires(!requires { typename Component::storageTag; })
+    struct ComponentStorage<Component>
+    {
+            using type = ColumnStorage::type<Component>;
+    };
+
+    template<ComponentConcept Component>
+        requires requires { typename Component::storageTag; }
+    struct ComponentStorage<Component>
+    {
+            using type = typename Component::storageTag::template type<Component>;
+    };
+
+    template<ComponentConcept Component>
+    using StorageOf = typename ComponentStorage<Component>::type;
+} // namespace Engine::Core
+
+#endif /* !COMPONENTSTORAGE_HPP_ */
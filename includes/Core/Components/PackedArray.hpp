@@ -0,0 +1,365 @@
+#ifndef PACKEDARRAY_HPP_
+#define PACKEDARRAY_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Component.hpp"
+#include "SparseArray.hpp"
+
+namespace Engine::Core {
+    /**
+     * @brief PackedArray is a sparse set: the components are stored contiguously in a dense array, next to a dense
+     * array of the entities owning them, and a sparse array maps an entity to its slot in the dense arrays
+     * @details Iterating a PackedArray only visits the live components, which makes it the storage of choice for the
+     * components held by a small part of the entities. Erasing a component moves the last one in its slot
+     * (swap-and-pop), so the order of the dense arrays is not stable
+     *
+     * @tparam Component The type of the components to store
+     */
+    template<ComponentConcept Component>
+    class PackedArray final : public ISparseArray
+    {
+        public:
+            using compRef = Component &;
+            using constCompRef = const Component &;
+            using vectArray = std::pmr::vector<Component>;
+            using vectIndex = std::size_t;
+            using entitiesArray = std::pmr::vector<vectIndex>;
+            using iterator = typename vectArray::iterator;
+            using constIterator = typename vectArray::const_iterator;
+
+            static constexpr vectIndex npos = std::numeric_limits<vectIndex>::max();
+
+        private:
+            vectArray _dense;
+            entitiesArray _entities;
+            std::pmr::vector<vectIndex> _sparse;
+
+        public:
+#pragma region constructors / destructors
+            PackedArray() = default;
+
+            /**
+             * @brief Construct a new Packed Array allocating its arrays from a memory resource
+             *
+             * @param aResource The memory resource, must outlive the array
+             */
+            explicit PackedArray(std::pmr::memory_resource *aResource)
+                : _dense(aResource),
+                  _entities(aResource),
+                  _sparse(aResource)
+            {}
+
+            ~PackedArray() override = default;
+
+            PackedArray(const PackedArray &other) = default;
+            PackedArray &operator=(const PackedArray &other) = default;
+
+            PackedArray(PackedArray &&other) noexcept = default;
+            PackedArray &operator=(PackedArray &&other) noexcept = default;
+#pragma endregion constructors / destructors
+
+#pragma region operators
+
+            /**
+             * @brief Get the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return compRef The component of the entity
+             */
+            compRef operator[](vectIndex aIndex)
+            {
+                return get(aIndex);
+            }
+
+            /**
+             * @brief Get the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return constCompRef The component of the entity
+             */
+            constCompRef operator[](vectIndex aIndex) const
+            {
+                return get(aIndex);
+            }
+
+#pragma endregion operators
+
+#pragma region methods
+
+            /**
+             * @brief Get the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return compRef The component of the entity, stamped as changed
+             */
+            compRef get(vectIndex aIndex)
+            {
+                const auto slot = slotOf(aIndex);
+
+                markChanged(aIndex);
+                return _dense[slot];
+            }
+
+            /**
+             * @brief Get the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return constCompRef The component of the entity
+             */
+            constCompRef get(vectIndex aIndex) const
+            {
+                return _dense[slotOf(aIndex)];
+            }
+
+            /**
+             * @brief Set the component of the given entity, append it to the dense array if the entity doesn't have
+             * one yet
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @param aIndex The entity to set
+             * @param aValue The value to set
+             */
+            void set(vectIndex aIndex, Component &&aValue)
+            {
+                if (aIndex >= _sparse.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                if (_sparse[aIndex] != npos) {
+                    _dense[_sparse[aIndex]] = std::move(aValue);
+                    markChanged(aIndex);
+                    return;
+                }
+                _sparse[aIndex] = _dense.size();
+                _dense.push_back(std::move(aValue));
+                _entities.push_back(aIndex);
+                markPresent(aIndex);
+            }
+
+            /**
+             * @brief Check if the given entity has the component
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @param aIndex The entity to check
+             * @return true if the component is set
+             * @return false if the component is not set
+             */
+            bool has(vectIndex aIndex) const
+            {
+                if (aIndex >= _sparse.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                return _sparse[aIndex] != npos;
+            }
+
+            /**
+             * @brief Check if the given entity has the component, without throwing
+             * @param aIndex The entity to check
+             * @return true if the component is set
+             * @return false if the component is not set or the index is out of range
+             */
+            [[nodiscard]] bool contains(vectIndex aIndex) const noexcept
+            {
+                return aIndex < _sparse.size() && _sparse[aIndex] != npos;
+            }
+
+            /**
+             * @brief Init the entity at the given index, will grow the sparse index if needed
+             * @details Only the sparse index grows, no component is constructed
+             * @param aIndex The index to init
+             */
+            void init(vectIndex aIndex) override
+            {
+                if (aIndex >= _sparse.size()) {
+                    _sparse.resize(aIndex + 1, npos);
+                }
+            }
+
+            /**
+             * @brief Grow the dense arrays once for the components about to be added
+             *
+             * @param aCount The number of components about to be added
+             */
+            void reserve(std::size_t aCount) override
+            {
+                _dense.reserve(_dense.size() + aCount);
+                _entities.reserve(_entities.size() + aCount);
+            }
+
+            /**
+             * @brief Emplace the component of the given entity, will grow the sparse index if needed
+             * @param aIndex The entity to set
+             * @param aArgs The arguments to emplace
+             * @return compRef The component of the entity (should be the one inserted)
+             */
+            template<typename... Args>
+            compRef emplace(vectIndex aIndex, Args &&...aArgs)
+            {
+                init(aIndex);
+                if (_sparse[aIndex] != npos) {
+                    _dense[_sparse[aIndex]] = Component(std::forward<Args>(aArgs)...);
+                    markChanged(aIndex);
+                    return _dense[_sparse[aIndex]];
+                }
+                _sparse[aIndex] = _dense.size();
+                _dense.emplace_back(std::forward<Args>(aArgs)...);
+                _entities.push_back(aIndex);
+                markPresent(aIndex);
+                return _dense.back();
+            }
+
+            /**
+             * @brief Erase the component of the given entity, the last component of the dense array takes its slot
+             * @details Does nothing if the entity doesn't have the component
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @param aIndex The entity to erase
+             */
+            void erase(vectIndex aIndex) override
+            {
+                if (aIndex >= _sparse.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                const auto slot = _sparse[aIndex];
+
+                if (slot == npos) {
+                    return;
+                }
+                if (slot != _dense.size() - 1) {
+                    _dense[slot] = std::move(_dense.back());
+                    _entities[slot] = _entities.back();
+                    _sparse[_entities[slot]] = slot;
+                }
+                _dense.pop_back();
+                _entities.pop_back();
+                _sparse[aIndex] = npos;
+                markAbsent(aIndex);
+            }
+
+            /**
+             * @brief Destroy all the components
+             */
+            void clear() override
+            {
+                for (const auto entity : _entities) {
+                    markAbsent(entity);
+                }
+                _dense.clear();
+                _entities.clear();
+                _sparse.clear();
+            }
+
+            /**
+             * @brief Get the number of components stored
+             */
+            [[nodiscard]] std::size_t count() const override
+            {
+                return _dense.size();
+            }
+
+            [[nodiscard]] bool isSerializable() const override
+            {
+                return SerializableComponent<Component>;
+            }
+
+            [[nodiscard]] std::string getSerialName() const override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    return serialName<Component>();
+                } else {
+                    return {};
+                }
+            }
+
+            void serialize([[maybe_unused]] SnapshotWriter &aWriter,
+                           [[maybe_unused]] std::size_t aEntityCount) const override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    serializeStorage<Component>(*this, aWriter, aEntityCount);
+                }
+            }
+
+            void deserialize([[maybe_unused]] SnapshotReader &aReader,
+                             [[maybe_unused]] std::size_t aEntityCount) override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    deserializeStorage<Component>(*this, aReader, aEntityCount);
+                }
+            }
+
+            /**
+             * @brief Get the entities owning a component, in the same order as the components
+             *
+             * @return const entitiesArray& The dense array of entities
+             */
+            [[nodiscard]] const entitiesArray &entities() const
+            {
+                return _entities;
+            }
+
+#pragma endregion methods
+
+#pragma region iterator
+
+            iterator begin()
+            {
+                return _dense.begin();
+            }
+
+            iterator end()
+            {
+                return _dense.end();
+            }
+
+            constIterator begin() const
+            {
+                return _dense.begin();
+            }
+
+            constIterator end() const
+            {
+                return _dense.end();
+            }
+
+            constIterator cbegin() const
+            {
+                return _dense.cbegin();
+            }
+
+            constIterator cend() const
+            {
+                return _dense.cend();
+            }
+
+            /**
+             * @brief Get the number of components stored (not the number of entities)
+             *
+             * @return vectIndex The number of components
+             */
+            vectIndex size() const
+            {
+                return _dense.size();
+            }
+
+#pragma endregion iterator
+
+        private:
+            vectIndex slotOf(vectIndex aIndex) const
+            {
+                if (aIndex >= _sparse.size()) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                if (_sparse[aIndex] == npos) {
+                    throw SparseArrayExceptionEmpty("index is empty: " + std::to_string(aIndex));
+                }
+                return _sparse[aIndex];
+            }
+    };
+} // namespace Engine::Core
+
+#endif /* !PACKEDARRAY_HPP_ */
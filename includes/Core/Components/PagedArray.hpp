@@ -0,0 +1,336 @@
+#ifndef PAGEDARRAY_HPP_
+#define PAGEDARRAY_HPP_
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <utility>
+#include "Component.hpp"
+#include "SparseArray.hpp"
+
+namespace Engine::Core {
+    /**
+     * @brief PagedArray stores the component of an entity at its index, like a SparseArray, in fixed pages
+     * @details A page holds the slots of 1 << pageShift entities, the same pages as the change ticks. Growing the
+     * array only grows the table of the pages and allocates the page of the new slot, the components are never moved:
+     * a reference to a component stays valid until the component is erased. The pages of the entities without the
+     * component are never allocated
+     *
+     * @tparam Component The type of the components to store
+     */
+    template<ComponentConcept Component>
+    class PagedArray final : public ISparseArray
+    {
+        public:
+            using compRef = Component &;
+            using constCompRef = const Component &;
+            using vectIndex = std::size_t;
+
+            static constexpr std::size_t pageSize = std::size_t(1) << pageShift;
+
+        private:
+            struct Page
+            {
+                    std::array<std::optional<Component>, pageSize> slots;
+            };
+
+            std::pmr::polymorphic_allocator<> _allocator;
+            std::pmr::vector<Page *> _pages;
+            std::size_t _size = 0;
+            std::size_t _count = 0;
+
+        public:
+#pragma region constructors / destructors
+            PagedArray() = default;
+
+            /**
+             * @brief Construct a new Paged Array allocating its pages from a memory resource
+             *
+             * @param aResource The memory resource, must outlive the array
+             */
+            explicit PagedArray(std::pmr::memory_resource *aResource)
+                : _allocator(aResource),
+                  _pages(aResource)
+            {}
+
+            ~PagedArray() override
+            {
+                releasePages();
+            }
+
+            PagedArray(const PagedArray &other) = delete;
+            PagedArray &operator=(const PagedArray &other) = delete;
+
+            PagedArray(PagedArray &&other) noexcept
+                : ISparseArray(std::move(other)),
+                  _allocator(other._allocator),
+                  _pages(std::exchange(other._pages, std::pmr::vector<Page *>(other._allocator.resource()))),
+                  _size(std::exchange(other._size, 0)),
+                  _count(std::exchange(other._count, 0))
+            {}
+
+            PagedArray &operator=(PagedArray &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+#pragma region operators
+            /**
+             * @brief Get the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return compRef The component of the entity
+             */
+            compRef operator[](vectIndex aIndex)
+            {
+                return get(aIndex);
+            }
+
+            /**
+             * @brief Get the component of the given entity
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return constCompRef The component of the entity
+             */
+            constCompRef operator[](vectIndex aIndex) const
+            {
+                return get(aIndex);
+            }
+#pragma endregion operators
+
+#pragma region methods
+            /**
+             * @brief Get the component of the given entity, stamped as changed
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return compRef The component of the entity
+             */
+            compRef get(vectIndex aIndex)
+            {
+                auto &component = slotOf(*this, aIndex);
+
+                markChanged(aIndex);
+                return *component;
+            }
+
+            /**
+             * @brief Get the component of the given entity, read-only access doesn't stamp it as changed
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @throw SparseArrayExceptionEmpty if the entity doesn't have the component
+             * @param aIndex The entity to get
+             * @return constCompRef The component of the entity
+             */
+            constCompRef get(vectIndex aIndex) const
+            {
+                return *slotOf(*this, aIndex);
+            }
+
+            /**
+             * @brief Set the component of the given entity, replacing the one it has
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @param aIndex The entity
+             * @param aValue The component
+             */
+            void set(vectIndex aIndex, Component &&aValue)
+            {
+                if (aIndex >= _size) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                place(aIndex, std::move(aValue));
+            }
+
+            /**
+             * @brief Check if the given entity has the component
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             */
+            bool has(vectIndex aIndex) const
+            {
+                if (aIndex >= _size) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                return contains(aIndex);
+            }
+
+            /**
+             * @brief Check if the given entity has the component, without throwing
+             */
+            [[nodiscard]] bool contains(vectIndex aIndex) const noexcept
+            {
+                const auto page = aIndex >> pageShift;
+
+                return aIndex < _size && _pages[page] != nullptr
+                       && _pages[page]->slots[aIndex & (pageSize - 1)].has_value();
+            }
+
+            /**
+             * @brief Make the slot of an entity exist, only the table of the pages grows
+             * @param aIndex The entity
+             */
+            void init(vectIndex aIndex) override
+            {
+                if (aIndex >= _size) {
+                    _pages.resize((aIndex >> pageShift) + 1, nullptr);
+                    _size = aIndex + 1;
+                }
+            }
+
+            /**
+             * @brief Nothing to do, the pages are allocated with their first component
+             */
+            void reserve(std::size_t /*count*/) override {}
+
+            /**
+             * @brief Construct the component of the given entity in place, the array grows if needed
+             * @param aIndex The entity
+             * @param aArgs The arguments of the constructor of the component
+             * @return compRef The component of the entity
+             */
+            template<typename... Args>
+            compRef emplace(vectIndex aIndex, Args &&...aArgs)
+            {
+                init(aIndex);
+                return place(aIndex, std::forward<Args>(aArgs)...);
+            }
+
+            /**
+             * @brief Erase the component of the given entity, its page is kept
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range
+             * @param aIndex The entity
+             */
+            void erase(vectIndex aIndex) override
+            {
+                if (aIndex >= _size) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                if (contains(aIndex)) {
+                    _pages[aIndex >> pageShift]->slots[aIndex & (pageSize - 1)].reset();
+                    _count--;
+                    markAbsent(aIndex);
+                }
+            }
+
+            /**
+             * @brief Destroy all the components and release the pages
+             */
+            void clear() override
+            {
+                for (vectIndex idx = 0; idx < _size; idx++) {
+                    if (contains(idx)) {
+                        markAbsent(idx);
+                    }
+                }
+                releasePages();
+                _size = 0;
+                _count = 0;
+            }
+
+            /**
+             * @brief Get the number of components set (not the number of slots)
+             */
+            [[nodiscard]] std::size_t count() const override
+            {
+                return _count;
+            }
+
+            /**
+             * @brief Get the number of slots
+             */
+            [[nodiscard]] vectIndex size() const noexcept
+            {
+                return _size;
+            }
+
+            /**
+             * @brief Get the number of pages allocated
+             */
+            [[nodiscard]] std::size_t pageCount() const noexcept
+            {
+                std::size_t pages = 0;
+
+                for (const auto *page : _pages) {
+                    pages += page != nullptr ? 1 : 0;
+                }
+                return pages;
+            }
+
+            [[nodiscard]] bool isSerializable() const override
+            {
+                return SerializableComponent<Component>;
+            }
+
+            [[nodiscard]] std::string getSerialName() const override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    return serialName<Component>();
+                } else {
+                    return {};
+                }
+            }
+
+            void serialize([[maybe_unused]] SnapshotWriter &aWriter,
+                           [[maybe_unused]] std::size_t aEntityCount) const override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    serializeStorage<Component>(*this, aWriter, aEntityCount);
+                }
+            }
+
+            void deserialize([[maybe_unused]] SnapshotReader &aReader,
+                             [[maybe_unused]] std::size_t aEntityCount) override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    deserializeStorage<Component>(*this, aReader, aEntityCount);
+                }
+            }
+#pragma endregion methods
+
+        private:
+            template<typename Self>
+            static auto &slotOf(Self &aSelf, vectIndex aIndex)
+            {
+                if (aIndex >= aSelf._size) {
+                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
+                }
+                if (!aSelf.contains(aIndex)) {
+                    throw SparseArrayExceptionEmpty("index is empty: " + std::to_string(aIndex));
+                }
+                return aSelf._pages[aIndex >> pageShift]->slots[aIndex & (pageSize - 1)];
+            }
+
+            template<typename... Args>
+            compRef place(vectIndex aIndex, Args &&...aArgs)
+            {
+                auto *&page = _pages[aIndex >> pageShift];
+
+                if (page == nullptr) {
+                    page = _allocator.new_object<Page>();
+                }
+                auto &slot = page->slots[aIndex & (pageSize - 1)];
+                const bool replaced = slot.has_value();
+
+                slot.emplace(std::forward<Args>(aArgs)...);
+                if (replaced) {
+                    markChanged(aIndex);
+                } else {
+                    _count++;
+                    markPresent(aIndex);
+                }
+                return *slot;
+            }
+
+            void releasePages()
+            {
+                for (auto *page : _pages) {
+                    if (page != nullptr) {
+                        _allocator.delete_object(page);
+                    }
+                }
+                _pages.clear();
+            }
+    };
+} // namespace Engine::Core
+
+#endif /* !PAGEDARRAY_HPP_ */
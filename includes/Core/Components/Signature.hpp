@@ -0,0 +1,20 @@
+#ifndef SIGNATURE_HPP_
+#define SIGNATURE_HPP_
+
+#include <bitset>
+#include <cstddef>
+
+namespace Engine::Core {
+    /**
+     * @brief The maximum number of component types registered in one World
+     */
+    static constexpr std::size_t maxComponents = 128;
+
+    /**
+     * @brief The set of components of an entity, one bit per component id of its World
+     * @details Checking that an entity has all the components of a query is a single AND and compare
+     */
+    using Signature = std::bitset<maxComponents>;
+} // namespace Engine::Core
+
+#endif /* !SIGNATURE_HPP_ */
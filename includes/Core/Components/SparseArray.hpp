@@ -5,20 +5,51 @@
 #ifndef SPARSEARRAY_HPP_
 #define SPARSEARRAY_HPP_
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
 #include "Component.hpp"
 #include "Exception.hpp"
+#include "Signature.hpp"
+#include "Core/Serialization/Snapshot.hpp"
 
 namespace Engine::Core {
     DEFINE_EXCEPTION(SparseArrayException);
     DEFINE_EXCEPTION_FROM(SparseArrayExceptionOutOfRange, SparseArrayException);
     DEFINE_EXCEPTION_FROM(SparseArrayExceptionEmpty, SparseArrayException);
 
+    /**
+     * @brief Record when the components of the entities were added and last changed
+     * @details A tick is a counter of the World (see World::getChangeTick), stamped on a slot when its component is
+     * added and on every mutable access. The ticks are kept per entity, and per page of entities as coarse dirty
+     * bits: a page that didn't change since a tick is skipped without looking at its entities
+     */
     class ISparseArray
     {
+        public:
+            using tick = std::uint32_t;
+
+            /**
+             * @brief The number of entities of a page of change ticks is 1 << pageShift
+             */
+            static constexpr std::size_t pageShift = 8;
+
+        protected:
+            std::vector<Signature> *_signatures = nullptr;
+            std::size_t _componentId = 0;
+            const tick *_changeTick = &unboundTick;
+            std::vector<tick> _addedTicks;
+            std::vector<tick> _changedTicks;
+            std::vector<tick> _pageTicks;
+
+        private:
+            static constexpr tick unboundTick = 1;
+
         public:
             ISparseArray() = default;
             virtual ~ISparseArray() = default;
@@ -32,12 +63,171 @@ namespace Engine::Core {
             virtual void init(std::size_t aIndex) = 0;
             virtual void erase(std::size_t aIndex) = 0;
             virtual void clear() = 0;
+
+            /**
+             * @brief Make room for more components, so adding them doesn't reallocate
+             *
+             * @param aCount The number of components about to be added
+             */
+            virtual void reserve(std::size_t aCount) = 0;
+
+            /**
+             * @brief Get the number of entities having the component
+             */
+            [[nodiscard]] virtual std::size_t count() const = 0;
+
+            /**
+             * @brief Check if the components can be written in snapshots, see ComponentSerializer
+             */
+            [[nodiscard]] virtual bool isSerializable() const = 0;
+
+            /**
+             * @brief Get the name of the component in snapshots, empty if it isn't serializable
+             */
+            [[nodiscard]] virtual std::string getSerialName() const = 0;
+
+            /**
+             * @brief Write the components in a snapshot, see serializeStorage
+             *
+             * @param aWriter The writer
+             * @param aEntityCount The number of entity indexes of the World
+             */
+            virtual void serialize(SnapshotWriter &aWriter, std::size_t aEntityCount) const = 0;
+
+            /**
+             * @brief Read the components of a snapshot into the storage, which must be empty
+             * @throw SnapshotExceptionCorrupted If the block is malformed
+             * @param aReader The reader
+             * @param aEntityCount The number of entity indexes of the World
+             */
+            virtual void deserialize(SnapshotReader &aReader, std::size_t aEntityCount) = 0;
+
+            /**
+             * @brief Keep the bit of the component up to date in the signatures of the entities
+             *
+             * @param aSignatures The signatures of the entities, indexed by entity
+             * @param aComponentId The bit of the component in the signatures
+             */
+            void bindSignatures(std::vector<Signature> *aSignatures, std::size_t aComponentId)
+            {
+                _signatures = aSignatures;
+                _componentId = aComponentId;
+            }
+
+            /**
+             * @brief Stamp the writes with the tick of a World
+             *
+             * @param aChangeTick The current tick, read on each write
+             */
+            void bindChangeTick(const tick *aChangeTick)
+            {
+                _changeTick = aChangeTick;
+            }
+
+            /**
+             * @brief Check if the component of an entity was added after a tick
+             */
+            [[nodiscard]] bool addedSince(std::size_t aIndex, tick aTick) const noexcept
+            {
+                return aIndex < _addedTicks.size() && _addedTicks[aIndex] > aTick;
+            }
+
+            /**
+             * @brief Check if the component of an entity was added or changed after a tick
+             */
+            [[nodiscard]] bool changedSince(std::size_t aIndex, tick aTick) const noexcept
+            {
+                return aIndex < _changedTicks.size() && _changedTicks[aIndex] > aTick;
+            }
+
+            /**
+             * @brief Check if a component of the page of an entity was added or changed after a tick
+             */
+            [[nodiscard]] bool pageChangedSince(std::size_t aIndex, tick aTick) const noexcept
+            {
+                if ((aIndex >> pageShift) >= _pageTicks.size()) {
+                    return false;
+                }
+                const std::atomic_ref<tick> pageTick(const_cast<tick &>(_pageTicks[aIndex >> pageShift]));
+
+                return pageTick.load(std::memory_order_relaxed) > aTick;
+            }
+
+            /**
+             * @brief Stamp the component of an entity as changed, done by every mutable access
+             *
+             * @param aIndex The entity
+             */
+            void markChanged(std::size_t aIndex)
+            {
+                const auto now = *_changeTick;
+
+                if (aIndex >= _changedTicks.size()) {
+                    growTicks(aIndex);
+                }
+                _changedTicks[aIndex] = now;
+                // The entities of a page may be written by several workers of forEachParallel
+                std::atomic_ref<tick> page(_pageTicks[aIndex >> pageShift]);
+
+                if (page.load(std::memory_order_relaxed) != now) {
+                    page.store(now, std::memory_order_relaxed);
+                }
+            }
+
+            /**
+             * @brief Stamp the components of a range of entities as changed, like markChanged on each
+             *
+             * @param aFirst The first entity
+             * @param aCount The number of entities
+             */
+            void markChanged(std::size_t aFirst, std::size_t aCount)
+            {
+                if (aCount == 0) {
+                    return;
+                }
+                const auto now = *_changeTick;
+                const auto last = aFirst + aCount - 1;
+
+                if (last >= _changedTicks.size()) {
+                    growTicks(last);
+                }
+                std::fill_n(_changedTicks.begin() + static_cast<std::ptrdiff_t>(aFirst), aCount, now);
+                for (auto page = aFirst >> pageShift; page <= last >> pageShift; page++) {
+                    std::atomic_ref<tick>(_pageTicks[page]).store(now, std::memory_order_relaxed);
+                }
+            }
+
+        protected:
+            void markPresent(std::size_t aIndex)
+            {
+                if (_signatures != nullptr && aIndex < _signatures->size()) {
+                    (*_signatures)[aIndex].set(_componentId);
+                }
+                markChanged(aIndex);
+                _addedTicks[aIndex] = *_changeTick;
+            }
+
+            void markAbsent(std::size_t aIndex)
+            {
+                if (_signatures != nullptr && aIndex < _signatures->size()) {
+                    (*_signatures)[aIndex].reset(_componentId);
+                }
+            }
+
+        private:
+            void growTicks(std::size_t aIndex)
+            {
+                _addedTicks.resize(aIndex + 1, 0);
+                _changedTicks.resize(aIndex + 1, 0);
+                _pageTicks.resize((aIndex >> pageShift) + 1, 0);
+            }
     };
 
     /**
      * @brief SparseArray is a class that store a vector of optional of a given type
      * It represents a ONE component type, each index in the array represent the component of the entity at the same
-     * index
+     * index. The entities owning a component are also kept in a dense list, so a query can be driven by the array
+     * (see entities). The slots are allocated from a memory resource, see World::World(std::pmr::memory_resource *)
      *
      * @tparam Component The type of the components to store
      */
@@ -49,17 +239,32 @@ namespace Engine::Core {
             using constCompRef = const Component &;
             using optComponent = std::optional<Component>;
             using optCompRef = optComponent &;
-            using vectArray = std::vector<optComponent>;
+            using vectArray = std::pmr::vector<optComponent>;
             using vectIndex = typename vectArray::size_type;
             using iterator = typename vectArray::iterator;
             using constIterator = typename vectArray::const_iterator;
+            using entitiesArray = std::pmr::vector<std::size_t>;
 
         private:
             vectArray _array;
+            entitiesArray _entities;
+            std::pmr::vector<std::size_t> _slots;
 
         public:
 #pragma region constructors / destructors
             SparseArray() = default;
+
+            /**
+             * @brief Construct a new Sparse Array allocating its slots from a memory resource
+             *
+             * @param aResource The memory resource, must outlive the array
+             */
+            explicit SparseArray(std::pmr::memory_resource *aResource)
+                : _array(aResource),
+                  _entities(aResource),
+                  _slots(aResource)
+            {}
+
             ~SparseArray() override = default;
 
             SparseArray(const SparseArray &other) = default;
@@ -80,13 +285,7 @@ namespace Engine::Core {
              */
             compRef operator[](vectIndex aIndex)
             {
-                if (aIndex >= _array.size() || aIndex < 0) {
-                    throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
-                }
-                if (!_array[aIndex].has_value()) {
-                    throw SparseArrayExceptionEmpty("index is empty: " + std::to_string(aIndex));
-                }
-                return _array[aIndex].value();
+                return get(aIndex);
             }
 
             /**
@@ -112,7 +311,7 @@ namespace Engine::Core {
 #pragma region methods
 
             /**
-             * @brief Get the component at the given index
+             * @brief Get the component at the given index, stamped as changed
              * @throw SparseArrayExceptionOutOfRange if the index is out of range or if the index is empty
              * @throw SparseArrayExceptionEmpty if the component is empty
              * @param index The index to get
@@ -126,9 +325,22 @@ namespace Engine::Core {
                 if (!_array[aIndex].has_value()) {
                     throw SparseArrayExceptionEmpty("index is empty: " + std::to_string(aIndex));
                 }
+                markChanged(aIndex);
                 return _array[aIndex].value();
             }
 
+            /**
+             * @brief Get the component at the given index, read-only access doesn't stamp it as changed
+             * @throw SparseArrayExceptionOutOfRange if the index is out of range or if the index is empty
+             * @throw SparseArrayExceptionEmpty if the component is empty
+             * @param index The index to get
+             * @return constCompRef The component at the given index
+             */
+            constCompRef get(vectIndex aIndex) const
+            {
+                return (*this)[aIndex];
+            }
+
             /**
              * @brief Set the component at the given index
              * @throw SparseArrayExceptionOutOfRange if the index is out of range
@@ -140,6 +352,11 @@ namespace Engine::Core {
                 if (aIndex >= _array.size()) {
                     throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
                 }
+                if (!_array[aIndex].has_value()) {
+                    link(aIndex);
+                } else {
+                    markChanged(aIndex);
+                }
                 _array[aIndex] = std::move(aValue);
             }
 
@@ -158,6 +375,17 @@ namespace Engine::Core {
                 return _array[aIndex].has_value();
             }
 
+            /**
+             * @brief Check if the component at the given index is set, without throwing
+             * @param aIndex The index to check
+             * @return true if the component is set
+             * @return false if the component is not set or the index is out of range
+             */
+            [[nodiscard]] bool contains(vectIndex aIndex) const noexcept
+            {
+                return aIndex < _array.size() && _array[aIndex].has_value();
+            }
+
             /**
              * @brief Init the component at the given index, will resize the array if needed and set each value to
              * std::nullopt
@@ -170,6 +398,11 @@ namespace Engine::Core {
                 }
             }
 
+            /**
+             * @brief Nothing to do, the slots of the entities are created by init
+             */
+            void reserve(std::size_t /*count*/) override {}
+
             /**
              * @brief Emplace the component at the given index, will resize the array if needed and set each value to
              * std::nullopt
@@ -183,6 +416,11 @@ namespace Engine::Core {
                 if (aIndex >= _array.size()) {
                     _array.resize(aIndex + 1);
                 }
+                if (!_array[aIndex].has_value()) {
+                    link(aIndex);
+                } else {
+                    markChanged(aIndex);
+                }
                 _array[aIndex].emplace(Component(std::forward<Args>(aArgs)...));
                 return _array[aIndex].value();
             }
@@ -198,6 +436,9 @@ namespace Engine::Core {
                 if (aIndex >= _array.size()) {
                     throw SparseArrayExceptionOutOfRange("index out of range: " + std::to_string(aIndex));
                 }
+                if (_array[aIndex].has_value()) {
+                    unlink(aIndex);
+                }
                 _array[aIndex].reset();
             }
 
@@ -206,7 +447,62 @@ namespace Engine::Core {
              */
             void clear() override
             {
+                for (vectIndex idx = 0; idx < _array.size(); idx++) {
+                    if (_array[idx].has_value()) {
+                        markAbsent(idx);
+                    }
+                }
                 _array.clear();
+                _entities.clear();
+                _slots.clear();
+            }
+
+            /**
+             * @brief Get the number of components set (not the number of slots)
+             */
+            [[nodiscard]] std::size_t count() const override
+            {
+                return _entities.size();
+            }
+
+            /**
+             * @brief Get the entities owning a component, in no particular order
+             *
+             * @return const entitiesArray& The dense list of entities
+             */
+            [[nodiscard]] const entitiesArray &entities() const
+            {
+                return _entities;
+            }
+
+            [[nodiscard]] bool isSerializable() const override
+            {
+                return SerializableComponent<Component>;
+            }
+
+            [[nodiscard]] std::string getSerialName() const override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    return serialName<Component>();
+                } else {
+                    return {};
+                }
+            }
+
+            void serialize([[maybe_unused]] SnapshotWriter &aWriter,
+                           [[maybe_unused]] std::size_t aEntityCount) const override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    serializeStorage<Component>(*this, aWriter, aEntityCount);
+                }
+            }
+
+            void deserialize([[maybe_unused]] SnapshotReader &aReader,
+                             [[maybe_unused]] std::size_t aEntityCount) override
+            {
+                if constexpr (SerializableComponent<Component>) {
+                    deserializeStorage<Component>(*this, aReader, aEntityCount);
+                }
             }
 
 #pragma endregion methods
@@ -249,6 +545,27 @@ namespace Engine::Core {
             }
 
 #pragma endregion iterator
+
+        private:
+            void link(vectIndex aIndex)
+            {
+                if (aIndex >= _slots.size()) {
+                    _slots.resize(aIndex + 1);
+                }
+                _slots[aIndex] = _entities.size();
+                _entities.push_back(aIndex);
+                markPresent(aIndex);
+            }
+
+            void unlink(vectIndex aIndex)
+            {
+                const auto last = _entities.back();
+
+                _entities[_slots[aIndex]] = last;
+                _slots[last] = _slots[aIndex];
+                _entities.pop_back();
+                markAbsent(aIndex);
+            }
     };
 } // namespace Engine::Core
 
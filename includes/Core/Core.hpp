@@ -2,11 +2,22 @@
 #define CORE_HPP_
 
 #include "App.hpp"
+#include "ArchetypeWorld.hpp"
 #include "Clock.hpp"
+#include "Commands/CommandBuffer.hpp"
 #include "Components/Component.hpp"
+#include "Components/ComponentStorage.hpp"
+#include "Entity.hpp"
 #include "Events/Event.hpp"
 #include "Events/EventHandler.hpp"
 #include "Events/EventsManager.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Memory/FrameArena.hpp"
+#include "Profiling/Profiler.hpp"
+#include "Relations/Hierarchy.hpp"
+#include "Spatial/HashGrid.hpp"
+#include "Spatial/LooseQuadtree.hpp"
+#include "Spatial/SpatialIndex.hpp"
 #include "Systems/GenericSystem.hpp"
 #include "Systems/System.hpp"
 #endif /* !CORE_HPP_ */
@@ -0,0 +1,31 @@
+#ifndef ENTITY_HPP_
+#define ENTITY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine::Core {
+    /**
+     * @brief A handle on an entity: its index in the World and the generation of that index
+     * @details The generation of an index is bumped each time the entity is killed, so a handle kept after the death
+     * of its entity is detected as stale (see World::isAlive) instead of aliasing the next entity reusing the index.
+     * The conversion to the index is explicit, so a handle never falls silently into an API taking a raw index
+     */
+    struct Entity
+    {
+        public:
+            using generationType = std::uint32_t;
+
+            std::size_t index = 0;
+            generationType generation = 0;
+
+            constexpr explicit operator std::size_t() const noexcept
+            {
+                return index;
+            }
+
+            constexpr bool operator==(const Entity &other) const = default;
+    };
+} // namespace Engine::Core
+
+#endif /* !ENTITY_HPP_ */
@@ -9,6 +9,12 @@ namespace Engine::Event {
             virtual ~Event() = default;
     };
 
+    /**
+     * @brief Tag of the event types, see Core::TypeId
+     */
+    struct EventFamily
+    {};
+
     template<typename T>
     concept EventConcept = std::is_base_of_v<Event, T>;
 } // namespace Engine::Event
@@ -2,11 +2,48 @@
 #define EVENTHANDLER_HPP_
 
 #include <algorithm>
-#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "Event.hpp"
+#include "Exception.hpp"
 
 namespace Engine::Event {
+    DEFINE_EXCEPTION(EventHandlerException);
+    DEFINE_EXCEPTION_FROM(EventHandlerExceptionImmediateUnsubscribe, EventHandlerException);
+
+    /**
+     * @brief When a subscriber is called
+     */
+    enum class DispatchMode
+    {
+        /**
+         * @brief Called right away by pushEvent, on the pushing thread
+         */
+        Immediate,
+        /**
+         * @brief Called by swapBuffers, for each event of the new frame
+         */
+        OnSwap,
+    };
+
+    /**
+     * @brief Identify a subscription, to unsubscribe in O(1)
+     */
+    struct SubscriptionHandle
+    {
+        public:
+            std::size_t typeId = 0;
+            std::size_t slot = 0;
+            std::uint32_t generation = 0;
+    };
 
     class IEventHandler
     {
@@ -21,10 +58,37 @@ namespace Engine::Event {
             IEventHandler &operator=(IEventHandler &&other) noexcept = default;
 
             virtual void clearEvents() = 0;
+
+            /**
+             * @brief Start a new frame: the events pushed since the last swap become the readable events
+             *
+             * @param aKeep Keep the unconsumed events of the ending frame in the new one instead of dropping them
+             */
+            virtual void swapBuffers(bool aKeep) = 0;
+
+            /**
+             * @brief Remove a subscriber, nothing happens if the subscription already ended
+             * @throw EventHandlerExceptionImmediateUnsubscribe If an Immediate subscriber is being called
+             *
+             * @param aSlot The slot of the subscription
+             * @param aGeneration The generation of the slot when the subscription was made
+             */
+            virtual void unsubscribe(std::size_t aSlot, std::uint32_t aGeneration) = 0;
     };
 
     /**
-     * @brief Class that handle one type of event
+     * @brief Class that handle one type of event, double buffered
+     * @details Producers push to the "next" buffer: a lock-free intrusive stack (one compare-and-swap per event), any
+     * thread may push at any time. Readers see the "current" buffer, the events of the frame, as an immutable span
+     * that pushes never touch. swapBuffers starts a new frame, it must not run concurrently with the readers.
+     * Consuming an event sets its bit in an atomic bitmask instead of erasing it, several readers may consume at once.
+     * Subscribers are kept in a contiguous array sorted by priority, each one is a context pointer and a function
+     * pointer instantiated for its callable, so dispatching doesn't go through std::function. Subscribing and
+     * unsubscribing must not run concurrently with pushes or swaps. An OnSwap callback may unsubscribe but not
+     * subscribe. An Immediate callback may do neither: it runs on a producer thread, concurrently with the other
+     * pushes, so unsubscribing throws while one is being called.
+     * The queued events are allocated from a memory resource, the per-frame arena of the EventManager: their memory is
+     * released by the swap that reads them, the next buffer never holds an event pushed before the previous swap
      *
      * @tparam Event the type of event to handle
      */
@@ -33,124 +97,349 @@ namespace Engine::Event {
     {
         public:
             using containerT = std::vector<Event>;
-            using containerTRef = std::vector<Event> &;
-            using containerTConstRef = const std::vector<Event> &;
+            using eventsView = std::span<const Event>;
 
         private:
-            containerT _events;
-            std::mutex _mutex;
+            using word = std::uint64_t;
+
+            static constexpr std::size_t wordBits = 64;
+
+            struct Node
+            {
+                    Event event;
+                    Node *next = nullptr;
+            };
+
+            struct Listener
+            {
+                    void *context;
+                    void (*call)(void *aContext, const Event &aEvent);
+                    void (*destroy)(void *aContext);
+                    int priority;
+                    DispatchMode mode;
+                    std::size_t slot;
+                    bool active;
+            };
+
+            std::pmr::polymorphic_allocator<> _allocator;
+            std::atomic<Node *> _next {nullptr};
+            containerT _current;
+            std::unique_ptr<std::atomic<word>[]> _consumed;
+            std::size_t _consumedWords = 0;
+            std::vector<Listener> _listeners;
+            std::vector<std::size_t> _slotPositions;
+            std::vector<std::uint32_t> _slotGenerations;
+            std::vector<std::size_t> _freeSlots;
+            std::size_t _immediateListeners = 0;
+            std::size_t _onSwapListeners = 0;
+            std::size_t _removedListeners = 0;
+            std::atomic<std::size_t> _immediateCalls {0};
 
         public:
 #pragma region constructors / destructors
             /**
              * @brief Construct a new Event Handler object
              *
+             * @param aResource The memory resource of the queued events, must outlive the handler
              */
-            EventHandler() = default;
+            explicit EventHandler(std::pmr::memory_resource *aResource = std::pmr::new_delete_resource())
+                : _allocator(aResource)
+            {}
             /**
              * @brief Destroy the Event Handler object
              *
              */
-            ~EventHandler() override = default;
-
-            EventHandler(const EventHandler &aOther)
-                : _events(aOther._events)
-            {}
-
-            EventHandler(EventHandler &&aOther) noexcept
-                : _events(std::move(aOther._events))
-            {}
-
-            EventHandler &operator=(const EventHandler &aOther)
+            ~EventHandler() override
             {
-                if (this == &aOther) {
-                    return *this;
+                deleteNodes(_next.exchange(nullptr, std::memory_order_acquire));
+                for (const auto &listener : _listeners) {
+                    listener.destroy(listener.context);
                 }
-                _events = aOther._events;
-                return *this;
             }
 
-            EventHandler &operator=(EventHandler &&aOther) noexcept
-            {
-                if (this == &aOther) {
-                    return *this;
-                }
-                _events = std::move(aOther._events);
-                return *this;
-            }
+            EventHandler(const EventHandler &aOther) = delete;
+            EventHandler &operator=(const EventHandler &aOther) = delete;
+
+            EventHandler(EventHandler &&aOther) noexcept = delete;
+            EventHandler &operator=(EventHandler &&aOther) noexcept = delete;
 #pragma endregion constructors / destructors
 
 #pragma region methods
 
             /**
-             * @brief Push an Event
-             * @details Can wait for the mutex to be unlocked
+             * @brief Push an Event in the next frame, after calling the Immediate subscribers
+             * @details Lock-free, safe to call from any number of threads
              * @param aEvent the new event to add to the list
              */
             void pushEvent(const Event &aEvent)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
+                auto *node = _allocator.new_object<Node>(aEvent);
 
-                _events.push_back(aEvent);
+                dispatchImmediate(node->event);
+                push(node);
             }
 
             /**
-             * @brief Get the Events object
+             * @brief Push an Event in the next frame, after calling the Immediate subscribers
+             * @details Lock-free, safe to call from any number of threads
+             * @param aEvent the new event to add to the list
+             */
+            void pushEvent(Event &&aEvent)
+            {
+                auto *node = _allocator.new_object<Node>(std::move(aEvent));
+
+                dispatchImmediate(node->event);
+                push(node);
+            }
+
+            /**
+             * @brief Call a function for each event of the type, until unsubscribed
+             * @details The subscribers with the highest priority are called first, then in subscription order
              *
-             * @return containerTRef the list of events
+             * @param aFunc Callable as func(const Event &), copied in the handler
+             * @param aPriority The priority of the subscriber
+             * @param aMode When the subscriber is called
+             * @return std::pair<std::size_t, std::uint32_t> The slot and the generation of the subscription
+             */
+            template<typename Func>
+            std::pair<std::size_t, std::uint32_t> subscribe(Func &&aFunc, int aPriority, DispatchMode aMode)
+            {
+                using callable = std::decay_t<Func>;
+
+                std::size_t slot = _slotPositions.size();
+
+                if (_freeSlots.empty()) {
+                    _slotPositions.push_back(0);
+                    _slotGenerations.push_back(0);
+                } else {
+                    slot = _freeSlots.back();
+                    _freeSlots.pop_back();
+                }
+                compact();
+
+                const auto pos =
+                    std::ranges::upper_bound(_listeners, aPriority, std::greater<> {}, &Listener::priority);
+
+                _listeners.insert(pos, Listener {new callable(std::forward<Func>(aFunc)), &call<callable>,
+                                                 &destroy<callable>, aPriority, aMode, slot, true});
+                updatePositions();
+                (aMode == DispatchMode::Immediate ? _immediateListeners : _onSwapListeners)++;
+                return {slot, _slotGenerations[slot]};
+            }
+
+            void unsubscribe(std::size_t aSlot, std::uint32_t aGeneration) override
+            {
+                if (_immediateCalls.load(std::memory_order_acquire) != 0) {
+                    throw EventHandlerExceptionImmediateUnsubscribe("Can't unsubscribe while pushing an event");
+                }
+                if (aSlot >= _slotGenerations.size() || _slotGenerations[aSlot] != aGeneration) {
+                    return;
+                }
+                auto &listener = _listeners[_slotPositions[aSlot]];
+
+                (listener.mode == DispatchMode::Immediate ? _immediateListeners : _onSwapListeners)--;
+                listener.active = false;
+                _slotGenerations[aSlot]++;
+                _freeSlots.push_back(aSlot);
+                _removedListeners++;
+            }
+
+            /**
+             * @brief Get the events of the current frame, consumed ones included
+             * @details Events pushed by a producer keep their push order
+             * @return eventsView the events, valid until the next swap
+             */
+            [[nodiscard]] eventsView getEvents() const
+            {
+                return _current;
+            }
+
+            /**
+             * @brief Mark an event of the current frame as consumed
+             * @details Safe to call from several readers at once, an index out of range is ignored
+             * @param aIdx the index of the event
              */
-            containerTRef getEvents()
+            void consume(std::size_t aIdx)
             {
-                return _events;
+                if (aIdx < _current.size()) {
+                    _consumed[aIdx / wordBits].fetch_or(word(1) << (aIdx % wordBits), std::memory_order_relaxed);
+                }
             }
 
             /**
-             * @brief Get the Events object
+             * @brief Check if an event of the current frame was consumed
+             */
+            [[nodiscard]] bool isConsumed(std::size_t aIdx) const
+            {
+                return aIdx < _current.size()
+                       && (_consumed[aIdx / wordBits].load(std::memory_order_relaxed) & (word(1) << (aIdx % wordBits)))
+                              != 0;
+            }
+
+            /**
+             * @brief Call the function for each event of the current frame that isn't consumed
              *
-             * @return containerTConstRef the list of events
+             * @param aFunc Callable as func(idx, event)
              */
-            containerTConstRef getEvents() const
+            template<typename Func>
+            void forEachEvent(Func &&aFunc) const
             {
-                return _events;
+                for (std::size_t idx = 0; idx < _current.size(); idx++) {
+                    if (!isConsumed(idx)) {
+                        aFunc(idx, _current[idx]);
+                    }
+                }
             }
 
             /**
-             * @brief Erase all the events
-             * @details Can wait for the mutex to be unlocked
+             * @brief Erase all the events, of both buffers
              */
             void clearEvents() override
             {
-                std::lock_guard<std::mutex> lock(_mutex);
+                deleteNodes(_next.exchange(nullptr, std::memory_order_acquire));
+                _current.clear();
+            }
+
+            void swapBuffers(bool aKeep) override
+            {
+                Node *head = _next.exchange(nullptr, std::memory_order_acquire);
+                Node *reversed = nullptr;
+
+                if (aKeep) {
+                    std::size_t kept = 0;
+
+                    for (std::size_t idx = 0; idx < _current.size(); idx++) {
+                        if (!isConsumed(idx)) {
+                            _current[kept++] = std::move(_current[idx]);
+                        }
+                    }
+                    _current.erase(_current.begin() + static_cast<std::ptrdiff_t>(kept), _current.end());
+                } else {
+                    _current.clear();
+                }
+                // The stack holds the newest event first, reverse it to restore the push order
+                while (head != nullptr) {
+                    auto *next = head->next;
+
+                    head->next = reversed;
+                    reversed = head;
+                    head = next;
+                }
+                const auto firstNew = _current.size();
+
+                while (reversed != nullptr) {
+                    auto *next = reversed->next;
+
+                    _current.push_back(std::move(reversed->event));
+                    _allocator.delete_object(reversed);
+                    reversed = next;
+                }
+                resetConsumed();
+                compact();
+                for (auto idx = firstNew; _onSwapListeners > 0 && idx < _current.size(); idx++) {
+                    dispatch(_current[idx], DispatchMode::OnSwap, _onSwapListeners);
+                }
+            }
+#pragma endregion methods
+
+        private:
+            /**
+             * @brief Call the Immediate subscribers, counted as running so unsubscribe can refuse to run meanwhile
+             */
+            void dispatchImmediate(const Event &aEvent)
+            {
+                if (_immediateListeners == 0) {
+                    return;
+                }
+                _immediateCalls.fetch_add(1, std::memory_order_acq_rel);
+                try {
+                    dispatch(aEvent, DispatchMode::Immediate, _immediateListeners);
+                } catch (...) {
+                    _immediateCalls.fetch_sub(1, std::memory_order_acq_rel);
+                    throw;
+                }
+                _immediateCalls.fetch_sub(1, std::memory_order_acq_rel);
+            }
 
-                _events.clear();
+            void dispatch(const Event &aEvent, DispatchMode aMode, std::size_t aListeners) const
+            {
+                if (aListeners == 0) {
+                    return;
+                }
+                for (const auto &listener : _listeners) {
+                    if (listener.mode == aMode && listener.active) {
+                        listener.call(listener.context, aEvent);
+                    }
+                }
             }
 
             /**
-             * @brief Remove an event from the list
-             * @details Can wait for the mutex to be unlocked
-             * @param aIdx the index of the event to remove
+             * @brief Drop the listeners unsubscribed since the last compaction, unsubscribe only marks them so a
+             * subscriber can unsubscribe from its own callback
              */
-            void removeEvent(const std::size_t aIdx)
+            void compact()
             {
-                if (aIdx >= _events.size()) {
+                if (_removedListeners == 0) {
                     return;
                 }
-                std::lock_guard<std::mutex> lock(_mutex);
+                std::erase_if(_listeners, [](const Listener &aListener) {
+                    if (!aListener.active) {
+                        aListener.destroy(aListener.context);
+                    }
+                    return !aListener.active;
+                });
+                _removedListeners = 0;
+                updatePositions();
+            }
 
-                _events.erase(_events.begin() + aIdx);
+            void updatePositions()
+            {
+                for (std::size_t pos = 0; pos < _listeners.size(); pos++) {
+                    _slotPositions[_listeners[pos].slot] = pos;
+                }
             }
 
-            void removeEvent(const Event &aEvent)
+            template<typename Callable>
+            static void call(void *aContext, const Event &aEvent)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
+                (*static_cast<Callable *>(aContext))(aEvent);
+            }
 
-                auto itx = std::find(_events.begin(), _events.end(), aEvent);
+            template<typename Callable>
+            static void destroy(void *aContext)
+            {
+                delete static_cast<Callable *>(aContext);
+            }
+
+            void push(Node *aNode)
+            {
+                aNode->next = _next.load(std::memory_order_relaxed);
+                while (!_next.compare_exchange_weak(aNode->next, aNode, std::memory_order_release,
+                                                    std::memory_order_relaxed)) {}
+            }
+
+            void resetConsumed()
+            {
+                const auto words = (_current.size() + wordBits - 1) / wordBits;
 
-                if (itx != _events.end()) {
-                    _events.erase(itx);
+                if (words > _consumedWords) {
+                    _consumed = std::make_unique<std::atomic<word>[]>(words);
+                    _consumedWords = words;
+                }
+                for (std::size_t idx = 0; idx < words; idx++) {
+                    _consumed[idx].store(0, std::memory_order_relaxed);
+                }
+            }
+
+            void deleteNodes(Node *aHead)
+            {
+                while (aHead != nullptr) {
+                    auto *next = aHead->next;
+
+                    _allocator.delete_object(aHead);
+                    aHead = next;
                 }
             }
-#pragma endregion methods
     };
 } // namespace Engine::Event
 #endif /* !EVENTHANDLER_HPP_ */
\ No newline at end of file
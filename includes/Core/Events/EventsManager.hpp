@@ -1,32 +1,54 @@
 #ifndef EVENTMANAGER_HPP
 #define EVENTMANAGER_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <iostream>
 #include <memory>
-#include <typeindex>
+#include <mutex>
+#include <span>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include "Event.hpp"
 #include "EventHandler.hpp"
+#include "Core/Memory/FrameArena.hpp"
+#include "Core/TypeRegistry.hpp"
 #include "Exception.hpp"
-#include <boost/container/flat_map.hpp>
 
 namespace Engine::Event {
     DEFINE_EXCEPTION(EventManagerException);
     DEFINE_EXCEPTION_FROM(EventManagerExceptionNoHandler, EventManagerException);
+    DEFINE_EXCEPTION_FROM(EventManagerExceptionTooManyEvents, EventManagerException);
 
     /**
-     * @brief EventManager class is a singleton that manage all events
-     *
+     * @brief EventManager class manage the events of a World, each World owns one (see World::getEventManager)
+     * @details getInstance is the global bus, for the app-level events shared by the worlds. Managers share nothing,
+     * the worlds of a process push and read their events without contending with each other. Pushing an event never
+     * locks: the handler is found in a fixed table of atomic pointers indexed by the id of the event type, then the
+     * event goes to the lock-free queue of the handler. The events are double buffered: pushed events are read after
+     * the next swapBuffers, readers get an immutable span of the current frame and consume events with a bitmask. The
+     * mutex only guards the registration of the handlers and the swaps. The queued events are allocated in a per-frame
+     * arena owned by the manager, so pushing doesn't go through the heap once the arena is warm
      */
     class EventManager final
     {
         public:
             using eventHandler = std::unique_ptr<IEventHandler>;
+            using eventHandlers = Core::TypeRegistry<EventFamily, eventHandler>;
+
+            /**
+             * @brief The number of event types the process can use, see Core::TypeId
+             */
+            static constexpr std::size_t maxEventTypes = 256;
 
         private:
-            boost::container::flat_map<std::type_index, eventHandler> _eventsHandler;
+            // Declared first, the handlers release their queued events to it when destroyed
+            Core::FrameArena _arena;
+            eventHandlers _eventsHandler;
+            std::array<std::atomic<IEventHandler *>, maxEventTypes> _handlerTable {};
             std::mutex _mutex;
 
         public:
@@ -40,21 +62,21 @@ namespace Engine::Event {
 
             //-------------------OPERATORS-------------------//
             /**
-             * @brief Copy assignment operator, delete because singleton.
+             * @brief Copy assignment operator, delete because the handlers are published by address.
              *
              * @param aOther The EventManager to copy.
              */
             EventManager(const EventManager &aOther) = delete;
 
             /**
-             * @brief Move assignment operator, delete because singleton.
+             * @brief Move assignment operator, delete because the handlers are published by address.
              *
              * @param aOther The EventManager to move.
              */
             EventManager(EventManager &&aOther) noexcept = delete;
 
             /**
-             * @brief Copy assignment operator, delete because singleton.
+             * @brief Copy assignment operator, delete because the handlers are published by address.
              *
              * @param aOther The EventManager to copy.
              * @return EventManager& A reference to the EventManager.
@@ -62,7 +84,7 @@ namespace Engine::Event {
             EventManager &operator=(const EventManager &aOther) = delete;
 
             /**
-             * @brief Move assignment operator, delete because singleton.
+             * @brief Move assignment operator, delete because the handlers are published by address.
              *
              * @param aOther The EventManager to move.
              * @return EventManager& A reference to the EventManager.
@@ -71,7 +93,8 @@ namespace Engine::Event {
 
             //-------------------METHODS-------------------//
             /**
-             * @brief Get the Instance object (singleton)
+             * @brief Get the global bus, for the app-level events
+             * @details The events of a World go through its own manager, see World::getEventManager
              *
              * @return EventManager A reference to the EventManager.
              */
@@ -79,15 +102,14 @@ namespace Engine::Event {
 
             /**
              * @brief Push an event to the queue
-             * @details Doesn't call the subscribers
+             * @details The Immediate subscribers of the event are called first, on the pushing thread, the OnSwap
+             * ones by the next swapBuffers. Lock-free, safe to call from any thread
              * @param aEvent The event to push.
              * @tparam Event The type of the event.
              */
             template<EventConcept Event>
             void pushEvent(const Event &aEvent)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-
                 try {
                     auto &handler = getHandler<Event>();
 
@@ -98,15 +120,15 @@ namespace Engine::Event {
             }
 
             /**
-             * @brief Get all the events of a specific type
+             * @brief Get the events of the current frame of a specific type
+             * @details The span is immutable and pushes never touch it, any number of threads may read it until the
+             * next swapBuffers. Consumed events are included, see isEventConsumed and forEachEvent
              * @tparam Event The type of the event.
-             * @return std::vector<Event>& The list of events.
+             * @return std::span<const Event> The events of the frame.
              */
             template<EventConcept Event>
-            std::vector<Event> &getEvents()
+            std::span<const Event> getEvents()
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-
                 try {
                     auto &handler = getHandler<Event>();
 
@@ -117,72 +139,127 @@ namespace Engine::Event {
             }
 
             /**
-             * @brief Clear all the events of the types that aren't in the list
+             * @brief Call the function for each event of the current frame that isn't consumed
+             * @tparam Event The type of the event.
+             * @param aFunc Callable as func(idx, event)
+             */
+            template<EventConcept Event, typename Func>
+            void forEachEvent(Func &&aFunc)
+            {
+                if (auto *handler = findHandler<Event>()) {
+                    handler->forEachEvent(std::forward<Func>(aFunc));
+                }
+            }
+
+            /**
+             * @brief Start a new frame for every type of event
+             * @details The events pushed since the last swap become the events returned by getEvents, the events of
+             * the ending frame are dropped. Must not run while events are read
+             */
+            void swapBuffers()
+            {
+                keepEventsAndClear();
+            }
+
+            /**
+             * @brief Start a new frame, the unconsumed events of the types in the list are kept in the new frame
+             * @details A buffer swap per handler, the events of the other types are dropped
              * @tparam EventList The list of events to keep.
              */
             template<EventConcept... EventList>
             void keepEventsAndClear()
             {
                 std::lock_guard<std::mutex> lock(_mutex);
-                std::vector<std::type_index> eventIndexList = {std::type_index(typeid(EventList))...};
+                std::vector<std::size_t> eventIdList = {_eventsHandler.template find<EventList>()...};
 
-                for (auto &handler : _eventsHandler) {
-                    if (std::find(eventIndexList.begin(), eventIndexList.end(), handler.first)
-                        == eventIndexList.end()) {
-                        handler.second->clearEvents();
+                for (std::size_t eventId = 0; eventId < _eventsHandler.size(); eventId++) {
+                    if (_eventsHandler[eventId]) {
+                        _eventsHandler[eventId]->swapBuffers(
+                            std::find(eventIdList.begin(), eventIdList.end(), eventId) != eventIdList.end());
                     }
                 }
+                _arena.nextFrame();
             }
 
             /**
-             * @brief Remove an event from the queue
-             * @param aIndex The index of the event to remove.
+             * @brief Mark an event of the current frame as consumed, the event stays in place
+             * @details Safe to call from several threads at once
+             * @param aIndex The index of the event to consume.
              * @tparam Event The type of the event.
-             *
              */
             template<EventConcept Event>
-            void removeEvent(const std::size_t aIndex)
+            void consumeEvent(const std::size_t aIndex)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                auto eventIndex = std::type_index(typeid(Event));
-
-                if (_eventsHandler.find(eventIndex) == _eventsHandler.end()) {
-                    return;
+                if (auto *handler = findHandler<Event>()) {
+                    handler->consume(aIndex);
                 }
-                try {
-                    auto &handler = getHandler<Event>();
+            }
 
-                    handler.removeEvent(aIndex);
-                } catch (const EventManagerExceptionNoHandler &e) {
-                    throw EventManagerExceptionNoHandler("Can't remove event");
+            /**
+             * @brief Mark events of the current frame as consumed
+             * @param aIndexes The indexes of the events to consume.
+             * @tparam Event The type of the event.
+             */
+            template<EventConcept Event>
+            void consumeEvents(std::span<const std::size_t> aIndexes)
+            {
+                if (auto *handler = findHandler<Event>()) {
+                    for (const auto idx : aIndexes) {
+                        handler->consume(idx);
+                    }
                 }
             }
 
             /**
-             * @brief Remove an event from the queue
-             * @param aIndexes The indexes of the event to remove.
+             * @brief Check if an event of the current frame was consumed
              * @tparam Event The type of the event.
-             *
              */
             template<EventConcept Event>
-            void removeEvent(std::vector<size_t> aIndexes)
+            [[nodiscard]] bool isEventConsumed(const std::size_t aIndex) const
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                auto eventIndex = std::type_index(typeid(Event));
+                const auto *handler = findHandler<Event>();
 
-                if (_eventsHandler.find(eventIndex) == _eventsHandler.end()) {
-                    return;
-                }
-                try {
-                    auto &handler = getHandler<Event>();
+                return handler != nullptr && handler->isConsumed(aIndex);
+            }
 
-                    for (size_t i = 0; i < aIndexes.size(); i++) {
-                        size_t idx = aIndexes[i] - i;
+            /**
+             * @brief Call a function for each event of the type pushed from now on, until unsubscribed
+             * @details The handler of the event is initialized if needed. The callable is stored with its type, the
+             * dispatch doesn't go through std::function. Must not run concurrently with pushes or swaps of the type
+             * @tparam Event The type of the event.
+             * @param aFunc Callable as func(const Event &)
+             * @param aPriority The subscribers with the highest priority are called first
+             * @param aMode Immediate to be called by pushEvent on the pushing thread, OnSwap to be called by
+             * swapBuffers for each event of the new frame
+             * @return SubscriptionHandle The handle to give to unsubscribe
+             */
+            template<EventConcept Event, typename Func>
+                requires std::is_invocable_v<std::decay_t<Func> &, const Event &>
+            SubscriptionHandle subscribe(Func &&aFunc, int aPriority = 0, DispatchMode aMode = DispatchMode::OnSwap)
+            {
+                initEventHandler<Event>();
 
-                        handler.removeEvent(idx);
-                    }
-                } catch (const EventManagerExceptionNoHandler &e) {
-                    throw EventManagerExceptionNoHandler("Can't remove event");
+                const auto [slot, generation] = getHandler<Event>().subscribe(std::forward<Func>(aFunc), aPriority,
+                                                                              aMode);
+
+                return SubscriptionHandle {Core::TypeId<EventFamily>::get<Event>(), slot, generation};
+            }
+
+            /**
+             * @brief End a subscription in O(1), nothing happens if it already ended
+             * @details May be called from an OnSwap callback, not from an Immediate one: those run on the pushing
+             * threads, concurrently with the other pushes
+             * @throw EventHandlerExceptionImmediateUnsubscribe If an Immediate subscriber of the type is being called
+             *
+             * @param aHandle The handle returned by subscribe
+             */
+            void unsubscribe(const SubscriptionHandle &aHandle)
+            {
+                if (aHandle.typeId >= maxEventTypes) {
+                    return;
+                }
+                if (auto *handler = _handlerTable[aHandle.typeId].load(std::memory_order_acquire)) {
+                    handler->unsubscribe(aHandle.slot, aHandle.generation);
                 }
             }
 
@@ -190,12 +267,19 @@ namespace Engine::Event {
             void initEventHandler()
             {
                 std::lock_guard<std::mutex> lock(_mutex);
-                auto eventTypeIndex = std::type_index(typeid(Event));
 
-                if (_eventsHandler.find(eventTypeIndex) != _eventsHandler.end()) {
+                const auto typeId = Core::TypeId<EventFamily>::get<Event>();
+
+                if (_eventsHandler.template find<Event>() != eventHandlers::npos) {
                     return;
                 }
-                _eventsHandler[eventTypeIndex] = std::make_unique<EventHandler<Event>>();
+                if (typeId >= maxEventTypes) {
+                    throw EventManagerExceptionTooManyEvents("Too many event types");
+                }
+                const auto eventId =
+                    _eventsHandler.template insert<Event>(std::make_unique<EventHandler<Event>>(&_arena));
+
+                _handlerTable[typeId].store(_eventsHandler[eventId].get(), std::memory_order_release);
             }
 
             template<EventConcept... EventList>
@@ -204,6 +288,14 @@ namespace Engine::Event {
                 (initEventHandler<EventList>(), ...);
             }
 
+            /**
+             * @brief Get the arena of the queued events
+             */
+            [[nodiscard]] Core::FrameArena &getArena() noexcept
+            {
+                return _arena;
+            }
+
         private:
             /**
              * @brief Get an Hander linked to an event
@@ -214,15 +306,28 @@ namespace Engine::Event {
             template<EventConcept Event>
             EventHandler<Event> &getHandler()
             {
-                auto eventTypeIndex = std::type_index(typeid(Event));
+                auto *handler = findHandler<Event>();
 
-                if (_eventsHandler.find(eventTypeIndex) == _eventsHandler.cend()) {
+                if (handler == nullptr) {
                     throw EventManagerExceptionNoHandler("There is no handler of this type");
                 }
-                auto &handler = _eventsHandler.at(eventTypeIndex);
-                auto &component = static_cast<EventHandler<Event> &>(*handler);
+                return *handler;
+            }
+
+            /**
+             * @brief Find the handler of an event without locking
+             *
+             * @return EventHandler<Event>* The handler, nullptr if the event has no handler
+             */
+            template<EventConcept Event>
+            EventHandler<Event> *findHandler() const
+            {
+                const auto typeId = Core::TypeId<EventFamily>::get<Event>();
 
-                return component;
+                if (typeId >= maxEventTypes) {
+                    return nullptr;
+                }
+                return static_cast<EventHandler<Event> *>(_handlerTable[typeId].load(std::memory_order_acquire));
             }
     };
 } // namespace Engine::Event
@@ -0,0 +1,44 @@
+#ifndef FRAMETIME_HPP_
+#define FRAMETIME_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine::Core {
+    /**
+     * @brief The timing of the frame a World is stepping, shared by all its systems
+     * @details The Fixed stage runs zero or more times per frame with the fixed timestep as delta time, the Variable
+     * stage runs once per frame with the frame time. Variable systems interpolate between the last two fixed states
+     * with alpha
+     */
+    struct FrameTime
+    {
+        public:
+            /**
+             * @brief The time step of the running stage, in seconds
+             */
+            double deltaTime = 0;
+            /**
+             * @brief The time elapsed since the last frame, in seconds
+             */
+            double frameDeltaTime = 0;
+            /**
+             * @brief The simulated time, advanced by each fixed step, in seconds
+             */
+            double time = 0;
+            /**
+             * @brief How far the frame is between the last fixed step and the next one, in [0, 1)
+             */
+            double alpha = 0;
+            /**
+             * @brief The number of the frame, counted by step and runSystems
+             */
+            std::uint64_t frame = 0;
+            /**
+             * @brief The number of fixed steps run by the frame
+             */
+            std::size_t fixedSteps = 0;
+    };
+} // namespace Engine::Core
+
+#endif /* !FRAMETIME_HPP_ */
@@ -0,0 +1,193 @@
+#ifndef JOBSYSTEM_HPP_
+#define JOBSYSTEM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine::Core {
+    /**
+     * @brief Count the jobs of a group that are not finished yet, JobSystem::wait blocks until it reaches 0
+     * @details The first exception thrown by a job of the group is kept and rethrown by JobSystem::wait
+     */
+    class JobCounter final
+    {
+        private:
+            std::atomic<std::size_t> _pending {0};
+            std::mutex _mutex;
+            std::exception_ptr _exception;
+
+            friend class JobSystem;
+
+        public:
+#pragma region constructors / destructors
+            JobCounter() = default;
+            ~JobCounter() = default;
+
+            JobCounter(const JobCounter &other) = delete;
+            JobCounter &operator=(const JobCounter &other) = delete;
+
+            JobCounter(JobCounter &&other) noexcept = delete;
+            JobCounter &operator=(JobCounter &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+            /**
+             * @brief Check if all the jobs of the group are finished
+             */
+            [[nodiscard]] bool done() const
+            {
+                return _pending.load(std::memory_order_acquire) == 0;
+            }
+    };
+
+    /**
+     * @brief The engine thread pool, every parallel feature of the engine submits its jobs here
+     * @details Each worker owns a queue: it pops its own jobs LIFO and steals the oldest jobs of the other workers
+     * when it runs dry. Jobs submitted from outside the pool go to a shared queue. A thread waiting for a group of
+     * jobs runs jobs too, so waiting from inside a job doesn't deadlock. Jobs submitted with submitTo are pinned to a
+     * worker and never stolen
+     */
+    class JobSystem final
+    {
+        public:
+            using job = std::function<void()>;
+
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        private:
+            struct Queue
+            {
+                    std::mutex mutex;
+                    std::deque<job> jobs;
+                    std::deque<job> pinned;
+                    std::atomic<std::size_t> pinnedCount {0};
+            };
+
+            std::size_t _workerCount;
+            std::vector<std::unique_ptr<Queue>> _queues;
+            std::vector<std::thread> _threads;
+            std::atomic<bool> _running {true};
+            std::atomic<std::size_t> _queued {0};
+            std::mutex _sleepMutex;
+            std::condition_variable _wakeUp;
+
+        public:
+#pragma region constructors / destructors
+            /**
+             * @brief Construct a new Job System and start its workers
+             *
+             * @param aThreadCount The number of workers, at least 1
+             */
+            explicit JobSystem(std::size_t aThreadCount = std::max(1U, std::thread::hardware_concurrency()));
+
+            /**
+             * @brief Wait for the running jobs then join the workers, the jobs still queued are dropped
+             */
+            ~JobSystem();
+
+            JobSystem(const JobSystem &other) = delete;
+            JobSystem &operator=(const JobSystem &other) = delete;
+
+            JobSystem(JobSystem &&other) noexcept = delete;
+            JobSystem &operator=(JobSystem &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            /**
+             * @brief Get the engine job system, sized after the hardware concurrency
+             *
+             * @return JobSystem& The job system shared by the engine
+             */
+            static JobSystem &getInstance();
+
+            /**
+             * @brief Get the number of workers
+             */
+            [[nodiscard]] std::size_t getThreadCount() const;
+
+            /**
+             * @brief Get the index of the calling worker
+             *
+             * @return std::size_t The index of the worker, npos if the caller isn't a worker of this job system
+             */
+            [[nodiscard]] std::size_t getCurrentWorker() const;
+
+            /**
+             * @brief Queue a job, on the queue of the calling worker or on the shared queue
+             *
+             * @param aJob The job to run
+             * @param aCounter The group of the job
+             */
+            void submit(job aJob, JobCounter &aCounter);
+
+            /**
+             * @brief Queue a job that only the given worker may run
+             *
+             * @param aWorker The worker, modulo the number of workers
+             * @param aJob The job to run
+             * @param aCounter The group of the job
+             */
+            void submitTo(std::size_t aWorker, job aJob, JobCounter &aCounter);
+
+            /**
+             * @brief Run jobs until all the jobs of the group are finished
+             * @throw Rethrows the first exception thrown by a job of the group
+             * @param aCounter The group to wait for
+             */
+            void wait(JobCounter &aCounter);
+
+            /**
+             * @brief Split a range in batches, run them on the workers and wait for all of them
+             *
+             * @param aBegin The first index of the range
+             * @param aEnd The end of the range (excluded)
+             * @param aBatchSize The number of indexes per job, 0 to get about four batches per worker
+             * @param aFunc Callable as func(batchBegin, batchEnd), called concurrently
+             */
+            template<typename Func>
+            void parallelFor(std::size_t aBegin, std::size_t aEnd, std::size_t aBatchSize, Func &&aFunc)
+            {
+                if (aBegin >= aEnd) {
+                    return;
+                }
+                if (aBatchSize == 0) {
+                    aBatchSize = std::max<std::size_t>(1, (aEnd - aBegin) / (getThreadCount() * 4));
+                }
+                if (aEnd - aBegin <= aBatchSize) {
+                    aFunc(aBegin, aEnd);
+                    return;
+                }
+
+                JobCounter counter;
+
+                for (auto batch = aBegin; batch < aEnd; batch += aBatchSize) {
+                    const auto batchEnd = std::min(aEnd, batch + aBatchSize);
+
+                    submit(
+                        [&aFunc, batch, batchEnd] {
+                            aFunc(batch, batchEnd);
+                        },
+                        counter);
+                }
+                wait(counter);
+            }
+
+        private:
+            void workerLoop(std::size_t aWorker);
+            bool runOne(std::size_t aWorker);
+            bool popFrom(Queue &aQueue, bool aOwner, bool aPinned, job &aJob);
+            void push(Queue &aQueue, job aJob, JobCounter &aCounter, bool aPinned);
+#pragma endregion methods
+    };
+} // namespace Engine::Core
+
+#endif /* !JOBSYSTEM_HPP_ */
@@ -0,0 +1,86 @@
+#ifndef FRAMEARENA_HPP_
+#define FRAMEARENA_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace Engine::Core {
+    /**
+     * @brief A monotonic memory resource for the allocations living one frame, like the events pushed in a frame
+     * @details Allocating bumps an atomic offset in the current block, any number of threads may allocate at once.
+     * Deallocating does nothing, the memory is reclaimed as a whole by nextFrame. The arena has two halves used on
+     * alternate frames: nextFrame reuses the half of the frame before the previous one, so the memory allocated during
+     * a frame stays valid until the end of the next frame. The blocks are kept, a warm arena doesn't allocate
+     */
+    class FrameArena final : public std::pmr::memory_resource
+    {
+        public:
+            static constexpr std::size_t blockSize = 256 * 1024;
+
+        private:
+            struct Block
+            {
+                    std::unique_ptr<std::byte[]> data;
+                    std::size_t size;
+                    std::atomic<std::size_t> used {0};
+            };
+
+            struct Half
+            {
+                    std::vector<std::unique_ptr<Block>> blocks;
+                    std::size_t currentBlock = 0;
+                    std::atomic<Block *> current {nullptr};
+            };
+
+            std::array<Half, 2> _halves;
+            std::atomic<std::size_t> _active {0};
+            std::mutex _mutex;
+
+        public:
+#pragma region constructors / destructors
+            FrameArena() = default;
+            ~FrameArena() override = default;
+
+            FrameArena(const FrameArena &other) = delete;
+            FrameArena &operator=(const FrameArena &other) = delete;
+
+            FrameArena(FrameArena &&other) noexcept = delete;
+            FrameArena &operator=(FrameArena &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            /**
+             * @brief Start a new frame, the memory allocated two frames ago is reused
+             * @details Must not run while another thread allocates memory of the frame before the previous one
+             */
+            void nextFrame();
+
+            /**
+             * @brief Get the number of bytes reserved by the blocks of the arena
+             */
+            [[nodiscard]] std::size_t capacity();
+#pragma endregion methods
+
+        private:
+            void *do_allocate(std::size_t aSize, std::size_t aAlignment) override;
+
+            void do_deallocate(void * /*pointer*/, std::size_t /*size*/, std::size_t /*alignment*/) override {}
+
+            [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &aOther) const noexcept override
+            {
+                return this == &aOther;
+            }
+
+            /**
+             * @brief Move the half to a block with room for an allocation, taken when its current block is full
+             */
+            void nextBlock(Half &aHalf, Block *aFull, std::size_t aSize);
+    };
+} // namespace Engine::Core
+
+#endif /* !FRAMEARENA_HPP_ */
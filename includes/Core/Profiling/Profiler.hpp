@@ -0,0 +1,263 @@
+#ifndef PROFILER_HPP_
+#define PROFILER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Exception.hpp"
+
+/**
+ * @brief Build the profiling instrumentation of the engine, 0 compiles every STELLAR_PROFILE_* macro to nothing
+ */
+#ifndef STELLAR_PROFILING
+    #define STELLAR_PROFILING 1
+#endif
+
+namespace Engine::Core {
+    DEFINE_EXCEPTION(ProfilerException);
+
+    /**
+     * @brief A profiled scope: a system update or a World step
+     */
+    struct ProfileSample
+    {
+        public:
+            std::uint32_t name = 0;
+            std::uint32_t thread = 0;
+            std::uint64_t frame = 0;
+            /**
+             * @brief The start of the scope, in nanoseconds since the creation of the profiler
+             */
+            std::int64_t start = 0;
+            /**
+             * @brief The wall time of the scope, in nanoseconds
+             */
+            std::int64_t duration = 0;
+            /**
+             * @brief The entities visited by the queries the scope ran on its thread, forEachParallel counts for
+             * the thread calling it
+             */
+            std::size_t entities = 0;
+    };
+
+    /**
+     * @brief The statistics of a scope over the samples still in the rings, the times are in seconds
+     */
+    struct ProfileStats
+    {
+        public:
+            std::size_t calls = 0;
+            std::size_t frames = 0;
+            double minTime = 0;
+            double averageTime = 0;
+            double p99Time = 0;
+            double maxTime = 0;
+            double entitiesPerCall = 0;
+            double callsPerFrame = 0;
+    };
+
+    /**
+     * @brief Record the time spent in the systems of the worlds
+     * @details Each thread records its samples in its own ring of ringCapacity samples, without locking: the rings
+     * keep the most recent samples, the statistics roll with them. Reading the samples (getSamples, getStats,
+     * writeChromeTrace, clear) must not run while profiled code runs, like between two steps. The profiler is off at
+     * runtime until setEnabled(true), a profiled scope then costs one branch; building with STELLAR_PROFILING=0 removes
+     * the instrumentation
+     */
+    class Profiler final
+    {
+        public:
+            using nameId = std::uint32_t;
+
+            static constexpr std::size_t ringCapacity = 4096;
+
+        private:
+            struct Ring
+            {
+                    std::unique_ptr<ProfileSample[]> samples = std::make_unique<ProfileSample[]>(ringCapacity);
+                    std::atomic<std::uint64_t> head {0};
+                    std::uint32_t thread = 0;
+            };
+
+            static inline std::atomic<bool> _enabled {false};
+            static inline thread_local std::size_t _entities = 0;
+
+            mutable std::mutex _mutex;
+            std::vector<std::string> _names;
+            std::vector<std::shared_ptr<Ring>> _rings;
+            std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+
+            friend class ProfileScope;
+
+            Profiler() = default;
+
+        public:
+#pragma region constructors / destructors
+            ~Profiler() = default;
+
+            Profiler(const Profiler &other) = delete;
+            Profiler &operator=(const Profiler &other) = delete;
+
+            Profiler(Profiler &&other) noexcept = delete;
+            Profiler &operator=(Profiler &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            /**
+             * @brief Get the profiler of the process
+             */
+            static Profiler &getInstance();
+
+            /**
+             * @brief Start or stop recording
+             */
+            static void setEnabled(bool aEnabled) noexcept
+            {
+                _enabled.store(aEnabled, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]] static bool isEnabled() noexcept
+            {
+                return _enabled.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Count entities visited by the current scope of the calling thread
+             *
+             * @param aCount The number of entities
+             */
+            static void countEntities(std::size_t aCount) noexcept
+            {
+                _entities += aCount;
+            }
+
+            /**
+             * @brief Get the id of a scope name, the same name always gets the same id
+             * @details Locks, meant to be called when setting up the scopes and not in the profiled code
+             * @param aName The name
+             * @return nameId The id of the name
+             */
+            nameId intern(std::string_view aName);
+
+            /**
+             * @brief Get the name of an id returned by intern
+             */
+            [[nodiscard]] std::string getName(nameId aName) const;
+
+            /**
+             * @brief Record a sample in the ring of the calling thread
+             *
+             * @param aSample The sample, its thread is set by the profiler
+             */
+            void record(ProfileSample aSample);
+
+            /**
+             * @brief Get the time since the creation of the profiler, in nanoseconds
+             */
+            [[nodiscard]] std::int64_t now() const noexcept
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch)
+                    .count();
+            }
+
+            /**
+             * @brief Get the samples still in the rings, ordered by start time
+             */
+            [[nodiscard]] std::vector<ProfileSample> getSamples() const;
+
+            /**
+             * @brief Get the statistics of a scope
+             *
+             * @param aName The name of the scope
+             * @return ProfileStats The statistics, empty if the scope has no sample
+             */
+            [[nodiscard]] ProfileStats getStats(std::string_view aName) const;
+
+            /**
+             * @brief Write the samples as Chrome trace events, to load in chrome://tracing or Perfetto
+             *
+             * @param aStream The stream to write the JSON to
+             */
+            void writeChromeTrace(std::ostream &aStream) const;
+
+            /**
+             * @brief Write the samples as Chrome trace events to a file
+             * @throw ProfilerException If the file can't be written
+             * @param aPath The path of the file
+             */
+            void writeChromeTrace(const std::filesystem::path &aPath) const;
+
+            /**
+             * @brief Drop every sample, the names are kept
+             */
+            void clear();
+#pragma endregion methods
+
+        private:
+            Ring &getRing();
+    };
+
+    /**
+     * @brief Record the time spent in a scope, and the entities its queries visit, if the profiler is enabled
+     */
+    class ProfileScope final
+    {
+        private:
+            bool _active;
+            Profiler::nameId _name;
+            std::uint64_t _frame;
+            std::int64_t _start = 0;
+            std::size_t _outerEntities = 0;
+
+        public:
+#pragma region constructors / destructors
+            ProfileScope(Profiler::nameId aName, std::uint64_t aFrame)
+                : _active(Profiler::isEnabled()),
+                  _name(aName),
+                  _frame(aFrame)
+            {
+                if (_active) {
+                    _outerEntities = std::exchange(Profiler::_entities, 0);
+                    _start = Profiler::getInstance().now();
+                }
+            }
+
+            ~ProfileScope()
+            {
+                if (_active) {
+                    auto &profiler = Profiler::getInstance();
+                    const auto entities = Profiler::_entities;
+
+                    // The entities visited by a nested scope count for the enclosing one too
+                    Profiler::_entities = _outerEntities + entities;
+                    profiler.record(ProfileSample {_name, 0, _frame, _start, profiler.now() - _start, entities});
+                }
+            }
+
+            ProfileScope(const ProfileScope &other) = delete;
+            ProfileScope &operator=(const ProfileScope &other) = delete;
+
+            ProfileScope(ProfileScope &&other) noexcept = delete;
+            ProfileScope &operator=(ProfileScope &&other) noexcept = delete;
+#pragma endregion constructors / destructors
+    };
+} // namespace Engine::Core
+
+#if STELLAR_PROFILING
+    #define STELLAR_PROFILE_SCOPE(name, frame) const ::Engine::Core::ProfileScope stellarProfileScope((name), (frame))
+    #define STELLAR_PROFILE_ENTITIES(count) ::Engine::Core::Profiler::countEntities(count)
+#else
+    #define STELLAR_PROFILE_SCOPE(name, frame) static_cast<void>(0)
+    #define STELLAR_PROFILE_ENTITIES(count) static_cast<void>(count)
+#endif
+
+#endif /* !PROFILER_HPP_ */
@@ -0,0 +1,40 @@
+#ifndef QUERYCALLBACK_HPP_
+#define QUERYCALLBACK_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Engine::Core {
+    /**
+     * @brief The signatures accepted by the forEach of the queries, from the most to the least complete:
+     * - func(world, deltaTime, idx, components...)
+     * - func(idx, components...)
+     * - func(components...)
+     *
+     * The components are passed as lvalues of Args, the types the storages give for them (see World::QueryArg)
+     */
+    template<typename Func, typename WorldT, typename Id, typename... Args>
+    concept QueryCallback = std::is_invocable_v<Func &, WorldT &, double, Id, Args &...>
+                            || std::is_invocable_v<Func &, Id, Args &...>
+                            || std::is_invocable_v<Func &, Args &...>;
+
+    /**
+     * @brief Call a query callback with the arguments its signature asks for
+     * @details Resolved at compile time, the callback is called directly and can be inlined
+     */
+    template<typename WorldT, typename Id, typename... Components, typename Func>
+    inline void invokeQueryCallback(Func &aFunc, WorldT &aWorld, double aDeltaTime, Id aIdx,
+                                    Components &...aComponents)
+    {
+        if constexpr (std::is_invocable_v<Func &, WorldT &, double, Id, Components &...>) {
+            aFunc(aWorld, aDeltaTime, aIdx, aComponents...);
+        } else if constexpr (std::is_invocable_v<Func &, Id, Components &...>) {
+            aFunc(aIdx, aComponents...);
+        } else {
+            aFunc(aComponents...);
+        }
+    }
+} // namespace Engine::Core
+
+#endif /* !QUERYCALLBACK_HPP_ */
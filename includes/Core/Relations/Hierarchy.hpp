@@ -0,0 +1,172 @@
+#ifndef HIERARCHY_HPP_
+#define HIERARCHY_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include "Core/Components/Component.hpp"
+#include "Core/Components/ComponentStorage.hpp"
+#include "Core/Entity.hpp"
+#include "Exception.hpp"
+
+namespace Engine::Core {
+    DEFINE_EXCEPTION(HierarchyException);
+    DEFINE_EXCEPTION_FROM(HierarchyExceptionCycle, HierarchyException);
+
+    /**
+     * @brief The relationship of an entity to its parent
+     * @details Adding or removing it through the World (addComponentToEntity, World::setParent, the commands...) keeps
+     * the Hierarchy of the World up to date. Writing the storage directly bypasses the Hierarchy. Few entities are
+     * children, so the component is packed: a query including it only visits the children
+     */
+    struct ChildOf : public Component
+    {
+        public:
+            using storageTag = PackedStorage;
+
+            ChildOf() = default;
+
+            explicit ChildOf(Entity aParent)
+                : parent(aParent)
+            {}
+
+            Entity parent;
+
+            static constexpr auto fields = std::make_tuple(&ChildOf::parent);
+            static constexpr std::string_view serialName = "ChildOf";
+    };
+
+    /**
+     * @brief The parent / children links of the entities of a World, sorted by depth
+     * @details The entities with a parent are kept in one dense array per depth, so the children of a level can be
+     * processed together (and concurrently) once their parents of the level above are done. The levels are updated
+     * incrementally: linking an entity moves it and its descendants to their new levels, removing an entity from a
+     * level moves the last one of the level in its slot (swap-and-pop), so the order inside a level is not stable.
+     * The roots (the entities without a parent) are in no level
+     */
+    class Hierarchy final
+    {
+        public:
+            using id = std::size_t;
+
+            static constexpr id npos = std::numeric_limits<id>::max();
+
+        private:
+            std::vector<id> _parents;
+            std::vector<std::size_t> _depths;
+            std::vector<std::size_t> _levelSlots;
+            std::vector<std::size_t> _childSlots;
+            std::vector<std::vector<id>> _children;
+            std::vector<std::vector<id>> _levels;
+
+        public:
+#pragma region methods
+            /**
+             * @brief Make an entity the child of another, moving it from its previous parent if it had one
+             * @throw HierarchyExceptionCycle If the parent is the entity or one of its descendants
+             *
+             * @param aChild The entity
+             * @param aParent The new parent of the entity
+             */
+            void setParent(id aChild, id aParent);
+
+            /**
+             * @brief Detach an entity from its parent, it becomes a root with its descendants under it
+             *
+             * @param aChild The entity, nothing happens if it has no parent
+             */
+            void removeParent(id aChild);
+
+            /**
+             * @brief Forget an entity: its children become roots, then it is detached from its parent
+             * @details Removing the descendants of an entity before it (deepest first) leaves no child to detach
+             *
+             * @param aEntity The entity
+             */
+            void remove(id aEntity);
+
+            /**
+             * @brief Append the descendants of an entity, breadth-first
+             *
+             * @param aEntity The entity
+             * @param aDescendants The vector the descendants are appended to
+             */
+            void collectDescendants(id aEntity, std::vector<id> &aDescendants) const;
+
+            /**
+             * @brief Remove every link
+             */
+            void clear();
+
+            /**
+             * @brief Get the parent of an entity
+             *
+             * @return id The index of the parent, npos for a root
+             */
+            [[nodiscard]] id getParent(id aEntity) const noexcept
+            {
+                return aEntity < _parents.size() ? _parents[aEntity] : npos;
+            }
+
+            /**
+             * @brief Get the children of an entity, in no particular order
+             */
+            [[nodiscard]] std::span<const id> getChildren(id aEntity) const noexcept
+            {
+                if (aEntity >= _children.size()) {
+                    return {};
+                }
+                return _children[aEntity];
+            }
+
+            /**
+             * @brief Get the depth of an entity, 0 for a root
+             */
+            [[nodiscard]] std::size_t getDepth(id aEntity) const noexcept
+            {
+                return aEntity < _depths.size() ? _depths[aEntity] : 0;
+            }
+
+            /**
+             * @brief Get the number of levels, the depth of the deepest entity
+             */
+            [[nodiscard]] std::size_t getLevelCount() const noexcept
+            {
+                return _levels.size();
+            }
+
+            /**
+             * @brief Get the entities at a depth
+             *
+             * @param aDepth The depth, from 1 (the children of the roots) to getLevelCount()
+             * @return std::span<const id> The entities of the level, in no particular order
+             */
+            [[nodiscard]] std::span<const id> getLevel(std::size_t aDepth) const noexcept
+            {
+                if (aDepth == 0 || aDepth > _levels.size()) {
+                    return {};
+                }
+                return _levels[aDepth - 1];
+            }
+#pragma endregion methods
+
+        private:
+            void grow(id aEntity);
+
+            /**
+             * @brief Move an entity and its descendants by some levels
+             */
+            void shiftSubtree(id aEntity, std::ptrdiff_t aShift);
+
+            void enterLevel(id aEntity, std::size_t aDepth);
+
+            void leaveLevel(id aEntity);
+
+            void unlink(id aChild);
+    };
+} // namespace Engine::Core
+
+#endif /* !HIERARCHY_HPP_ */
@@ -0,0 +1,73 @@
+#ifndef MAPPEDFILE_HPP_
+#define MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+#include "Snapshot.hpp"
+
+namespace Engine::Core {
+    DEFINE_EXCEPTION_FROM(SnapshotExceptionFile, SnapshotException);
+
+    /**
+     * @brief A private copy of a whole file, memory-mapped when the platform allows it
+     * @details The mapping is private and copy-on-write: the pages come straight from the page cache, so the
+     * processes loading the same snapshot share them and nothing is read before it is touched. Writing to a page
+     * copies it for this process only, the file is never modified. Where mmap isn't available the file is read in
+     * memory instead
+     */
+    class MappedFile final
+    {
+        private:
+            std::byte *_data = nullptr;
+            std::size_t _size = 0;
+            bool _mapped = false;
+            std::vector<std::byte> _fallback;
+
+        public:
+#pragma region constructors / destructors
+            /**
+             * @brief Map a file
+             * @throw SnapshotExceptionFile If the file can't be opened or read
+             * @param aPath The path of the file
+             */
+            explicit MappedFile(const std::filesystem::path &aPath);
+            ~MappedFile();
+
+            MappedFile(const MappedFile &other) = delete;
+            MappedFile &operator=(const MappedFile &other) = delete;
+
+            MappedFile(MappedFile &&other) noexcept;
+            MappedFile &operator=(MappedFile &&other) noexcept;
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            [[nodiscard]] std::span<const std::byte> getData() const noexcept
+            {
+                return {_data, _size};
+            }
+
+            /**
+             * @brief Get the data to write to, the writes stay in this process and copy the pages they touch
+             */
+            [[nodiscard]] std::span<std::byte> getMutableData() noexcept
+            {
+                return {_data, _size};
+            }
+
+            /**
+             * @brief Check if the file is memory-mapped, false if it was read in memory
+             */
+            [[nodiscard]] bool isMapped() const noexcept
+            {
+                return _mapped;
+            }
+#pragma endregion methods
+
+        private:
+            void unmap() noexcept;
+    };
+} // namespace Engine::Core
+
+#endif /* !MAPPEDFILE_HPP_ */
@@ -0,0 +1,484 @@
+#ifndef SNAPSHOT_HPP_
+#define SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "Exception.hpp"
+
+namespace Engine::Core {
+    DEFINE_EXCEPTION(SnapshotException);
+    DEFINE_EXCEPTION_FROM(SnapshotExceptionVersion, SnapshotException);
+    DEFINE_EXCEPTION_FROM(SnapshotExceptionCorrupted, SnapshotException);
+    DEFINE_EXCEPTION_FROM(SnapshotExceptionMismatch, SnapshotException);
+
+    /**
+     * @brief "STLS", the first bytes of a snapshot
+     */
+    inline constexpr std::uint32_t snapshotMagic = 0x534C5453;
+    inline constexpr std::uint32_t snapshotVersion = 2;
+    /**
+     * @brief The alignment of the columns from the start of the snapshot, a cache line
+     */
+    inline constexpr std::size_t snapshotAlignment = 64;
+
+    /**
+     * @brief How the columns of the block of a component are laid out
+     */
+    enum class ColumnLayout : std::uint32_t
+    {
+        /**
+         * @brief The values of the entities having the component, in entity order
+         */
+        Packed,
+        /**
+         * @brief One value per entity index, zero for the entities without the component, padded to indexedSlots
+         * values: the layout of the columns of a ColumnArray, which can adopt them as they are
+         */
+        Indexed,
+    };
+
+    /**
+     * @brief Get the number of values of an Indexed column, the entity count rounded up to snapshotAlignment
+     */
+    constexpr std::size_t indexedSlots(std::size_t aEntityCount) noexcept
+    {
+        return (aEntityCount + snapshotAlignment - 1) / snapshotAlignment * snapshotAlignment;
+    }
+
+    /**
+     * @brief How World::restore treats the component types that the snapshot and the World don't share
+     */
+    enum class RestorePolicy
+    {
+        /**
+         * @brief The blocks of the types that aren't registered are skipped with a warning, the registered types
+         * missing from the snapshot end up empty
+         */
+        Lenient,
+        /**
+         * @brief A block of a type that isn't registered, or a registered serializable type without a block, throws
+         * SnapshotExceptionMismatch before the World is touched
+         */
+        Strict,
+    };
+
+    /**
+     * @brief Append binary data to a growing buffer
+     */
+    class SnapshotWriter final
+    {
+        private:
+            std::vector<std::byte> _buffer;
+
+        public:
+            /**
+             * @brief Append raw bytes
+             */
+            void write(const void *aData, std::size_t aSize);
+
+            /**
+             * @brief Append the bytes of a value
+             */
+            template<typename T>
+                requires std::is_trivially_copyable_v<T>
+            void write(const T &aValue)
+            {
+                write(&aValue, sizeof(T));
+            }
+
+            /**
+             * @brief Grow the buffer by some bytes to fill in place
+             *
+             * @return std::byte* The new bytes, valid until the next write
+             */
+            std::byte *grow(std::size_t aSize);
+
+            /**
+             * @brief Pad with zeros up to the next multiple of snapshotAlignment
+             */
+            void align();
+
+            /**
+             * @brief Overwrite a value written before, like a size only known once its block is written
+             */
+            template<typename T>
+                requires std::is_trivially_copyable_v<T>
+            void patch(std::size_t aOffset, const T &aValue)
+            {
+                std::memcpy(_buffer.data() + aOffset, &aValue, sizeof(T));
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return _buffer.size();
+            }
+
+            [[nodiscard]] std::vector<std::byte> &getBuffer() noexcept
+            {
+                return _buffer;
+            }
+    };
+
+    /**
+     * @brief Read binary data written by a SnapshotWriter, every read is bounds checked
+     */
+    class SnapshotReader final
+    {
+        private:
+            std::span<const std::byte> _data;
+            std::byte *_writable = nullptr;
+            std::shared_ptr<void> _backing;
+            std::size_t _offset = 0;
+
+        public:
+            explicit SnapshotReader(std::span<const std::byte> aData)
+                : _data(aData)
+            {}
+
+            /**
+             * @brief Read writable data owned by a backing, like a private mapping of the snapshot file, so the
+             * storages can adopt the bytes they read instead of copying them (see adopt)
+             *
+             * @param aData The data, writable as long as the backing is alive
+             * @param aBacking The owner of the data
+             */
+            SnapshotReader(std::span<std::byte> aData, std::shared_ptr<void> aBacking)
+                : _data(aData),
+                  _writable(aData.data()),
+                  _backing(std::move(aBacking))
+            {}
+
+            /**
+             * @brief Read raw bytes
+             * @throw SnapshotExceptionCorrupted If the snapshot is too short
+             */
+            std::span<const std::byte> read(std::size_t aSize);
+
+            /**
+             * @brief Read a value
+             * @throw SnapshotExceptionCorrupted If the snapshot is too short
+             */
+            template<typename T>
+                requires std::is_trivially_copyable_v<T>
+            T read()
+            {
+                T value;
+
+                std::memcpy(&value, read(sizeof(T)).data(), sizeof(T));
+                return value;
+            }
+
+            /**
+             * @brief Skip the padding up to the next multiple of snapshotAlignment
+             */
+            void align();
+
+            /**
+             * @brief Move to an offset from the start of the snapshot
+             * @throw SnapshotExceptionCorrupted If the offset is past the end
+             */
+            void seek(std::size_t aOffset);
+
+            [[nodiscard]] std::size_t offset() const noexcept
+            {
+                return _offset;
+            }
+
+            [[nodiscard]] std::span<const std::byte> getData() const noexcept
+            {
+                return _data;
+            }
+
+            /**
+             * @brief Get writable access to bytes read before, to keep them instead of copying them
+             *
+             * @param aBytes Bytes returned by read
+             * @return std::byte* The first byte, nullptr if the data has no backing
+             */
+            [[nodiscard]] std::byte *adopt(std::span<const std::byte> aBytes) const noexcept
+            {
+                return _writable == nullptr ? nullptr : _writable + (aBytes.data() - _data.data());
+            }
+
+            /**
+             * @brief Get the owner of the data, to keep alive while adopted bytes are used
+             */
+            [[nodiscard]] const std::shared_ptr<void> &getBacking() const noexcept
+            {
+                return _backing;
+            }
+    };
+
+    /**
+     * @brief Get the name of a type as spelled by the compiler, see normalizeTypeName
+     */
+    template<typename T>
+    constexpr std::string_view typeName()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        constexpr std::string_view function = __FUNCSIG__;
+        constexpr std::string_view prefix = "typeName<";
+        constexpr auto start = function.find(prefix) + prefix.size();
+        constexpr auto end = function.rfind(">(void)");
+#else
+        constexpr std::string_view function = __PRETTY_FUNCTION__;
+        constexpr std::string_view prefix = "T = ";
+        constexpr auto start = function.find(prefix) + prefix.size();
+        constexpr auto end = function.find_first_of(";]", start);
+#endif
+
+        return function.substr(start, end - start);
+    }
+
+    /**
+     * @brief Spell a type name the same way whatever the compiler: the struct / class / enum / union keywords of MSVC
+     * are dropped, the anonymous namespaces are written (anonymous) and the spaces are only kept between two words
+     * @details The builtin types in template arguments may still be spelled differently (unsigned __int64 against
+     * unsigned long), a serialName member avoids the problem for such components
+     *
+     * @param aName The name given by typeName
+     * @return std::string The name written in the snapshots
+     */
+    std::string normalizeTypeName(std::string_view aName);
+
+    /**
+     * @brief Write and read a component type in snapshots
+     * @details A component is serialized by listing the members to save, they must be trivially copyable:
+     * @code
+     * struct Position : public Engine::Component
+     * {
+     *         float x = 0;
+     *         float y = 0;
+     *
+     *         static constexpr auto fields = std::make_tuple(&Position::x, &Position::y);
+     * };
+     * @endcode
+     * Each field is written as a packed column, so the layout of the component doesn't matter. The fields of the
+     * components of a SparseArray or a PackedArray are interleaved, their values are gathered one by one, while a
+     * ColumnArray copies its columns in bulk (see ColumnArray::serialize). The trait can also be specialized with the
+     * same static write / read functions. The components are named by their normalized type name (see
+     * normalizeTypeName), a static serialName member keeps the snapshots readable after renaming the type
+     *
+     * @tparam Component The type of the component
+     */
+    template<typename Component>
+    struct ComponentSerializer
+    {};
+
+    template<typename Component>
+        requires requires { Component::fields; }
+    struct ComponentSerializer<Component>
+    {
+            /**
+             * @brief Write the fields of the components as one column per field
+             *
+             * @param aWriter The writer
+             * @param aComponents The components to write, in entity order
+             */
+            static void write(SnapshotWriter &aWriter, std::span<const Component *const> aComponents)
+            {
+                std::apply(
+                    [&aWriter, aComponents](auto... aFields) {
+                        (writeColumn(aWriter, aComponents, aFields), ...);
+                    },
+                    Component::fields);
+            }
+
+            /**
+             * @brief Read the columns written by write into the components
+             *
+             * @param aReader The reader
+             * @param aComponents The components to fill, in entity order
+             */
+            static void read(SnapshotReader &aReader, std::span<Component *const> aComponents)
+            {
+                std::apply(
+                    [&aReader, aComponents](auto... aFields) {
+                        (readColumn(aReader, aComponents, aFields), ...);
+                    },
+                    Component::fields);
+            }
+
+            /**
+             * @brief Read Indexed columns, written by a ColumnArray, into the components
+             *
+             * @param aReader The reader
+             * @param aComponents The components to fill, in entity order
+             * @param aIndexes The entity of each component
+             * @param aSlots The number of values of each column, see indexedSlots
+             */
+            static void readIndexed(SnapshotReader &aReader, std::span<Component *const> aComponents,
+                                    std::span<const std::size_t> aIndexes, std::size_t aSlots)
+            {
+                std::apply(
+                    [&aReader, aComponents, aIndexes, aSlots](auto... aFields) {
+                        (readIndexedColumn(aReader, aComponents, aIndexes, aSlots, aFields), ...);
+                    },
+                    Component::fields);
+            }
+
+        private:
+            template<typename Field, typename Owner>
+            static void writeColumn(SnapshotWriter &aWriter, std::span<const Component *const> aComponents,
+                                    Field Owner::*aField)
+            {
+                static_assert(std::is_trivially_copyable_v<Field>, "A serialized field must be trivially copyable");
+
+                aWriter.align();
+                auto *column = aWriter.grow(aComponents.size() * sizeof(Field));
+
+                for (const auto *component : aComponents) {
+                    std::memcpy(column, &(component->*aField), sizeof(Field));
+                    column += sizeof(Field);
+                }
+            }
+
+            template<typename Field, typename Owner>
+            static void readColumn(SnapshotReader &aReader, std::span<Component *const> aComponents,
+                                   Field Owner::*aField)
+            {
+                aReader.align();
+                const auto *column = aReader.read(aComponents.size() * sizeof(Field)).data();
+
+                for (auto *component : aComponents) {
+                    std::memcpy(&(component->*aField), column, sizeof(Field));
+                    column += sizeof(Field);
+                }
+            }
+
+            template<typename Field, typename Owner>
+            static void readIndexedColumn(SnapshotReader &aReader, std::span<Component *const> aComponents,
+                                          std::span<const std::size_t> aIndexes, std::size_t aSlots,
+                                          Field Owner::*aField)
+            {
+                aReader.align();
+                const auto *column = aReader.read(aSlots * sizeof(Field)).data();
+
+                for (std::size_t pos = 0; pos < aComponents.size(); pos++) {
+                    std::memcpy(&(aComponents[pos]->*aField), column + aIndexes[pos] * sizeof(Field), sizeof(Field));
+                }
+            }
+    };
+
+    /**
+     * @brief A component that can be written in snapshots, see ComponentSerializer
+     */
+    template<typename Component>
+    concept SerializableComponent =
+        std::is_default_constructible_v<Component>
+        && requires(SnapshotWriter &aWriter, SnapshotReader &aReader, std::span<const Component *const> aIn,
+                    std::span<Component *const> aOut) {
+               ComponentSerializer<Component>::write(aWriter, aIn);
+               ComponentSerializer<Component>::read(aReader, aOut);
+           };
+
+    /**
+     * @brief Get the name of a component in snapshots: its serialName member, or its normalized type name
+     */
+    template<typename Component>
+    std::string serialName()
+    {
+        if constexpr (requires { Component::serialName; }) {
+            return std::string(Component::serialName);
+        } else {
+            return normalizeTypeName(typeName<Component>());
+        }
+    }
+
+    /**
+     * @brief Write the components of a storage: their count, the Packed layout, the presence bitmap of the entities,
+     * then the columns
+     *
+     * @tparam Component The type of the components
+     * @param aStorage The storage, a SparseArray or a PackedArray
+     * @param aWriter The writer
+     * @param aEntityCount The number of entity indexes of the World
+     */
+    template<SerializableComponent Component, typename Storage>
+    void serializeStorage(const Storage &aStorage, SnapshotWriter &aWriter, std::size_t aEntityCount)
+    {
+        constexpr std::size_t bits = 64;
+        std::vector<std::uint64_t> presence((aEntityCount + bits - 1) / bits, 0);
+        std::vector<const Component *> components;
+
+        components.reserve(aStorage.count());
+        for (std::size_t idx = 0; idx < aEntityCount; idx++) {
+            if (aStorage.contains(idx)) {
+                presence[idx / bits] |= std::uint64_t(1) << (idx % bits);
+                components.push_back(&aStorage[idx]);
+            }
+        }
+        aWriter.write(static_cast<std::uint64_t>(components.size()));
+        aWriter.write(ColumnLayout::Packed);
+        aWriter.align();
+        aWriter.write(presence.data(), presence.size() * sizeof(std::uint64_t));
+        ComponentSerializer<Component>::write(aWriter, components);
+    }
+
+    /**
+     * @brief Read the components written by serializeStorage, or by a ColumnArray, into an empty storage
+     * @throw SnapshotExceptionCorrupted If the block is malformed
+     * @throw SnapshotExceptionMismatch If the columns are Indexed and the ComponentSerializer can't read them
+     *
+     * @tparam Component The type of the components
+     * @param aStorage The storage, a SparseArray or a PackedArray
+     * @param aReader The reader
+     * @param aEntityCount The number of entity indexes of the World
+     */
+    template<SerializableComponent Component, typename Storage>
+    void deserializeStorage(Storage &aStorage, SnapshotReader &aReader, std::size_t aEntityCount)
+    {
+        constexpr std::size_t bits = 64;
+        const auto count = aReader.read<std::uint64_t>();
+        const auto layout = aReader.read<ColumnLayout>();
+
+        aReader.align();
+        const auto presence = aReader.read((aEntityCount + bits - 1) / bits * sizeof(std::uint64_t));
+        std::vector<Component *> components;
+        std::vector<std::size_t> indexes;
+
+        if (count > aEntityCount) {
+            throw SnapshotExceptionCorrupted("More components than entities in the snapshot");
+        }
+        if (layout != ColumnLayout::Packed && layout != ColumnLayout::Indexed) {
+            throw SnapshotExceptionCorrupted("Unknown column layout");
+        }
+        // Every slot exists before the first emplace, so the pointers to the components stay valid
+        if (aEntityCount != 0) {
+            aStorage.init(aEntityCount - 1);
+        }
+        aStorage.reserve(count);
+        components.reserve(count);
+        indexes.reserve(count);
+        for (std::size_t idx = 0; idx < aEntityCount && components.size() < count; idx++) {
+            std::uint64_t word = 0;
+
+            std::memcpy(&word, presence.data() + idx / bits * sizeof(std::uint64_t), sizeof(std::uint64_t));
+            if ((word >> (idx % bits) & 1) != 0) {
+                components.push_back(&aStorage.emplace(idx));
+                indexes.push_back(idx);
+            }
+        }
+        if (components.size() != count) {
+            throw SnapshotExceptionCorrupted("The presence bitmap doesn't match the component count");
+        }
+        if (layout == ColumnLayout::Packed) {
+            ComponentSerializer<Component>::read(aReader, components);
+        } else if constexpr (requires { &ComponentSerializer<Component>::readIndexed; }) {
+            ComponentSerializer<Component>::readIndexed(aReader, components, indexes, indexedSlots(aEntityCount));
+        } else {
+            throw SnapshotExceptionMismatch("The serializer of " + serialName<Component>()
+                                            + " can't read the Indexed columns of a ColumnArray");
+        }
+    }
+} // namespace Engine::Core
+
+#endif /* !SNAPSHOT_HPP_ */
@@ -0,0 +1,94 @@
+#ifndef HASHGRID_HPP_
+#define HASHGRID_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "SpatialIndex.hpp"
+
+namespace Engine::Core {
+    /**
+     * @brief A uniform grid of square cells, only the cells holding entities exist (in a hash map)
+     * @details An entity is listed in every cell its bounds overlap, and found once by a query: in the first cell
+     * shared by its bounds and the query. An entity overlapping more than maxCellsPerEntity cells is kept in a list
+     * checked by every query instead. The grid suits entities of similar sizes, the cell size being about their size
+     * or the usual query radius
+     */
+    class HashGrid final : public ISpatialIndex
+    {
+        public:
+            static constexpr std::size_t maxCellsPerEntity = 16;
+
+        private:
+            struct CellRange
+            {
+                    std::int32_t minX;
+                    std::int32_t minY;
+                    std::int32_t maxX;
+                    std::int32_t maxY;
+
+                    [[nodiscard]] std::size_t count() const noexcept
+                    {
+                        return static_cast<std::size_t>(maxX - minX + 1) * static_cast<std::size_t>(maxY - minY + 1);
+                    }
+
+                    bool operator==(const CellRange &other) const = default;
+            };
+
+            float _cellSize;
+            std::unordered_map<std::uint64_t, std::vector<id>> _cells;
+            std::vector<CellRange> _ranges;
+            std::vector<id> _oversized;
+
+        public:
+#pragma region constructors / destructors
+            /**
+             * @brief Construct a new Hash Grid
+             * @throw SpatialException If the cell size isn't positive
+             *
+             * @param aCellSize The side of a cell
+             */
+            explicit HashGrid(float aCellSize = 16);
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            using ISpatialIndex::queryAABB;
+
+            void queryAABB(const Aabb &aBox, std::vector<id> &aEntities) const override;
+
+            [[nodiscard]] float getCellSize() const noexcept
+            {
+                return _cellSize;
+            }
+
+            /**
+             * @brief Get the number of cells holding entities
+             */
+            [[nodiscard]] std::size_t getCellCount() const noexcept
+            {
+                return _cells.size();
+            }
+#pragma endregion methods
+
+        protected:
+            void insertEntity(id aEntity) override;
+            void moveEntity(id aEntity, const Aabb &aPrevious) override;
+            void eraseEntity(id aEntity) override;
+            void clearEntities() override;
+
+        private:
+            [[nodiscard]] CellRange rangeOf(const Aabb &aBox) const noexcept;
+
+            static std::uint64_t key(std::int32_t aX, std::int32_t aY) noexcept
+            {
+                return static_cast<std::uint64_t>(static_cast<std::uint32_t>(aX)) << 32
+                       | static_cast<std::uint32_t>(aY);
+            }
+
+            void link(id aEntity, const CellRange &aRange);
+            void unlink(id aEntity, const CellRange &aRange);
+    };
+} // namespace Engine::Core
+
+#endif /* !HASHGRID_HPP_ */
@@ -0,0 +1,87 @@
+#ifndef LOOSEQUADTREE_HPP_
+#define LOOSEQUADTREE_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "SpatialIndex.hpp"
+
+namespace Engine::Core {
+    /**
+     * @brief A loose quadtree over a fixed area, stored as one dense grid of nodes per depth
+     * @details The nodes of depth d split the area in 2^d x 2^d cells, and hold the entities whose center is in the
+     * cell, up to twice the cell size (the loose bounds reach half a cell past the cell). An entity goes to the
+     * deepest node it fits in, so moving it only changes its node when it leaves the loose bounds of its cell, and a
+     * query only visits the nodes of each depth whose loose bounds overlap it. The entities out of the area, or
+     * bigger than it, are kept in a list checked by every query. The tree suits entities of mixed sizes
+     */
+    class LooseQuadtree final : public ISpatialIndex
+    {
+        public:
+            static constexpr std::size_t maxDepth = 10;
+            static constexpr std::size_t outside = std::numeric_limits<std::size_t>::max();
+
+        private:
+            struct Location
+            {
+                    std::size_t depth;
+                    std::size_t cell;
+                    std::size_t slot;
+            };
+
+            Aabb _area;
+            std::size_t _depth;
+            std::vector<std::vector<std::vector<id>>> _nodes;
+            std::vector<std::size_t> _depthCounts;
+            std::vector<Location> _locations;
+            std::vector<id> _outside;
+
+        public:
+#pragma region constructors / destructors
+            /**
+             * @brief Construct a new Loose Quadtree
+             * @throw SpatialException If the area is empty or the depth greater than maxDepth
+             *
+             * @param aArea The area covered by the tree
+             * @param aDepth The depth of the deepest nodes, 0 for a single node
+             */
+            explicit LooseQuadtree(const Aabb &aArea, std::size_t aDepth = 6);
+#pragma endregion constructors / destructors
+
+#pragma region methods
+            using ISpatialIndex::queryAABB;
+
+            void queryAABB(const Aabb &aBox, std::vector<id> &aEntities) const override;
+
+            [[nodiscard]] const Aabb &getArea() const noexcept
+            {
+                return _area;
+            }
+
+            /**
+             * @brief Get the depth of the node holding an indexed entity, outside for the ones out of the tree
+             */
+            [[nodiscard]] std::size_t getDepth(id aEntity) const
+            {
+                return _locations.at(aEntity).depth;
+            }
+#pragma endregion methods
+
+        protected:
+            void insertEntity(id aEntity) override;
+            void moveEntity(id aEntity, const Aabb &aPrevious) override;
+            void eraseEntity(id aEntity) override;
+            void clearEntities() override;
+
+        private:
+            /**
+             * @brief Find the node of some bounds
+             */
+            [[nodiscard]] Location locate(const Aabb &aBounds) const noexcept;
+
+            void link(id aEntity, Location aLocation);
+            void unlink(id aEntity);
+    };
+} // namespace Engine::Core
+
+#endif /* !LOOSEQUADTREE_HPP_ */
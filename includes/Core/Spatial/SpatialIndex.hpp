@@ -0,0 +1,231 @@
+#ifndef SPATIALINDEX_HPP_
+#define SPATIALINDEX_HPP_
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "Core/Jobs/JobSystem.hpp"
+#include "Exception.hpp"
+
+namespace Engine::Core {
+    DEFINE_EXCEPTION(SpatialException);
+
+    /**
+     * @brief An axis-aligned box, in the plane of the spatial indexes
+     */
+    struct Aabb
+    {
+        public:
+            float minX = 0;
+            float minY = 0;
+            float maxX = 0;
+            float maxY = 0;
+
+            [[nodiscard]] constexpr bool overlaps(const Aabb &aOther) const noexcept
+            {
+                return minX <= aOther.maxX && aOther.minX <= maxX && minY <= aOther.maxY && aOther.minY <= maxY;
+            }
+
+            /**
+             * @brief Get the squared distance from a point to the box, 0 inside it
+             */
+            [[nodiscard]] constexpr float distanceSquared(float aX, float aY) const noexcept
+            {
+                const auto dx = std::max({minX - aX, 0.F, aX - maxX});
+                const auto dy = std::max({minY - aY, 0.F, aY - maxY});
+
+                return dx * dx + dy * dy;
+            }
+    };
+
+    /**
+     * @brief Get the bounds of an entity from its position component, for the spatial index of a World
+     * @details A component with x and y members is a point, one with a radius member too is a disc. The trait can be
+     * specialized for the other components:
+     * @code
+     * template<>
+     * struct Engine::Core::SpatialTraits<Transform>
+     * {
+     *         static Aabb bounds(const Transform &aTransform) { ... }
+     * };
+     * @endcode
+     *
+     * @tparam Component The type of the position component
+     */
+    template<typename Component>
+    struct SpatialTraits
+    {};
+
+    template<typename Component>
+        requires requires(const Component &aComponent) {
+            { aComponent.x } -> std::convertible_to<float>;
+            { aComponent.y } -> std::convertible_to<float>;
+        }
+    struct SpatialTraits<Component>
+    {
+            static Aabb bounds(const Component &aComponent)
+            {
+                const auto x = static_cast<float>(aComponent.x);
+                const auto y = static_cast<float>(aComponent.y);
+                float radius = 0;
+
+                if constexpr (requires { aComponent.radius; }) {
+                    radius = static_cast<float>(aComponent.radius);
+                }
+                return Aabb {x - radius, y - radius, x + radius, y + radius};
+            }
+    };
+
+    template<typename Component>
+    concept SpatialComponent = requires(const Component &aComponent) {
+        { SpatialTraits<Component>::bounds(aComponent) } -> std::same_as<Aabb>;
+    };
+
+    /**
+     * @brief A spatial index of the bounds of the entities, to find the entities in an area without visiting all of
+     * them
+     * @details The index keeps the bounds of each entity, the implementations (HashGrid, LooseQuadtree) sort them in
+     * space. The queries are const and may run concurrently, the updates must not run while a query does. The World
+     * keeps its index up to date, see World::enableSpatial
+     */
+    class ISpatialIndex
+    {
+        public:
+            using id = std::size_t;
+            using pair = std::pair<id, id>;
+
+        protected:
+            std::vector<Aabb> _bounds;
+            std::vector<bool> _indexed;
+            std::vector<id> _entities;
+            std::vector<std::size_t> _slots;
+
+        public:
+            ISpatialIndex() = default;
+            virtual ~ISpatialIndex() = default;
+
+            ISpatialIndex(const ISpatialIndex &other) = default;
+            ISpatialIndex &operator=(const ISpatialIndex &other) = default;
+
+            ISpatialIndex(ISpatialIndex &&other) noexcept = default;
+            ISpatialIndex &operator=(ISpatialIndex &&other) noexcept = default;
+
+            /**
+             * @brief Insert an entity, or move it if it is already indexed
+             *
+             * @param aEntity The entity
+             * @param aBounds The bounds of the entity
+             */
+            void update(id aEntity, const Aabb &aBounds);
+
+            /**
+             * @brief Remove an entity, nothing happens if it isn't indexed
+             */
+            void remove(id aEntity);
+
+            /**
+             * @brief Remove every entity
+             */
+            void clear();
+
+            /**
+             * @brief Append the entities whose bounds overlap a box, in no particular order
+             *
+             * @param aBox The box
+             * @param aEntities The vector the entities are appended to
+             */
+            virtual void queryAABB(const Aabb &aBox, std::vector<id> &aEntities) const = 0;
+
+            /**
+             * @brief Get the entities whose bounds overlap a box
+             */
+            [[nodiscard]] std::vector<id> queryAABB(const Aabb &aBox) const
+            {
+                std::vector<id> entities;
+
+                queryAABB(aBox, entities);
+                return entities;
+            }
+
+            /**
+             * @brief Append the entities whose bounds are at most at a distance of a point
+             *
+             * @param aX The x coordinate of the point
+             * @param aY The y coordinate of the point
+             * @param aRadius The distance
+             * @param aEntities The vector the entities are appended to
+             */
+            void queryRadius(float aX, float aY, float aRadius, std::vector<id> &aEntities) const;
+
+            /**
+             * @brief Get the entities whose bounds are at most at a distance of a point
+             */
+            [[nodiscard]] std::vector<id> queryRadius(float aX, float aY, float aRadius) const
+            {
+                std::vector<id> entities;
+
+                queryRadius(aX, aY, aRadius, entities);
+                return entities;
+            }
+
+            /**
+             * @brief Get every pair of entities whose bounds overlap, the broad phase of a collision detection
+             * @details Each pair is given once, the lowest entity first. The entities are split in batches queried
+             * concurrently on the job system
+             * @param aJobSystem The job system running the batches
+             * @param aBatchSize The number of entities per job, 0 to let the job system choose
+             * @return std::vector<pair> The pairs, in no particular order
+             */
+            [[nodiscard]] std::vector<pair> findPairs(JobSystem &aJobSystem = JobSystem::getInstance(),
+                                                      std::size_t aBatchSize = 0) const;
+
+            /**
+             * @brief Check if an entity is indexed
+             */
+            [[nodiscard]] bool contains(id aEntity) const noexcept
+            {
+                return aEntity < _indexed.size() && _indexed[aEntity];
+            }
+
+            /**
+             * @brief Get the bounds of an indexed entity
+             */
+            [[nodiscard]] const Aabb &getBounds(id aEntity) const
+            {
+                return _bounds.at(aEntity);
+            }
+
+            /**
+             * @brief Get the number of entities indexed
+             */
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return _entities.size();
+            }
+
+        protected:
+            /**
+             * @brief Sort a new entity in space, its bounds are set
+             */
+            virtual void insertEntity(id aEntity) = 0;
+
+            /**
+             * @brief Sort an indexed entity again, its bounds changed from the given ones
+             */
+            virtual void moveEntity(id aEntity, const Aabb &aPrevious) = 0;
+
+            /**
+             * @brief Forget an indexed entity, its bounds are still set
+             */
+            virtual void eraseEntity(id aEntity) = 0;
+
+            /**
+             * @brief Forget every entity
+             */
+            virtual void clearEntities() = 0;
+    };
+} // namespace Engine::Core
+
+#endif /* !SPATIALINDEX_HPP_ */
@@ -2,12 +2,21 @@
 #define GENERICSYSTEM_HPP_
 
 #include <functional>
+#include <type_traits>
 #include <utility>
 #include "Core/Components/Component.hpp"
 #include "Core/World.hpp"
 #include "System.hpp"
 
 namespace Engine::Core {
+    /**
+     * @brief A system running a function on a query
+     * @details A const component is only read by the system, the others are written: the components declare the
+     * access of the system, so systems using disjoint components run concurrently
+     *
+     * @tparam Func The function, called like for Query::forEach
+     * @tparam Components The components of the query, const for read-only access
+     */
     template<typename Func, ComponentConcept... Components>
     class GenericSystem : public System
     {
@@ -18,13 +27,14 @@ namespace Engine::Core {
             GenericSystem(Core::World &world, Func updateFunc)
                 : System(world),
                   _updateFunc(updateFunc)
-            {}
+            {
+                uses<Components...>();
+            }
 
             void update() override
             {
-                double deltaTime = _clock.getElapsedTime();
-
-                _world.get().template query<Components...>().forEach(deltaTime, _updateFunc);
+                // The const components are queried read-only, so they aren't stamped as changed
+                _world.get().template query<Components...>().forEach(_world.get().getDeltaTime(), _updateFunc);
             }
     };
 
@@ -1,11 +1,66 @@
 #ifndef SYSTEM_HPP_
 #define SYSTEM_HPP_
+#include <algorithm>
+#include <cstddef>
 #include <functional>
-#include "Core/Clock.hpp"
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Core/Components/Component.hpp"
+#include "Core/TypeRegistry.hpp"
 
 namespace Engine::Core {
     class World;
 
+    /**
+     * @brief The components a system reads and writes, used by World::runSystems to run systems concurrently
+     * @details The ids are the process-wide component ids (TypeId<ComponentFamily>). A system that declared nothing is
+     * exclusive: it conflicts with every other system, like when systems ran one after another
+     */
+    struct SystemAccess
+    {
+        public:
+            std::vector<std::size_t> reads;
+            std::vector<std::size_t> writes;
+            bool exclusive = true;
+
+            /**
+             * @brief Check if two systems may not run at the same time
+             *
+             * @param aOther The access of the other system
+             * @return true if one of them is exclusive or writes a component the other one uses
+             * @return false if they can run concurrently
+             */
+            [[nodiscard]] bool conflictsWith(const SystemAccess &aOther) const
+            {
+                const auto intersects = [](const std::vector<std::size_t> &aLeft,
+                                           const std::vector<std::size_t> &aRight) {
+                    return std::ranges::any_of(aLeft, [&aRight](std::size_t aId) {
+                        return std::ranges::binary_search(aRight, aId);
+                    });
+                };
+
+                return exclusive || aOther.exclusive || intersects(writes, aOther.writes)
+                       || intersects(writes, aOther.reads) || intersects(reads, aOther.writes);
+            }
+    };
+
+    /**
+     * @brief When a system runs in a frame of World::step
+     */
+    enum class SystemStage : std::size_t
+    {
+        /**
+         * @brief Simulation systems, run at the fixed timestep of the World, zero or more times per frame
+         */
+        Fixed,
+        /**
+         * @brief Rendering and IO systems, run once per frame with the frame time
+         */
+        Variable,
+    };
+
     class System
     {
         public:
@@ -13,7 +68,10 @@ namespace Engine::Core {
 
         protected:
             std::reference_wrapper<Core::World> _world;
-            Clock _clock;
+            SystemAccess _access;
+            SystemStage _stage = SystemStage::Variable;
+            std::vector<std::string> _before;
+            std::vector<std::string> _after;
 
         public:
             explicit System(Core::World &aWorld)
@@ -27,6 +85,104 @@ namespace Engine::Core {
 
             System(const System &) = default;
             System(System &&) = default;
+
+            /**
+             * @brief Declare components the system only reads
+             */
+            template<ComponentConcept... Components>
+            System &reads()
+            {
+                (declare<Components>(_access.reads), ...);
+                return *this;
+            }
+
+            /**
+             * @brief Declare components the system writes
+             */
+            template<ComponentConcept... Components>
+            System &writes()
+            {
+                (declare<Components>(_access.writes), ...);
+                return *this;
+            }
+
+            /**
+             * @brief Declare the components the system uses, with the query convention: a const component is read,
+             * the others are written
+             */
+            template<ComponentConcept... Components>
+            System &uses()
+            {
+                (declare<Components>(std::is_const_v<Components> ? _access.reads : _access.writes), ...);
+                return *this;
+            }
+
+            /**
+             * @brief Run the system before another one, whatever the components they use
+             * @details Constraints naming a system that isn't in the World are ignored
+             * @param aSystem The name of the other system
+             */
+            System &before(std::string aSystem)
+            {
+                _before.push_back(std::move(aSystem));
+                return *this;
+            }
+
+            /**
+             * @brief Run the system after another one, whatever the components they use
+             * @details Constraints naming a system that isn't in the World are ignored
+             * @param aSystem The name of the other system
+             */
+            System &after(std::string aSystem)
+            {
+                _after.push_back(std::move(aSystem));
+                return *this;
+            }
+
+            /**
+             * @brief Set the stage the system runs in, Variable by default
+             * @details Like the before / after constraints, the stage is read when the system is added to the World,
+             * constraints between systems of different stages are ignored
+             * @param aStage The stage
+             */
+            System &stage(SystemStage aStage)
+            {
+                _stage = aStage;
+                return *this;
+            }
+
+            [[nodiscard]] SystemStage getStage() const
+            {
+                return _stage;
+            }
+
+            [[nodiscard]] const SystemAccess &getAccess() const
+            {
+                return _access;
+            }
+
+            [[nodiscard]] const std::vector<std::string> &getBefore() const
+            {
+                return _before;
+            }
+
+            [[nodiscard]] const std::vector<std::string> &getAfter() const
+            {
+                return _after;
+            }
+
+        private:
+            template<typename Component>
+            void declare(std::vector<std::size_t> &aIds)
+            {
+                const auto componentId = TypeId<ComponentFamily>::get<std::remove_const_t<Component>>();
+                const auto pos = std::ranges::lower_bound(aIds, componentId);
+
+                if (pos == aIds.end() || *pos != componentId) {
+                    aIds.insert(pos, componentId);
+                }
+                _access.exclusive = false;
+            }
     };
 } // namespace Engine::Core
 
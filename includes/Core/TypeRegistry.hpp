@@ -0,0 +1,181 @@
+#ifndef TYPEREGISTRY_HPP_
+#define TYPEREGISTRY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Engine::Core {
+    /**
+     * @brief Dense process-wide ids for the types of a family (components, events...)
+     * @details The id of a type is assigned the first time it is asked for, each family counts from 0
+     *
+     * @tparam Family A tag type, the ids of two families are unrelated
+     */
+    template<typename Family>
+    class TypeId final
+    {
+        private:
+            static std::size_t next()
+            {
+                static std::atomic<std::size_t> counter {0};
+
+                return counter.fetch_add(1, std::memory_order_relaxed);
+            }
+
+        public:
+            /**
+             * @brief Get the id of a type
+             *
+             * @tparam T The type
+             * @return std::size_t The id of the type in the family
+             */
+            template<typename T>
+            static std::size_t get()
+            {
+                static const std::size_t typeId = next();
+
+                return typeId;
+            }
+    };
+
+    /**
+     * @brief Map the types of a family to dense local ids and store one value per registered type
+     * @details Each registry (one per World, one per EventManager...) assigns its own ids in registration order, so
+     * its values stay packed whatever the types registered elsewhere. Looking a type up is two vector accesses, the
+     * local id can be resolved once and reused to skip the lookup entirely. The local id of an erased type is given to
+     * the next type registered, so registering and erasing types in a loop doesn't grow the registry
+     *
+     * @tparam Family The family of the types
+     * @tparam Value The value stored for each type
+     */
+    template<typename Family, typename Value>
+    class TypeRegistry
+    {
+        public:
+            using values = std::vector<Value>;
+            using iterator = typename values::iterator;
+            using constIterator = typename values::const_iterator;
+
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        private:
+            std::vector<std::size_t> _localIds;
+            values _values;
+            std::vector<std::size_t> _freeIds;
+
+        public:
+#pragma region methods
+            /**
+             * @brief Find the local id of a type
+             *
+             * @tparam T The type
+             * @return std::size_t The local id, npos if the type isn't registered
+             */
+            template<typename T>
+            [[nodiscard]] std::size_t find() const noexcept
+            {
+                const auto globalId = TypeId<Family>::template get<T>();
+
+                return globalId < _localIds.size() ? _localIds[globalId] : npos;
+            }
+
+            /**
+             * @brief Register a type, the type must not be registered yet
+             *
+             * @tparam T The type
+             * @param aValue The value stored for the type
+             * @return std::size_t The local id of the type, the id of an erased type if there is one
+             */
+            template<typename T>
+            std::size_t insert(Value aValue)
+            {
+                const auto globalId = TypeId<Family>::template get<T>();
+                std::size_t localId = _values.size();
+
+                if (globalId >= _localIds.size()) {
+                    _localIds.resize(globalId + 1, npos);
+                }
+                if (_freeIds.empty()) {
+                    _values.push_back(std::move(aValue));
+                } else {
+                    localId = _freeIds.back();
+                    _freeIds.pop_back();
+                    _values[localId] = std::move(aValue);
+                }
+                _localIds[globalId] = localId;
+                return localId;
+            }
+
+            /**
+             * @brief Unregister a type, the other ids stay valid and its local id goes to the next type registered
+             *
+             * @tparam T The type
+             */
+            template<typename T>
+            void erase()
+            {
+                const auto localId = find<T>();
+
+                if (localId == npos) {
+                    return;
+                }
+                _values[localId] = Value {};
+                _localIds[TypeId<Family>::template get<T>()] = npos;
+                _freeIds.push_back(localId);
+            }
+
+            Value &operator[](std::size_t aLocalId)
+            {
+                return _values[aLocalId];
+            }
+
+            const Value &operator[](std::size_t aLocalId) const
+            {
+                return _values[aLocalId];
+            }
+
+            /**
+             * @brief Get the number of local ids assigned so far, the free ones of the erased types included
+             */
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return _values.size();
+            }
+
+            /**
+             * @brief Get the number of registered types
+             */
+            [[nodiscard]] std::size_t count() const noexcept
+            {
+                return _values.size() - _freeIds.size();
+            }
+#pragma endregion methods
+
+#pragma region iterator
+            iterator begin()
+            {
+                return _values.begin();
+            }
+
+            iterator end()
+            {
+                return _values.end();
+            }
+
+            constIterator begin() const
+            {
+                return _values.begin();
+            }
+
+            constIterator end() const
+            {
+                return _values.end();
+            }
+#pragma endregion iterator
+    };
+} // namespace Engine::Core
+
+#endif /* !TYPEREGISTRY_HPP_ */
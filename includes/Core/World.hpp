@@ -1,25 +1,89 @@
 #ifndef WORLD_HPP_
 #define WORLD_HPP_
 
+#include <array>
+#include <atomic>
+#include <concepts>
 #include <cstddef>
+#include <filesystem>
 #include <functional>
+#include <istream>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string>
 #include <tuple>
-#include <typeindex>
+#include <type_traits>
 #include <utility>
 #include <vector>
-#include "Components/SparseArray.hpp"
+#include "Commands/CommandBuffer.hpp"
+#include "Components/ComponentStorage.hpp"
+#include "Core/Clock.hpp"
 #include "Core/Components/Component.hpp"
+#include "Entity.hpp"
+#include "Events/EventsManager.hpp"
 #include "Exception.hpp"
+#include "FrameTime.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Profiling/Profiler.hpp"
+#include "Serialization/MappedFile.hpp"
+#include "Serialization/Snapshot.hpp"
+#include "Spatial/HashGrid.hpp"
+#include "Spatial/LooseQuadtree.hpp"
+#include "QueryCallback.hpp"
+#include "Relations/Hierarchy.hpp"
 #include "Systems/System.hpp"
+#include "TypeRegistry.hpp"
 #include <boost/container/flat_map.hpp>
 
 namespace Engine::Core {
     DEFINE_EXCEPTION(WorldException);
     DEFINE_EXCEPTION_FROM(WorldExceptionComponentAlreadyRegistered, WorldException);
     DEFINE_EXCEPTION_FROM(WorldExceptionComponentNotRegistered, WorldException);
+    DEFINE_EXCEPTION_FROM(WorldExceptionTooManyComponents, WorldException);
+    DEFINE_EXCEPTION_FROM(WorldExceptionDeadEntity, WorldException);
     DEFINE_EXCEPTION_FROM(WorldExceptionSystemAlreadyRegistered, WorldException);
     DEFINE_EXCEPTION_FROM(WorldExceptionSystemNotRegistered, WorldException);
+    DEFINE_EXCEPTION_FROM(WorldExceptionSystemCycle, WorldException);
+
+    /**
+     * @brief Query filter keeping the entities whose component was added after a tick, see Query::filter
+     */
+    template<ComponentConcept Component>
+    struct Added
+    {
+            using component = Component;
+            static constexpr bool added = true;
+    };
+
+    /**
+     * @brief Query filter keeping the entities whose component was added or changed after a tick, see Query::filter
+     */
+    template<ComponentConcept Component>
+    struct Changed
+    {
+            using component = Component;
+            static constexpr bool added = false;
+    };
+
+    /**
+     * @brief What killing an entity does to its children, see World::killEntity
+     */
+    enum class ChildPolicy
+    {
+        /**
+         * @brief The descendants are killed with the entity
+         */
+        Kill,
+        /**
+         * @brief The children lose their ChildOf and become roots
+         */
+        Orphan,
+    };
 
     /**
      * @brief The world class represents a level, a scene
@@ -31,82 +95,702 @@ namespace Engine::Core {
         public:
             using id = std::size_t;
             using container = std::unique_ptr<ISparseArray>;
-            using containerMap = boost::container::flat_map<std::type_index, container>;
+            using containerMap = Core::TypeRegistry<ComponentFamily, container>;
             using idsContainer = std::vector<id>;
             using systemFunc = std::unique_ptr<System>;
             using newSystemFunc = std::pair<std::string, std::unique_ptr<System>>;
             using systems = boost::container::flat_map<std::string, systemFunc>;
 
+            /**
+             * @brief The maximum number of entities of a batch of Query::forEachBatch
+             */
+            static constexpr std::size_t defaultBatchSize = 1024;
+
         protected:
             containerMap _components;
+            std::pmr::memory_resource *_resource = std::pmr::get_default_resource();
+            std::vector<Signature> _signatures;
             idsContainer _ids;
             id _nextId = 0;
+            std::vector<Entity::generationType> _generations;
+            std::vector<bool> _alive;
+            Hierarchy _hierarchy;
+            std::unique_ptr<ISpatialIndex> _spatial;
+            std::size_t _spatialComponent = 0;
+            void (*_spatialRefresh)(World &aWorld, JobSystem &aJobSystem) = nullptr;
+            ISparseArray::tick _spatialTick = 0;
             systems _systems;
 
+            /**
+             * @brief A system of the schedule, with the systems waiting for it
+             */
+            struct SystemNode
+            {
+                    System *system = nullptr;
+                    std::vector<std::size_t> next;
+                    std::size_t dependencies = 0;
+                    Profiler::nameId profileName = 0;
+            };
+
+            static constexpr std::size_t stageCount = 2;
+
+            std::array<std::vector<SystemNode>, stageCount> _schedules;
+            std::vector<std::string> _systemOrder;
+            bool _scheduleDirty = true;
+            std::vector<std::unique_ptr<CommandBuffer>> _commandBuffers;
+            JobSystem *_commandJobSystem = nullptr;
+            std::unique_ptr<Event::EventManager> _eventManager = std::make_unique<Event::EventManager>();
+            FrameTime _frameTime;
+            ISparseArray::tick _changeTick = 1;
+            double _fixedDeltaTime = 1.0 / 60;
+            std::size_t _maxFixedSteps = 5;
+            double _accumulator = 0;
+            Clock _frameClock;
+            Profiler::nameId _stepProfileName = Profiler::getInstance().intern("World::step");
+
+            /**
+             * @brief The storage a query uses for a component, read-only for a const component
+             */
+            template<ComponentConcept Component>
+            using QueryStorage = std::conditional_t<std::is_const_v<Component>,
+                                                    const StorageOf<std::remove_const_t<Component>>,
+                                                    StorageOf<std::remove_const_t<Component>>>;
+
+            /**
+             * @brief What a query yields for a component: a reference, or the ColumnRef / the copy of a ColumnArray
+             */
+            template<ComponentConcept Component>
+            using QueryRef = decltype(std::declval<QueryStorage<Component> &>().get(std::size_t {}));
+
+            /**
+             * @brief The type a query callback receives by reference for a component, const for a const component
+             */
+            template<ComponentConcept Component>
+            using QueryArg = std::conditional_t<std::is_const_v<Component>,
+                                                const std::remove_reference_t<QueryRef<Component>>,
+                                                std::remove_reference_t<QueryRef<Component>>>;
+
+            /**
+             * @brief Iterate the entities having a set of components
+             * @details A const component is accessed read-only: it isn't stamped as changed (see ISparseArray)
+             */
             template<ComponentConcept... Components>
             class Query
             {
                 private:
+                    struct Filter
+                    {
+                            const ISparseArray *storage;
+                            ISparseArray::tick since;
+                            bool added;
+                    };
+
                     std::reference_wrapper<Core::World> _world;
+                    std::tuple<QueryStorage<Components> *...> _storages;
+                    Signature _mask;
+                    std::vector<Filter> _filters;
+                    ISparseArray::tick _changedSince = 0;
+                    bool _anyChanged = false;
+                    bool _filtered = false;
 
                 public:
+                    /**
+                     * @brief Lazily iterate the entities having all the components
+                     * @details Dereferencing yields a std::tuple<std::size_t, QueryRef<Components>...>: references on
+                     * the components, or a ColumnRef (a copy if const) for a component stored in a ColumnArray. The
+                     * iterator walks the entities of the driving storage, like forEach (see driver())
+                     */
+                    class iterator
+                    {
+                        public:
+                            using value_type = std::tuple<std::size_t, QueryRef<Components>...>;
+                            using reference = value_type;
+                            using difference_type = std::ptrdiff_t;
+                            using iterator_concept = std::forward_iterator_tag;
+
+                        private:
+                            const Query *_query = nullptr;
+                            const std::pmr::vector<std::size_t> *_entities = nullptr;
+                            std::size_t _slot = 0;
+                            std::size_t _end = 0;
+
+                        public:
+                            iterator() = default;
+
+                            /**
+                             * @brief Construct an iterator on a slot of the entities of the driving storage, or on an
+                             * entity index when there are none
+                             */
+                            iterator(const Query *aQuery, const std::pmr::vector<std::size_t> *aEntities,
+                                     std::size_t aSlot, std::size_t aEnd)
+                                : _query(aQuery),
+                                  _entities(aEntities),
+                                  _slot(aSlot),
+                                  _end(aEnd)
+                            {
+                                skip();
+                            }
+
+                            reference operator*() const
+                            {
+                                const auto idx = index();
+
+                                return reference(idx, _query->template storage<Components>().get(idx)...);
+                            }
+
+                            iterator &operator++()
+                            {
+                                _slot++;
+                                skip();
+                                return *this;
+                            }
+
+                            iterator operator++(int)
+                            {
+                                auto tmp = *this;
+
+                                ++*this;
+                                return tmp;
+                            }
+
+                            bool operator==(const iterator &aOther) const
+                            {
+                                return _slot == aOther._slot;
+                            }
+
+                        private:
+                            [[nodiscard]] std::size_t index() const
+                            {
+                                return _entities == nullptr ? _slot : (*_entities)[_slot];
+                            }
+
+                            void skip()
+                            {
+                                while (_slot < _end && !_query->has(index())) {
+                                    _slot++;
+                                }
+                            }
+                    };
+
+                    /**
+                     * @brief Construct a new Query, the storages of the components are resolved once here
+                     * @throw WorldExceptionComponentNotRegistered If a component isn't registered
+                     */
                     explicit Query(Core::World &world)
-                        : _world(world)
-                    {}
+                        : _world(world),
+                          _storages(&world.template getComponent<std::remove_const_t<Components>>()...)
+                    {
+                        (_mask.set(world.template getComponentId<std::remove_const_t<Components>>()), ...);
+                    }
+
+                    /**
+                     * @brief Only keep the entities with at least one of the components of the query added or changed
+                     * after a tick
+                     *
+                     * @param aTick The tick, usually the value of World::getChangeTick when the caller last ran
+                     * @return Query& The query
+                     */
+                    Query &changedSince(ISparseArray::tick aTick)
+                    {
+                        _changedSince = aTick;
+                        _anyChanged = true;
+                        _filtered = true;
+                        return *this;
+                    }
 
-                    void
-                    forEach(double deltaTime,
-                            std::function<void(World &world, double deltaTime, std::size_t idx, Components &...)> func)
+                    /**
+                     * @brief Only keep the entities passing every filter, the components of the filters are required
+                     * @code
+                     * world.query<Position>().filter<Changed<Velocity>, Added<Health>>(lastTick).forEach(...);
+                     * @endcode
+                     * @tparam Filters Added<Component> or Changed<Component>
+                     * @param aTick The tick the filters compare with
+                     * @return Query& The query
+                     */
+                    template<typename... Filters>
+                    Query &filter(ISparseArray::tick aTick)
                     {
-                        for (std::size_t idx = 0; idx < _world.get().getCurrentId(); idx++) {
-                            if (_world.get().template hasComponents<Components...>(idx)) {
-                                func(_world.get(), deltaTime, idx,
-                                     _world.get().template getComponent<Components>().get(idx)...);
+                        auto &world = _world.get();
+
+                        (_filters.push_back(Filter {&world.template getComponent<typename Filters::component>(), aTick,
+                                                    Filters::added}),
+                         ...);
+                        (_mask.set(world.template getComponentId<typename Filters::component>()), ...);
+                        _filtered = true;
+                        return *this;
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having all the components
+                     * @details The function is a template parameter, it isn't type-erased and can be inlined. The
+                     * entities are visited in the order of the driving storage (see forEachCandidate). A component
+                     * stored in a ColumnArray is passed as a ColumnRef, or as a copy if it is const (see QueryArg)
+                     * @param deltaTime The delta time forwarded to the function
+                     * @param func Callable as func(world, deltaTime, idx, components...), func(idx, components...)
+                     * or func(components...)
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEach(double deltaTime, Func &&func)
+                    {
+                        auto &world = _world.get();
+                        std::size_t visited = 0;
+
+                        forEachCandidate([this, &func, &world, deltaTime, &visited](std::size_t idx) {
+                            if (has(idx)) {
+                                invokeAt(func, world, deltaTime, idx);
+                                visited++;
+                            }
+                        });
+                        STELLAR_PROFILE_ENTITIES(visited);
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having all the components, with a null delta time
+                     *
+                     * @param func Callable as func(idx, components...) or func(components...)
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEach(Func &&func)
+                    {
+                        forEach(0, std::forward<Func>(func));
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having all the components, on the job system
+                     * @details The entities are split in batches run concurrently, the call returns once every
+                     * batch is done. The function must be safe to call from several threads at once, and must not
+                     * make structural changes to the World
+                     * @param deltaTime The delta time forwarded to the function
+                     * @param func Callable like for forEach
+                     * @param batchSize The number of entities per job, 0 to let the job system choose
+                     * @param jobSystem The job system running the batches
+                     * @throw Rethrows the first exception thrown by the function
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEachParallel(double deltaTime, Func &&func, std::size_t batchSize = 0,
+                                         JobSystem &jobSystem = JobSystem::getInstance())
+                    {
+                        auto &world = _world.get();
+                        const auto *entities = driver();
+
+                        world.prepareCommandBuffers(jobSystem);
+                        const auto count = candidateCount(entities);
+                        std::atomic<std::size_t> visited = 0;
+
+                        jobSystem.parallelFor(
+                            0, count, batchSize,
+                            [this, &func, &world, deltaTime, entities, &visited](std::size_t aBegin, std::size_t aEnd) {
+                                std::size_t batchVisited = 0;
+
+                                for (auto slot = aBegin; slot < aEnd; slot++) {
+                                    const auto idx = entities == nullptr ? slot : (*entities)[slot];
+
+                                    if (has(idx)) {
+                                        invokeAt(func, world, deltaTime, idx);
+                                        batchVisited++;
+                                    }
+                                }
+                                visited.fetch_add(batchVisited, std::memory_order_relaxed);
+                            });
+                        // The batches ran on other threads, the entities count for the scope of the caller
+                        STELLAR_PROFILE_ENTITIES(visited.load(std::memory_order_relaxed));
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having all the components, on the job system, with a
+                     * null delta time
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEachParallel(Func &&func, std::size_t batchSize = 0,
+                                         JobSystem &jobSystem = JobSystem::getInstance())
+                    {
+                        forEachParallel(0, std::forward<Func>(func), batchSize, jobSystem);
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having a parent and all the components, level by level
+                     * of the Hierarchy: the children of the roots first, then their children, and so on
+                     * @details An entity is always visited after its parent, so a value can be propagated from the
+                     * parents to the children, like the world transforms:
+                     * @code
+                     * world.query<const Local, Global>().forEachByDepth([&world](std::size_t aIdx, const Local &aLocal,
+                     *                                                            Global &aGlobal) {
+                     *     const auto parent = world.getHierarchy().getParent(aIdx);
+                     *
+                     *     aGlobal = world.getComponent<Global>().get(parent) * aLocal;
+                     * });
+                     * @endcode
+                     * The roots aren't visited, they have no parent to propagate from
+                     * @param deltaTime The delta time forwarded to the function
+                     * @param func Callable like for forEach
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEachByDepth(double deltaTime, Func &&func)
+                    {
+                        auto &world = _world.get();
+                        const auto &hierarchy = world._hierarchy;
+                        std::size_t visited = 0;
+
+                        for (std::size_t depth = 1; depth <= hierarchy.getLevelCount(); depth++) {
+                            for (const auto idx : hierarchy.getLevel(depth)) {
+                                if (has(idx)) {
+                                    invokeAt(func, world, deltaTime, idx);
+                                    visited++;
+                                }
                             }
                         }
+                        STELLAR_PROFILE_ENTITIES(visited);
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having a parent and all the components, level by
+                     * level, with a null delta time
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEachByDepth(Func &&func)
+                    {
+                        forEachByDepth(0, std::forward<Func>(func));
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having a parent and all the components, level by level
+                     * like forEachByDepth, the entities of a level on the job system
+                     * @details A level starts once the previous one is done, the function may read the components of
+                     * the parent of its entity but must follow the rules of forEachParallel otherwise
+                     * @param deltaTime The delta time forwarded to the function
+                     * @param func Callable like for forEach
+                     * @param batchSize The number of entities per job, 0 to let the job system choose
+                     * @param jobSystem The job system running the batches
+                     * @throw Rethrows the first exception thrown by the function, the next levels are skipped
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEachByDepthParallel(double deltaTime, Func &&func, std::size_t batchSize = 0,
+                                                JobSystem &jobSystem = JobSystem::getInstance())
+                    {
+                        auto &world = _world.get();
+                        const auto &hierarchy = world._hierarchy;
+                        std::atomic<std::size_t> visited = 0;
+
+                        world.prepareCommandBuffers(jobSystem);
+                        for (std::size_t depth = 1; depth <= hierarchy.getLevelCount(); depth++) {
+                            const auto level = hierarchy.getLevel(depth);
+
+                            const auto visit = [this, &func, &world, deltaTime, level, &visited](std::size_t aBegin,
+                                                                                                 std::size_t aEnd) {
+                                std::size_t batchVisited = 0;
+
+                                for (auto slot = aBegin; slot < aEnd; slot++) {
+                                    if (has(level[slot])) {
+                                        invokeAt(func, world, deltaTime, level[slot]);
+                                        batchVisited++;
+                                    }
+                                }
+                                visited.fetch_add(batchVisited, std::memory_order_relaxed);
+                            };
+
+                            jobSystem.parallelFor(0, level.size(), batchSize, visit);
+                        }
+                        STELLAR_PROFILE_ENTITIES(visited.load(std::memory_order_relaxed));
+                    }
+
+                    /**
+                     * @brief Call the function for each entity having a parent and all the components, level by level
+                     * on the job system, with a null delta time
+                     */
+                    template<QueryCallback<World, std::size_t, QueryArg<Components>...> Func>
+                    void forEachByDepthParallel(Func &&func, std::size_t batchSize = 0,
+                                                JobSystem &jobSystem = JobSystem::getInstance())
+                    {
+                        forEachByDepthParallel(0, std::forward<Func>(func), batchSize, jobSystem);
+                    }
+
+                    /**
+                     * @brief Call the function for each run of consecutive entities having all the components, with
+                     * spans over the columns of their components
+                     * @details Every component must be stored in a ColumnArray. A batch never crosses a multiple of
+                     * the batch size, so the full batches start on aligned columns when the batch size is a multiple
+                     * of 16 (see ColumnBatch). The mutable components of a batch are stamped as changed
+                     * @code
+                     * world.query<Position, const Velocity>().forEachBatch([dt](auto aPosition, auto aVelocity) {
+                     *     auto x = aPosition.template field<&Position::x>();
+                     *     auto vx = aVelocity.template field<&Velocity::x>();
+                     *
+                     *     for (std::size_t idx = 0; idx < x.size(); idx++) {
+                     *         x[idx] += vx[idx] * dt;
+                     *     }
+                     * });
+                     * @endcode
+                     * @param func Callable as func(ColumnBatch<Components>...)
+                     * @param batchSize The maximum number of entities of a batch, 0 for defaultBatchSize
+                     */
+                    template<typename Func>
+                        requires(ColumnComponent<std::remove_const_t<Components>> && ...)
+                                && std::is_invocable_v<Func &, ColumnBatch<Components>...>
+                    void forEachBatch(Func &&func, std::size_t batchSize = defaultBatchSize)
+                    {
+                        std::size_t first = 0;
+                        std::size_t size = 0;
+                        std::size_t visited = 0;
+                        const auto limit = batchSize == 0 ? defaultBatchSize : batchSize;
+                        const auto flush = [this, &func, &first, &size, &visited]() {
+                            if (size == 0) {
+                                return;
+                            }
+                            (markBatch<Components>(first, size), ...);
+                            func(ColumnBatch<Components>(storage<Components>(), first, size)...);
+                            visited += size;
+                            size = 0;
+                        };
+
+                        const auto &signatures = _world.get()._signatures;
+                        const auto end = std::min(_world.get().getCurrentId(), signatures.size());
+                        constexpr std::size_t pageSize = std::size_t(1) << ISparseArray::pageShift;
+
+                        // A column storage has no dense list to drive the query, every entity is walked
+                        for (std::size_t idx = 0; idx < end; idx++) {
+                            if (_filtered && idx % pageSize == 0 && !pagePasses(idx)) {
+                                flush();
+                                idx += pageSize - 1;
+                                continue;
+                            }
+                            if ((signatures[idx] & _mask) != _mask || (_filtered && !passes(idx))) {
+                                flush();
+                                continue;
+                            }
+                            if (idx % limit == 0) {
+                                flush();
+                            }
+                            if (size == 0) {
+                                first = idx;
+                            }
+                            size++;
+                        }
+                        flush();
+                        STELLAR_PROFILE_ENTITIES(visited);
+                    }
+
+                    iterator begin() const
+                    {
+                        const auto *entities = driver();
+
+                        return iterator(this, entities, 0, candidateCount(entities));
+                    }
+
+                    iterator end() const
+                    {
+                        const auto *entities = driver();
+                        const auto end = candidateCount(entities);
+
+                        return iterator(this, entities, end, end);
                     }
 
                     auto getAllEntities()
                     {
                         std::vector<std::size_t> entities;
 
-                        for (std::size_t idx = 0; idx < _world.get().getCurrentId(); idx++) {
-                            if (_world.get().template hasComponents<Components...>(idx)) {
+                        forEachCandidate([this, &entities](std::size_t idx) {
+                            if (has(idx)) {
                                 entities.emplace_back(idx);
                             }
-                        }
+                        });
                         return entities;
                     }
 
                     auto getAll()
                     {
-                        std::vector<std::tuple<std::size_t, Components &...>> entities;
+                        std::vector<std::tuple<std::size_t, QueryRef<Components>...>> entities;
 
-                        for (std::size_t idx = 0; idx < _world.get().getCurrentId(); idx++) {
-                            if (_world.get().template hasComponents<Components...>(idx)) {
-                                entities.emplace_back(idx,
-                                                      _world.get().template getComponent<Components>().get(idx)...);
+                        forEachCandidate([this, &entities](std::size_t idx) {
+                            if (has(idx)) {
+                                entities.emplace_back(idx, storage<Components>().get(idx)...);
                             }
-                        }
+                        });
                         return entities;
                     }
 
                     auto getComponentsOfEntity(std::size_t idx)
                     {
-                        return std::make_tuple(_world.get().template getComponent<Components>().get(idx)...);
+                        return std::make_tuple(storage<Components>().get(idx)...);
+                    }
+
+                private:
+                    template<ComponentConcept Component>
+                    QueryStorage<Component> &storage() const
+                    {
+                        return *std::get<QueryStorage<Component> *>(_storages);
+                    }
+
+                    /**
+                     * @brief Call a query callback with the components of an entity
+                     * @details The components are bound to names first, so a storage returning them by value (see
+                     * ColumnArray) works like the others
+                     */
+                    template<typename Func>
+                    void invokeAt(Func &func, World &world, double deltaTime, std::size_t idx) const
+                    {
+                        [&func, &world, deltaTime, idx](auto &&...aComponents) {
+                            invokeQueryCallback(func, world, deltaTime, idx, aComponents...);
+                        }(storage<Components>().get(idx)...);
+                    }
+
+                    template<ComponentConcept Component>
+                    void markBatch(std::size_t first, std::size_t size) const
+                    {
+                        if constexpr (!std::is_const_v<Component>) {
+                            storage<Component>().markChanged(first, size);
+                        }
+                    }
+
+                    [[nodiscard]] bool has(std::size_t idx) const
+                    {
+                        const auto &signatures = _world.get()._signatures;
+
+                        return idx < signatures.size() && (signatures[idx] & _mask) == _mask
+                               && (!_filtered || passes(idx));
+                    }
+
+                    [[nodiscard]] bool passes(std::size_t idx) const
+                    {
+                        for (const auto &filter : _filters) {
+                            if (!(filter.added ? filter.storage->addedSince(idx, filter.since)
+                                               : filter.storage->changedSince(idx, filter.since))) {
+                                return false;
+                            }
+                        }
+                        return !_anyChanged || (storage<Components>().changedSince(idx, _changedSince) || ...);
+                    }
+
+                    /**
+                     * @brief Check if the page of an entity may hold entities passing the filters
+                     */
+                    [[nodiscard]] bool pagePasses(std::size_t idx) const
+                    {
+                        for (const auto &filter : _filters) {
+                            if (!filter.storage->pageChangedSince(idx, filter.since)) {
+                                return false;
+                            }
+                        }
+                        return !_anyChanged || (storage<Components>().pageChangedSince(idx, _changedSince) || ...);
+                    }
+
+                    /**
+                     * @brief Pick the storage driving the iteration
+                     * @details The storage with the fewest live entries drives the loop: a SparseArray or a
+                     * PackedArray visits the list of its entities, a PagedArray or a ColumnArray costs a walk over
+                     * every entity. A query including a rare component is then O(count of that component) instead of
+                     * O(entities)
+                     * @return const std::pmr::vector<std::size_t>* The entities of the driving storage, nullptr to
+                     * walk every entity
+                     */
+                    [[nodiscard]] const std::pmr::vector<std::size_t> *driver() const
+                    {
+                        const std::pmr::vector<std::size_t> *best = nullptr;
+                        std::size_t bestCost = _world.get().getCurrentId();
+
+                        (considerDriver(storage<Components>(), best, bestCost), ...);
+                        return best;
+                    }
+
+                    /**
+                     * @brief Get the number of candidates of the query: the entities of the driving storage, or every
+                     * entity when there are none
+                     */
+                    [[nodiscard]] std::size_t candidateCount(const std::pmr::vector<std::size_t> *entities) const
+                    {
+                        return entities == nullptr ? _world.get().getCurrentId() : entities->size();
+                    }
+
+                    /**
+                     * @brief Visit the entities that may have all the components, see driver()
+                     */
+                    template<typename Visit>
+                    void forEachCandidate(Visit &&visit) const
+                    {
+                        const auto *entities = driver();
+
+                        if (entities == nullptr) {
+                            const auto end = _world.get().getCurrentId();
+                            constexpr std::size_t pageSize = std::size_t(1) << ISparseArray::pageShift;
+
+                            for (std::size_t idx = 0; idx < end; idx++) {
+                                // A page with no change since the tick of the filters is skipped as a whole
+                                if (_filtered && idx % pageSize == 0 && !pagePasses(idx)) {
+                                    idx += pageSize - 1;
+                                    continue;
+                                }
+                                visit(idx);
+                            }
+                            return;
+                        }
+                        for (const auto idx : *entities) {
+                            visit(idx);
+                        }
+                    }
+
+                    template<typename Storage>
+                    static void considerDriver(const Storage &aStorage, const std::pmr::vector<std::size_t> *&aBest,
+                                               std::size_t &aBestCost)
+                    {
+                        if constexpr (requires { aStorage.entities(); }) {
+                            if (aStorage.count() < aBestCost) {
+                                aBest = &aStorage.entities();
+                                aBestCost = aStorage.count();
+                            }
+                        }
+                    }
+            };
+
+            /**
+             * @brief A std::ranges view over the entities having all the components
+             * @details Elements are std::tuple<std::size_t, QueryRef<Components>...>, produced lazily while iterating.
+             * Like any query, the view must not outlive a structural change of the World
+             */
+            template<ComponentConcept... Components>
+            class View : public std::ranges::view_interface<View<Components...>>
+            {
+                private:
+                    Query<Components...> _query;
+
+                public:
+                    explicit View(Core::World &world)
+                        : _query(world)
+                    {}
+
+                    auto begin() const
+                    {
+                        return _query.begin();
+                    }
+
+                    auto end() const
+                    {
+                        return _query.end();
                     }
             };
 
         public:
 #pragma region constructors / destructors
             World() = default;
+
+            /**
+             * @brief Construct a new World whose component storages allocate from a memory resource
+             *
+             * @param aResource The memory resource of the storages, must outlive the World
+             */
+            explicit World(std::pmr::memory_resource *aResource)
+                : _resource(aResource)
+            {}
+
             ~World() = default;
 
             World(const World &other) = default;
             World &operator=(const World &other) = default;
 
-            World(World &&other) noexcept = default;
-            World &operator=(World &&other) noexcept = default;
+            /**
+             * @brief Move a World, its storages are bound to the signatures and the change tick of the new World
+             * @details The systems and the queries made on the moved-from World still refer to it
+             */
+            World(World &&other) noexcept;
+            World &operator=(World &&other) noexcept;
 #pragma endregion constructors / destructors
 
 #pragma region methods
@@ -117,27 +801,45 @@ namespace Engine::Core {
                 return Query<Components...>(*this);
             }
 
+            /**
+             * @brief Get a lazy std::ranges view over the entities having all the components
+             *
+             * @tparam Components The components of the entities
+             * @return View<Components...> The view, yielding (idx, components...) tuples
+             */
+            template<ComponentConcept... Components>
+            View<Components...> view()
+            {
+                return View<Components...>(*this);
+            }
+
             /**
              * @brief Add a component to the World, all components should be added before any entity is created
+             * @details The storage is picked by ComponentStorage (a SparseArray unless the component selects
+             * another), it allocates from the memory resource of the World
              *
              * @tparam Component Type of the component
-             * @return SparseArray<Component>& Reference to the component SparseArray
+             * @return StorageOf<Component>& Reference to the component storage
              */
             template<ComponentConcept Component>
-            SparseArray<Component> &registerComponent()
+            StorageOf<Component> &registerComponent()
             {
-                auto typeIndex = std::type_index(typeid(Component));
-
-                if (_components.find(typeIndex) != _components.end()) {
+                if (_components.template find<Component>() != containerMap::npos) {
                     throw WorldExceptionComponentAlreadyRegistered("Component already registered");
                 }
-                _components[typeIndex] = std::make_unique<SparseArray<Component>>();
+                if (_components.count() >= maxComponents) {
+                    throw WorldExceptionTooManyComponents("Too many components registered");
+                }
+                const auto componentId = _components.template insert<Component>(makeStorage<Component>());
+                auto &storage = _components[componentId];
 
+                storage->bindSignatures(&_signatures, componentId);
+                storage->bindChangeTick(&_changeTick);
                 for (std::size_t idx = 0; idx < _nextId; idx++) {
-                    _components[typeIndex]->init(idx);
+                    storage->init(idx);
                 }
 
-                return static_cast<SparseArray<Component> &>(*_components[typeIndex]);
+                return static_cast<StorageOf<Component> &>(*storage);
             }
 
             /**
@@ -155,34 +857,42 @@ namespace Engine::Core {
              * @brief Get the Component object
              *
              * @tparam Component The type of the component
-             * @return SparseArray<Component>& the SparseArray of the component
+             * @return StorageOf<Component>& the storage of the component
              */
             template<ComponentConcept Component>
-            SparseArray<Component> &getComponent()
+            StorageOf<Component> &getComponent()
             {
-                auto typeIndex = std::type_index(typeid(Component));
-
-                if (_components.find(typeIndex) == _components.end()) {
-                    throw WorldExceptionComponentNotRegistered("Component not registered");
-                }
-                return static_cast<SparseArray<Component> &>(*_components[typeIndex]);
+                return static_cast<StorageOf<Component> &>(*_components[getComponentId<Component>()]);
             }
 
             /**
              * @brief Get the Component object
              *
              * @tparam Component The type of the component
-             * @return SparseArray<Component>& the SparseArray of the component
+             * @return StorageOf<Component> const& the storage of the component
+             */
+            template<ComponentConcept Component>
+            StorageOf<Component> const &getComponent() const
+            {
+                return static_cast<StorageOf<Component> const &>(*_components[getComponentId<Component>()]);
+            }
+
+            /**
+             * @brief Get the id of a component in this World, ids are dense and assigned at registration
+             *
+             * @tparam Component The type of the component
+             * @return std::size_t The id of the component
+             * @throw WorldExceptionComponentNotRegistered If the component isn't registered
              */
             template<ComponentConcept Component>
-            SparseArray<Component> const &getComponent() const
+            [[nodiscard]] std::size_t getComponentId() const
             {
-                auto typeIndex = std::type_index(typeid(Component));
+                const auto componentId = _components.template find<Component>();
 
-                if (_components.find(typeIndex) == _components.end()) {
+                if (componentId == containerMap::npos) {
                     throw WorldExceptionComponentNotRegistered("Component not registered");
                 }
-                return static_cast<SparseArray<Component> const &>(*_components.at(typeIndex));
+                return componentId;
             }
 
             /**
@@ -196,39 +906,77 @@ namespace Engine::Core {
             template<ComponentConcept... Components>
             [[nodiscard]] bool hasComponents(std::size_t aIndex) const
             {
-                return (... && getComponent<Components>().has(aIndex));
+                Signature mask;
+
+                (mask.set(getComponentId<Components>()), ...);
+                return aIndex < _signatures.size() && (_signatures[aIndex] & mask) == mask;
+            }
+
+            /**
+             * @brief Check if the entity is alive and has all the components
+             *
+             * @param aEntity The entity
+             * @return true if the handle isn't stale and the entity has all the components
+             */
+            template<ComponentConcept... Components>
+            [[nodiscard]] bool hasComponents(Entity aEntity) const
+            {
+                return isAlive(aEntity) && hasComponents<Components...>(aEntity.index);
             }
 
             /**
-             * @brief Remove a component
+             * @brief Get the signature of an entity, one bit per component id
+             *
+             * @param aIndex The index of the entity
+             * @return const Signature& The signature of the entity
+             */
+            [[nodiscard]] const Signature &getSignature(std::size_t aIndex) const
+            {
+                return _signatures.at(aIndex);
+            }
+
+            /**
+             * @brief Remove a component, its id and its bit in the signatures go to the next component registered
              *
              * @tparam Component The type of the component
              */
             template<ComponentConcept Component>
             void removeComponent()
             {
-                auto typeIndex = std::type_index(typeid(Component));
+                const auto componentId = getComponentId<Component>();
 
-                if (_components.find(typeIndex) == _components.end()) {
-                    throw WorldExceptionComponentNotRegistered("Component not registered");
+                for (auto &signature : _signatures) {
+                    signature.reset(componentId);
+                }
+                if constexpr (std::is_same_v<Component, ChildOf>) {
+                    _hierarchy.clear();
                 }
-                _components.erase(typeIndex);
+                if (_spatial && componentId == _spatialComponent) {
+                    disableSpatial();
+                }
+                _components.template erase<Component>();
             }
 
             /**
              * @brief Add a component to an entity
+             * @details Adding a ChildOf links the entity to its parent in the Hierarchy
+             * @throw WorldExceptionDeadEntity If the parent of a ChildOf is stale
+             * @throw HierarchyExceptionCycle If the parent of a ChildOf is the entity or one of its descendants
              *
              * @tparam Component The type of the component to add
              * @param aIndex The index of the entity
              * @param aComponent The component to add
-             * @return Component& The component added
+             * @return Component& The component added, a ColumnRef for a component stored in columns
              */
             template<ComponentConcept Component>
-            Component &addComponentToEntity(std::size_t aIndex, Component &&aComponent)
+            decltype(auto) addComponentToEntity(std::size_t aIndex, Component &&aComponent)
             {
                 try {
                     auto &component = getComponent<Component>();
 
+                    if constexpr (std::is_same_v<Component, ChildOf>) {
+                        _hierarchy.setParent(aIndex, checkAlive(aComponent.parent));
+                    }
                     component.set(aIndex, std::forward<Component>(aComponent));
                     return component.get(aIndex);
                 } catch (WorldExceptionComponentNotRegistered &e) {
@@ -236,6 +984,21 @@ namespace Engine::Core {
                 }
             }
 
+            /**
+             * @brief Add a component to an entity
+             * @throw WorldExceptionDeadEntity If the handle is stale
+             *
+             * @tparam Component The type of the component to add
+             * @param aEntity The entity
+             * @param aComponent The component to add
+             * @return Component& The component added, a ColumnRef for a component stored in columns
+             */
+            template<ComponentConcept Component>
+            decltype(auto) addComponentToEntity(Entity aEntity, Component &&aComponent)
+            {
+                return addComponentToEntity(checkAlive(aEntity), std::forward<Component>(aComponent));
+            }
+
             /**
              * @brief Build and add a component to an entity
              *
@@ -243,21 +1006,39 @@ namespace Engine::Core {
              * @tparam Args The types of the arguments to pass to the component constructor (infered)
              * @param aIndex The index of the entity
              * @param aArgs The arguments to pass to the component constructor
-             * @return Component& The component added
+             * @return Component& The component added, a ColumnRef for a component stored in columns
              */
             template<ComponentConcept Component, typename... Args>
-            Component &emplaceComponentToEntity(std::size_t aIndex, Args &&...aArgs)
+            decltype(auto) emplaceComponentToEntity(std::size_t aIndex, Args &&...aArgs)
             {
-                try {
-                    auto &component = getComponent<Component>();
+                if constexpr (std::is_same_v<Component, ChildOf>) {
+                    return addComponentToEntity(aIndex, ChildOf(std::forward<Args>(aArgs)...));
+                } else {
+                    try {
+                        auto &component = getComponent<Component>();
 
-                    component.emplace(aIndex, std::forward<Args>(aArgs)...);
-                    return component.get(aIndex);
-                } catch (WorldExceptionComponentNotRegistered &e) {
-                    throw WorldExceptionComponentNotRegistered("Component not registered");
+                        component.emplace(aIndex, std::forward<Args>(aArgs)...);
+                        return component.get(aIndex);
+                    } catch (WorldExceptionComponentNotRegistered &e) {
+                        throw WorldExceptionComponentNotRegistered("Component not registered");
+                    }
                 }
             }
 
+            /**
+             * @brief Build and add a component to an entity
+             * @throw WorldExceptionDeadEntity If the handle is stale
+             *
+             * @param aEntity The entity
+             * @param aArgs The arguments to pass to the component constructor
+             * @return Component& The component added, a ColumnRef for a component stored in columns
+             */
+            template<ComponentConcept Component, typename... Args>
+            decltype(auto) emplaceComponentToEntity(Entity aEntity, Args &&...aArgs)
+            {
+                return emplaceComponentToEntity<Component>(checkAlive(aEntity), std::forward<Args>(aArgs)...);
+            }
+
             /**
              * @brief Remove a component from an entity
              *
@@ -270,25 +1051,290 @@ namespace Engine::Core {
                 try {
                     auto &component = getComponent<Component>();
 
+                    if constexpr (std::is_same_v<Component, ChildOf>) {
+                        _hierarchy.removeParent(aIndex);
+                    }
+                    if (_spatial && getComponentId<Component>() == _spatialComponent) {
+                        _spatial->remove(aIndex);
+                    }
                     component.erase(aIndex);
                 } catch (WorldExceptionComponentNotRegistered &e) {
                     throw WorldExceptionComponentNotRegistered("Component not registered");
                 }
             }
 
+            /**
+             * @brief Remove a component from an entity
+             * @throw WorldExceptionDeadEntity If the handle is stale
+             *
+             * @param aEntity The entity
+             */
+            template<ComponentConcept Component>
+            void removeComponentFromEntity(Entity aEntity)
+            {
+                removeComponentFromEntity<Component>(checkAlive(aEntity));
+            }
+
             /**
              * @brief Kill an entity
-             * @details Call erase from each component on the entity, then add the id as a free id
+             * @details Call erase from each component on the entity, bump the generation of the index then push it
+             * on the free list. The children of the entity are killed with it, or orphaned, in the same batch (see
+             * killEntities)
+             * @throw WorldExceptionDeadEntity If the entity isn't alive
              * @param aIndex The index of the entity to kill
+             * @param aChildren What happens to the children of the entity
+             */
+            void killEntity(std::size_t aIndex, ChildPolicy aChildren = ChildPolicy::Kill);
+
+            /**
+             * @brief Kill an entity
+             * @throw WorldExceptionDeadEntity If the handle is stale
+             * @param aEntity The entity to kill
+             * @param aChildren What happens to the children of the entity
              */
-            void killEntity(std::size_t aIndex);
+            void killEntity(Entity aEntity, ChildPolicy aChildren = ChildPolicy::Kill);
 
             /**
              * @brief Create an entity
-             * @details Get the next free id, call init from each component on the entity, then return the id
-             * @return std::size_t The id of the entity
+             * @details Pop the last freed index (or take a new one), call init from each component on the entity, then
+             * return the handle. O(1) whatever the number of free indexes
+             * @return Entity The handle of the entity
+             */
+            Entity createEntity();
+
+            /**
+             * @brief Create several entities at once
+             * @details The free indexes are reused first, then the storages grow once for all the new indexes, each
+             * storage is visited once instead of once per entity
+             * @param aCount The number of entities to create
+             * @return std::vector<Entity> The handles of the entities
+             */
+            std::vector<Entity> createEntities(std::size_t aCount);
+
+            /**
+             * @brief Create several entities with their components
+             * @details The storages of the components are reserved once, then the components built by the generator
+             * are moved in place. A ChildOf links its entity in the Hierarchy, like addComponentToEntity
+             * @throw WorldExceptionComponentNotRegistered If a component isn't registered, before any entity is created
+             * @throw WorldExceptionDeadEntity If the parent of a ChildOf is stale, the entities stay created
+             *
+             * @tparam Components The components of the entities
+             * @param aCount The number of entities to create
+             * @param aGenerator Callable as generator(i) for i in [0, aCount), returning std::tuple<Components...>
+             * @return std::vector<Entity> The handles of the entities, in the order of the generator calls
+             */
+            template<ComponentConcept... Components, typename Generator>
+            std::vector<Entity> spawnBatch(std::size_t aCount, Generator &&aGenerator)
+            {
+                auto storages = std::tuple<StorageOf<Components> &...>(getComponent<Components>()...);
+                auto entities = createEntities(aCount);
+
+                (std::get<StorageOf<Components> &>(storages).reserve(aCount), ...);
+                for (std::size_t idx = 0; idx < aCount; idx++) {
+                    std::tuple<Components...> components = aGenerator(idx);
+
+                    (spawnComponent(std::get<StorageOf<Components> &>(storages), entities[idx].index,
+                                    std::move(std::get<Components>(components))),
+                     ...);
+                }
+                return entities;
+            }
+
+            /**
+             * @brief Kill several entities at once
+             * @details Each storage is visited once for all the entities. A handle given twice is killed once. The
+             * descendants of the entities are added to the batch, or their children lose their ChildOf
+             * @throw WorldExceptionDeadEntity If a handle is stale, before any entity is killed
+             * @param aEntities The entities to kill
+             * @param aChildren What happens to the children of the entities
+             */
+            void killEntities(std::span<const Entity> aEntities, ChildPolicy aChildren = ChildPolicy::Kill);
+
+            /**
+             * @brief Make an entity the child of another, registering ChildOf on first use
+             * @details Same as adding a ChildOf to the entity, it replaces the previous parent
+             * @throw WorldExceptionDeadEntity If a handle is stale
+             * @throw HierarchyExceptionCycle If the parent is the entity or one of its descendants
+             * @param aChild The entity
+             * @param aParent The new parent of the entity
+             */
+            void setParent(Entity aChild, Entity aParent);
+
+            /**
+             * @brief Detach an entity from its parent, same as removing its ChildOf
+             * @throw WorldExceptionDeadEntity If the handle is stale
+             * @param aChild The entity
+             */
+            void removeParent(Entity aChild);
+
+            /**
+             * @brief Get the parent of an entity
+             * @throw WorldExceptionDeadEntity If the handle is stale
+             * @param aChild The entity
+             * @return std::optional<Entity> The parent, nullopt for a root
+             */
+            [[nodiscard]] std::optional<Entity> getParent(Entity aChild) const;
+
+            /**
+             * @brief Get the parent / children links of the entities, sorted by depth
+             */
+            [[nodiscard]] const Hierarchy &getHierarchy() const noexcept
+            {
+                return _hierarchy;
+            }
+
+            /**
+             * @brief Index the entities in space from their position component, replacing the previous index
+             * @details The index is updated at the start of each stage (see updateSpatial) from the positions added
+             * or changed since its last update, it follows the kills and the removals of the position right away.
+             * The bounds of an entity come from SpatialTraits
+             * @code
+             * world.enableSpatial<Position, Engine::Core::HashGrid>(32.F);
+             * world.enableSpatial<Position, Engine::Core::LooseQuadtree>(Engine::Core::Aabb {0, 0, 4096, 4096});
+             * @endcode
+             * @throw WorldExceptionComponentNotRegistered If the position component isn't registered
+             *
+             * @tparam Position The position component
+             * @tparam Index The implementation of the index, a HashGrid by default
+             * @param aArgs The arguments of the constructor of the index
+             * @return Index& The index, empty until the next update
+             */
+            template<ComponentConcept Position, typename Index = HashGrid, typename... Args>
+                requires SpatialComponent<Position> && std::derived_from<Index, ISpatialIndex>
+            Index &enableSpatial(Args &&...aArgs)
+            {
+                const auto componentId = getComponentId<Position>();
+                auto index = std::make_unique<Index>(std::forward<Args>(aArgs)...);
+                auto &result = *index;
+
+                _spatial = std::move(index);
+                _spatialComponent = componentId;
+                _spatialRefresh = &refreshSpatial<Position>;
+                _spatialTick = 0;
+                return result;
+            }
+
+            /**
+             * @brief Drop the spatial index
+             */
+            void disableSpatial() noexcept
+            {
+                _spatial.reset();
+                _spatialRefresh = nullptr;
+            }
+
+            /**
+             * @brief Get the spatial index of the World
+             * @code
+             * for (const auto idx : world.spatial().queryRadius(x, y, aggroRadius)) { ... }
+             * @endcode
+             * @throw WorldException If no spatial index is enabled
              */
-            std::size_t createEntity();
+            ISpatialIndex &spatial();
+
+            [[nodiscard]] const ISpatialIndex &spatial() const;
+
+            /**
+             * @brief Bring the spatial index up to date with the positions added or changed since its last update
+             * @details Done at the start of each stage. The bounds of the changed entities are computed concurrently
+             * on the job system, then the index is updated in one pass. Nothing happens without a spatial index
+             * @param aJobSystem The job system computing the bounds
+             */
+            void updateSpatial(JobSystem &aJobSystem = JobSystem::getInstance());
+
+            /**
+             * @brief Write the entities and the serializable components of the World in a binary snapshot
+             * @details The snapshot is versioned and columnar: a header, the generations and liveness of the entities,
+             * then one block per component type with a presence bitmap of the entities and one packed column per
+             * field, every column aligned on snapshotAlignment bytes. The components that aren't serializable (see
+             * ComponentSerializer) are left out, the systems, events and pending commands are not part of the World
+             * state
+             * @return std::vector<std::byte> The snapshot
+             */
+            [[nodiscard]] std::vector<std::byte> snapshot() const;
+
+            /**
+             * @brief Write a snapshot of the World to a stream
+             *
+             * @param aStream The binary stream to write to
+             */
+            void snapshot(std::ostream &aStream) const;
+
+            /**
+             * @brief Replace the entities and components of the World by the ones of a snapshot
+             * @details The component types of the snapshot must be registered. By default the blocks of unknown types
+             * are skipped with a warning and the registered components missing from the snapshot end up empty, a
+             * strict restore refuses both. The handles taken before the restore are only valid if they are valid in
+             * the snapshot
+             * @throw SnapshotExceptionVersion If the snapshot isn't a snapshot of this version, the World is untouched
+             * @throw SnapshotExceptionMismatch If the policy is strict and the component types of the snapshot and of
+             * the World differ, the World is untouched
+             * @throw SnapshotExceptionCorrupted If the snapshot is malformed, the World is left partially restored
+             * @param aSnapshot The snapshot
+             * @param aPolicy What to do with the component types that the snapshot and the World don't share
+             */
+            void restore(std::span<const std::byte> aSnapshot, RestorePolicy aPolicy = RestorePolicy::Lenient);
+
+            /**
+             * @brief Restore the World from a snapshot read from a stream, until its end
+             *
+             * @param aStream The binary stream to read from
+             * @param aPolicy What to do with the component types that the snapshot and the World don't share
+             */
+            void restore(std::istream &aStream, RestorePolicy aPolicy = RestorePolicy::Lenient);
+
+            /**
+             * @brief Write a snapshot of the World to a file
+             * @throw SnapshotExceptionFile If the file can't be written
+             * @param aPath The path of the file
+             */
+            void snapshot(const std::filesystem::path &aPath) const;
+
+            /**
+             * @brief Restore the World from a snapshot file, memory-mapped instead of read
+             * @details The file is mapped privately (see MappedFile). The ColumnArray storages keep its Indexed columns
+             * instead of copying them: nothing is read before it is touched, the processes restoring the same file
+             * share its pages, and a write to a column copies the page it touches for this World only. The other
+             * storages are deserialized like restore(std::span). The mapping lives as long as a storage uses it
+             * @throw SnapshotExceptionFile If the file can't be opened
+             * @param aPath The path of the file
+             * @param aPolicy What to do with the component types that the snapshot and the World don't share
+             */
+            void restore(const std::filesystem::path &aPath, RestorePolicy aPolicy = RestorePolicy::Lenient);
+
+            /**
+             * @brief Check if a handle still designates a living entity
+             *
+             * @param aEntity The handle
+             * @return true if the entity is alive and the index wasn't reused since the handle was made
+             */
+            [[nodiscard]] bool isAlive(Entity aEntity) const noexcept
+            {
+                return isAlive(aEntity.index) && _generations[aEntity.index] == aEntity.generation;
+            }
+
+            /**
+             * @brief Check if an index is used by a living entity
+             */
+            [[nodiscard]] bool isAlive(std::size_t aIndex) const noexcept
+            {
+                return aIndex < _alive.size() && _alive[aIndex];
+            }
+
+            /**
+             * @brief Get the handle of the living entity at an index, e.g. to keep the entity given to a query callback
+             * @throw WorldExceptionDeadEntity If no entity lives at the index
+             *
+             * @param aIndex The index of the entity
+             * @return Entity The handle of the entity
+             */
+            [[nodiscard]] Entity getEntity(std::size_t aIndex) const
+            {
+                if (!isAlive(aIndex)) {
+                    throw WorldExceptionDeadEntity("No entity alive at index " + std::to_string(aIndex));
+                }
+                return Entity {aIndex, _generations[aIndex]};
+            }
 
             /**
              * @brief Add a system to the world
@@ -304,6 +1350,7 @@ namespace Engine::Core {
                 }
 
                 _systems[aSystem.first] = std::move(aSystem.second);
+                _scheduleDirty = true;
             }
 
             /**
@@ -319,13 +1366,172 @@ namespace Engine::Core {
                 }
 
                 _systems.erase(aFuncName);
+                _scheduleDirty = true;
+            }
+
+            /**
+             * @brief Run all the systems once, the Fixed stage then the Variable stage
+             * @details The systems run on the job system, two systems run concurrently unless one of them writes a
+             * component the other uses (see System::reads / System::writes), one of them declared nothing, or a
+             * before / after constraint links them. Conflicting systems run in the order of the schedule: a
+             * topological order of the before / after constraints, ties broken by name. The call returns once every
+             * system is done
+             * @throw WorldExceptionSystemCycle If the before / after constraints form a cycle
+             * @throw Rethrows the first exception thrown by a system, the systems depending on it are skipped and the
+             * commands recorded during the stage are dropped
+             * @param aJobSystem The job system running the systems
+             */
+            void runSystems(JobSystem &aJobSystem = JobSystem::getInstance());
+
+            /**
+             * @brief Run the systems of a stage once, like runSystems, then flush the commands they recorded
+             * @details The spatial index is updated before the systems run, see updateSpatial
+             *
+             * @param aStage The stage
+             * @param aJobSystem The job system running the systems
+             */
+            void runStage(SystemStage aStage, JobSystem &aJobSystem = JobSystem::getInstance());
+
+            /**
+             * @brief Advance the World by a frame
+             * @details The frame time is accumulated and the Fixed stage runs once per fixed timestep it holds, at most
+             * the max fixed steps per frame: past that the late time is dropped so a slow frame doesn't make the next
+             * ones slower. The Variable stage then runs once, with the leftover time as interpolation alpha
+             * @param aDeltaTime The time elapsed since the last step, in seconds
+             * @param aJobSystem The job system running the systems
+             */
+            void step(double aDeltaTime, JobSystem &aJobSystem = JobSystem::getInstance());
+
+            /**
+             * @brief Step the World with the real time elapsed since the last tick, measured by the frame clock of the
+             * World
+             *
+             * @param aJobSystem The job system running the systems
+             */
+            void tick(JobSystem &aJobSystem = JobSystem::getInstance());
+
+            /**
+             * @brief Set the timestep of the Fixed stage
+             * @throw WorldException If the timestep isn't positive
+             * @param aFixedDeltaTime The timestep in seconds, 1/60 by default
+             * @param aMaxFixedSteps The most fixed steps run by a frame, 5 by default
+             */
+            void setFixedTimestep(double aFixedDeltaTime, std::size_t aMaxFixedSteps = 5);
+
+            [[nodiscard]] double getFixedTimestep() const noexcept
+            {
+                return _fixedDeltaTime;
             }
 
             /**
-             * @brief Run all the systems once
+             * @brief Get the time step of the running stage: the fixed timestep in the Fixed stage, the frame time
+             * given to step otherwise
              *
+             * @return double The delta time in seconds
              */
-            void runSystems();
+            [[nodiscard]] double getDeltaTime() const noexcept
+            {
+                return _frameTime.deltaTime;
+            }
+
+            /**
+             * @brief Get the timing of the current frame
+             */
+            [[nodiscard]] const FrameTime &getFrameTime() const noexcept
+            {
+                return _frameTime;
+            }
+
+            /**
+             * @brief Get the tick stamped on the components written now, see Query::changedSince
+             * @details The tick advances once per frame in step and runSystems. A system reading the changes keeps the
+             * tick of its last run and filters with it: it sees every write of the later frames, and the writes of its
+             * own frame made by the systems scheduled before it
+             *
+             * @return ISparseArray::tick The current tick
+             */
+            [[nodiscard]] ISparseArray::tick getChangeTick() const noexcept
+            {
+                return _changeTick;
+            }
+
+            /**
+             * @brief Advance the change tick, for the code writing components outside of step and runSystems
+             *
+             * @return ISparseArray::tick The new tick
+             */
+            ISparseArray::tick advanceChangeTick() noexcept
+            {
+                return ++_changeTick;
+            }
+
+            /**
+             * @brief Get the interpolation factor between the last fixed step and the next one
+             *
+             * @return double The alpha, in [0, 1)
+             */
+            [[nodiscard]] double getAlpha() const noexcept
+            {
+                return _frameTime.alpha;
+            }
+
+            /**
+             * @brief Get the names of the systems in the order of the schedule
+             * @throw WorldExceptionSystemCycle If the before / after constraints form a cycle
+             *
+             * @return const std::vector<std::string>& The names, a system never runs before the ones it
+             * conflicts with that come first
+             */
+            const std::vector<std::string> &getSystemOrder();
+
+            /**
+             * @brief Get the event manager of the World
+             * @details The events of a World are only seen by its systems, the app-level events go through the global
+             * bus (Event::EventManager::getInstance)
+             *
+             * @return Event::EventManager& The event manager owned by the World
+             */
+            Event::EventManager &getEventManager()
+            {
+                return *_eventManager;
+            }
+
+            /**
+             * @brief Get the event manager of the World
+             *
+             * @return const Event::EventManager& The event manager owned by the World
+             */
+            [[nodiscard]] const Event::EventManager &getEventManager() const
+            {
+                return *_eventManager;
+            }
+
+            /**
+             * @brief Get the command buffer of the calling thread, to record structural changes from a system or a
+             * query callback
+             * @details Each worker of the job system running the systems (or the last parallel query) has its own
+             * buffer, the other threads share one: only one thread outside the job system may record at a time.
+             * The commands are applied by flushCommands, which runSystems calls once every system is done
+             *
+             * @return CommandBuffer& The buffer of the calling thread
+             */
+            CommandBuffer &commands();
+
+            /**
+             * @brief Apply the commands recorded in every buffer, then clear the buffers
+             * @details The spawns are applied first so every pending handle can be resolved, then the component
+             * commands grouped per component (in recording order for a given component), then the kills. A command
+             * whose handle is stale is skipped: several systems may kill the same entity, and an entity killed before
+             * the flush doesn't get components back, nor does the entity reusing its index. Must not be called while
+             * systems or queries are running
+             * @throw Rethrows the first exception thrown by a command, the remaining commands are dropped
+             */
+            void flushCommands();
+
+            /**
+             * @brief Drop the commands recorded in every buffer without applying them
+             */
+            void clearCommands();
 
             /**
              * @brief Get the Current Id object
@@ -335,6 +1541,95 @@ namespace Engine::Core {
             [[nodiscard]] std::size_t getCurrentId() const;
 
         protected:
+            /**
+             * @brief Build the dependency graph of the systems, from their constraints and their accesses
+             */
+            void buildSchedule();
+
+            /**
+             * @brief Give one command buffer to each worker of the job system, must be called before running jobs
+             * recording commands
+             */
+            void prepareCommandBuffers(JobSystem &aJobSystem);
+
+            /**
+             * @brief Update the spatial index from the changed positions, see updateSpatial
+             */
+            template<ComponentConcept Position>
+            static void refreshSpatial(World &aWorld, JobSystem &aJobSystem)
+            {
+                // The positions written during the tick of the last update may have been written after it
+                const auto since = aWorld._spatialTick == 0 ? 0 : aWorld._spatialTick - 1;
+                const auto entities = aWorld.query<const Position>().changedSince(since).getAllEntities();
+                const auto &positions = std::as_const(aWorld.getComponent<Position>());
+                std::vector<Aabb> bounds(entities.size());
+
+                aJobSystem.parallelFor(0, entities.size(), 0,
+                                       [&entities, &positions, &bounds](std::size_t aBegin, std::size_t aEnd) {
+                                           for (auto slot = aBegin; slot < aEnd; slot++) {
+                                               bounds[slot] = SpatialTraits<Position>::bounds(
+                                                   positions.get(entities[slot]));
+                                           }
+                                       });
+                for (std::size_t slot = 0; slot < entities.size(); slot++) {
+                    aWorld._spatial->update(entities[slot], bounds[slot]);
+                }
+                aWorld._spatialTick = aWorld._changeTick;
+            }
+
+            /**
+             * @brief Move a component built by spawnBatch in its storage, linking a ChildOf in the Hierarchy
+             */
+            template<ComponentConcept Component>
+            void spawnComponent(StorageOf<Component> &aStorage, std::size_t aIndex, Component &&aComponent)
+            {
+                if constexpr (std::is_same_v<Component, ChildOf>) {
+                    _hierarchy.setParent(aIndex, checkAlive(aComponent.parent));
+                }
+                aStorage.emplace(aIndex, std::move(aComponent));
+            }
+
+            /**
+             * @brief Bind every storage to the signatures and the change tick of this World, after a move
+             */
+            void bindStorages() noexcept;
+
+            /**
+             * @brief Restore the World from a reader, see restore(std::span<const std::byte>, RestorePolicy)
+             * @details A reader with a backing lets the ColumnArray storages adopt the columns of the snapshot
+             */
+            void restore(SnapshotReader aReader, RestorePolicy aPolicy);
+
+            /**
+             * @brief Rebuild the Hierarchy from the ChildOf components, after a restore
+             * @throw SnapshotExceptionCorrupted If a parent is dead or the links form a cycle
+             */
+            void rebuildHierarchy();
+
+            /**
+             * @brief Get the index of a handle
+             * @throw WorldExceptionDeadEntity If the handle is stale
+             */
+            std::size_t checkAlive(Entity aEntity) const
+            {
+                if (!isAlive(aEntity)) {
+                    throw WorldExceptionDeadEntity("Stale entity handle: " + std::to_string(aEntity.index));
+                }
+                return aEntity.index;
+            }
+
+            /**
+             * @brief Create the storage of a component, on the memory resource of the World if the storage takes one
+             */
+            template<ComponentConcept Component>
+            std::unique_ptr<ISparseArray> makeStorage() const
+            {
+                if constexpr (std::is_constructible_v<StorageOf<Component>, std::pmr::memory_resource *>) {
+                    return std::make_unique<StorageOf<Component>>(_resource);
+                } else {
+                    return std::make_unique<StorageOf<Component>>();
+                }
+            }
 #pragma endregion methods
     };
 } // namespace Engine::Core
@@ -0,0 +1,122 @@
+#include "Core/Archetypes/Archetype.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace Engine::Core {
+    namespace {
+        std::size_t alignUp(std::size_t aOffset, std::size_t aAlignment)
+        {
+            return (aOffset + aAlignment - 1) / aAlignment * aAlignment;
+        }
+
+        std::size_t layoutSize(const std::vector<ComponentInfo> &aInfos, std::size_t aCapacity)
+        {
+            std::size_t offset = sizeof(std::size_t) * aCapacity;
+
+            for (const auto &info : aInfos) {
+                offset = alignUp(offset, info.alignment) + (info.size * aCapacity);
+            }
+            return offset;
+        }
+    } // namespace
+
+    Chunk::Chunk()
+        : _data(static_cast<std::byte *>(::operator new(chunkSize, std::align_val_t {chunkAlignment})))
+    {}
+
+    Chunk::~Chunk()
+    {
+        ::operator delete(_data, std::align_val_t {chunkAlignment});
+    }
+
+    Archetype::Archetype(std::vector<ComponentInfo> aInfos)
+        : _infos(std::move(aInfos))
+    {
+        std::size_t rowSize = sizeof(std::size_t);
+
+        for (const auto &info : _infos) {
+            _signature.push_back(info.id);
+            rowSize += info.size;
+        }
+        _capacity = Chunk::chunkSize / rowSize;
+        while (_capacity > 0 && layoutSize(_infos, _capacity) > Chunk::chunkSize) {
+            _capacity--;
+        }
+        if (_capacity == 0) {
+            throw ArchetypeExceptionRowTooLarge("The components of the archetype don't fit in a chunk");
+        }
+
+        std::size_t offset = sizeof(std::size_t) * _capacity;
+
+        for (const auto &info : _infos) {
+            offset = alignUp(offset, info.alignment);
+            _offsets.push_back(offset);
+            offset += info.size * _capacity;
+        }
+    }
+
+    Archetype::~Archetype()
+    {
+        for (std::size_t row = 0; row < _size; row++) {
+            for (std::size_t column = 0; column < _infos.size(); column++) {
+                _infos[column].destroy(componentAt(column, row));
+            }
+        }
+    }
+
+    std::size_t Archetype::columnOf(std::size_t aComponentId) const
+    {
+        const auto itx = std::lower_bound(_signature.begin(), _signature.end(), aComponentId);
+
+        if (itx == _signature.end() || *itx != aComponentId) {
+            return npos;
+        }
+        return static_cast<std::size_t>(itx - _signature.begin());
+    }
+
+    bool Archetype::matches(const signature &aRequired) const
+    {
+        return std::includes(_signature.begin(), _signature.end(), aRequired.begin(), aRequired.end());
+    }
+
+    std::size_t Archetype::pushRow(std::size_t aEntity)
+    {
+        if (_size == _chunks.size() * _capacity) {
+            _chunks.push_back(std::make_unique<Chunk>());
+        }
+        auto &chunk = *_chunks[_size / _capacity];
+
+        entitiesOf(chunk)[_size % _capacity] = aEntity;
+        chunk.setCount(chunk.count() + 1);
+        return _size++;
+    }
+
+    std::size_t Archetype::removeRow(std::size_t aRow)
+    {
+        const auto last = _size - 1;
+        auto moved = npos;
+
+        for (std::size_t column = 0; column < _infos.size(); column++) {
+            _infos[column].destroy(componentAt(column, aRow));
+        }
+        if (aRow != last) {
+            for (std::size_t column = 0; column < _infos.size(); column++) {
+                _infos[column].moveConstruct(componentAt(column, aRow), componentAt(column, last));
+                _infos[column].destroy(componentAt(column, last));
+            }
+            moved = entityAt(last);
+            entitiesOf(*_chunks[aRow / _capacity])[aRow % _capacity] = moved;
+        }
+
+        auto &lastChunk = *_chunks[last / _capacity];
+
+        lastChunk.setCount(lastChunk.count() - 1);
+        _size--;
+        // Keep one empty chunk around so an entity going back and forth doesn't allocate each time
+        while (_chunks.size() > 1 && _chunks[_chunks.size() - 2]->count() == 0) {
+            _chunks.pop_back();
+        }
+        return moved;
+    }
+} // namespace Engine::Core
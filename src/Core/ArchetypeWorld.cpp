@@ -0,0 +1,169 @@
+#include "ArchetypeWorld.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace Engine::Core {
+    ArchetypeWorld::ArchetypeWorld()
+    {
+        findOrCreateArchetype({});
+    }
+
+    ArchetypeWorld::id ArchetypeWorld::createEntity()
+    {
+        id newIdx = 0;
+
+        if (_ids.empty()) {
+            newIdx = _nextId;
+            _nextId++;
+            _locations.emplace_back();
+        } else {
+            newIdx = _ids.back();
+            _ids.pop_back();
+        }
+        spdlog::debug("Creating entity {}", newIdx);
+
+        auto *root = _archetypes.front().get();
+
+        _locations[newIdx] = EntityLocation {root, root->pushRow(newIdx)};
+        return newIdx;
+    }
+
+    void ArchetypeWorld::killEntity(id aIndex)
+    {
+        auto &location = locationOf(aIndex);
+        const auto moved = location.archetype->removeRow(location.row);
+
+        spdlog::debug("Killing entity {}", aIndex);
+        if (moved != Archetype::npos) {
+            _locations[moved].row = location.row;
+        }
+        location = EntityLocation {};
+        _ids.push_back(aIndex);
+    }
+
+    std::size_t ArchetypeWorld::getCurrentId() const
+    {
+        return _nextId;
+    }
+
+    std::size_t ArchetypeWorld::getArchetypeCount() const
+    {
+        return _archetypes.size();
+    }
+
+    const ArchetypeWorld::Stats &ArchetypeWorld::getStats() const
+    {
+        return _stats;
+    }
+
+    void ArchetypeWorld::resetStats()
+    {
+        _stats = Stats {};
+    }
+
+    ArchetypeWorld::EntityLocation &ArchetypeWorld::locationOf(id aIndex)
+    {
+        if (aIndex >= _locations.size() || _locations[aIndex].archetype == nullptr) {
+            throw ArchetypeWorldExceptionEntityNotFound("Entity not found: " + std::to_string(aIndex));
+        }
+        return _locations[aIndex];
+    }
+
+    const ArchetypeWorld::EntityLocation &ArchetypeWorld::locationOf(id aIndex) const
+    {
+        if (aIndex >= _locations.size() || _locations[aIndex].archetype == nullptr) {
+            throw ArchetypeWorldExceptionEntityNotFound("Entity not found: " + std::to_string(aIndex));
+        }
+        return _locations[aIndex];
+    }
+
+    Archetype *ArchetypeWorld::findOrCreateArchetype(const Archetype::signature &aSignature)
+    {
+        auto itx = _archetypeIndex.find(aSignature);
+
+        if (itx != _archetypeIndex.end()) {
+            return itx->second;
+        }
+
+        std::vector<ComponentInfo> infos;
+
+        infos.reserve(aSignature.size());
+        for (const auto componentId : aSignature) {
+            infos.push_back(_componentInfos[componentId]);
+        }
+        auto *archetype = _archetypes.emplace_back(std::make_unique<Archetype>(std::move(infos))).get();
+
+        _archetypeIndex[aSignature] = archetype;
+        return archetype;
+    }
+
+    Archetype *ArchetypeWorld::addEdge(Archetype &aSource, std::size_t aComponentId)
+    {
+        auto &edges = aSource.getAddEdges();
+        auto itx = edges.find(aComponentId);
+
+        if (itx != edges.end()) {
+            return itx->second;
+        }
+
+        auto signature = aSource.getSignature();
+
+        signature.insert(std::lower_bound(signature.begin(), signature.end(), aComponentId), aComponentId);
+
+        auto *destination = findOrCreateArchetype(signature);
+
+        edges[aComponentId] = destination;
+        destination->getRemoveEdges()[aComponentId] = &aSource;
+        return destination;
+    }
+
+    Archetype *ArchetypeWorld::removeEdge(Archetype &aSource, std::size_t aComponentId)
+    {
+        auto &edges = aSource.getRemoveEdges();
+        auto itx = edges.find(aComponentId);
+
+        if (itx != edges.end()) {
+            return itx->second;
+        }
+
+        auto signature = aSource.getSignature();
+
+        signature.erase(std::lower_bound(signature.begin(), signature.end(), aComponentId));
+
+        auto *destination = findOrCreateArchetype(signature);
+
+        edges[aComponentId] = destination;
+        destination->getAddEdges()[aComponentId] = &aSource;
+        return destination;
+    }
+
+    void ArchetypeWorld::moveEntity(id aIndex, Archetype &aDestination)
+    {
+        auto &location = _locations[aIndex];
+        auto &source = *location.archetype;
+        const auto row = aDestination.pushRow(aIndex);
+        const auto &infos = source.getInfos();
+
+        for (std::size_t column = 0; column < infos.size(); column++) {
+            const auto destinationColumn = aDestination.columnOf(infos[column].id);
+
+            if (destinationColumn == Archetype::npos) {
+                continue;
+            }
+            infos[column].moveConstruct(aDestination.componentAt(destinationColumn, row),
+                                        source.componentAt(column, location.row));
+            _stats.componentsMoved++;
+            _stats.bytesMoved += infos[column].size;
+        }
+
+        const auto moved = source.removeRow(location.row);
+
+        if (moved != Archetype::npos) {
+            _locations[moved].row = location.row;
+        }
+        location = EntityLocation {&aDestination, row};
+        _stats.moves++;
+    }
+} // namespace Engine::Core
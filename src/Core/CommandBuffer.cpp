@@ -0,0 +1,41 @@
+#include "Core/Commands/CommandBuffer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace Engine::Core {
+    void CommandBuffer::clear()
+    {
+        for (const auto &command : _commands) {
+            if (command.destroy != nullptr) {
+                command.destroy(command.payload);
+            }
+        }
+        _commands.clear();
+        _kills.clear();
+        _spawns = 0;
+        for (auto &block : _blocks) {
+            block.used = 0;
+        }
+        _currentBlock = 0;
+    }
+
+    void *CommandBuffer::allocate(std::size_t aSize, std::size_t aAlignment)
+    {
+        for (; _currentBlock < _blocks.size(); _currentBlock++) {
+            auto &block = _blocks[_currentBlock];
+            const auto address = reinterpret_cast<std::uintptr_t>(block.data.get()) + block.used;
+            const auto padding = (aAlignment - address % aAlignment) % aAlignment;
+
+            if (block.used + padding + aSize <= block.size) {
+                block.used += padding + aSize;
+                return block.data.get() + block.used - aSize;
+            }
+        }
+        // The padding of the worst case alignment is included so an oversized component fits its own block
+        const auto size = std::max(blockSize, aSize + aAlignment);
+
+        _blocks.push_back(Block {std::make_unique<std::byte[]>(size), size, 0});
+        return allocate(aSize, aAlignment);
+    }
+} // namespace Engine::Core
@@ -0,0 +1,82 @@
+#include "Core/Memory/FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace Engine::Core {
+    void FrameArena::nextFrame()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto next = 1 - _active.load(std::memory_order_relaxed);
+        auto &half = _halves[next];
+
+        for (auto &block : half.blocks) {
+            block->used.store(0, std::memory_order_relaxed);
+        }
+        half.currentBlock = 0;
+        half.current.store(half.blocks.empty() ? nullptr : half.blocks.front().get(), std::memory_order_release);
+        _active.store(next, std::memory_order_release);
+    }
+
+    std::size_t FrameArena::capacity()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::size_t total = 0;
+
+        for (const auto &half : _halves) {
+            for (const auto &block : half.blocks) {
+                total += block->size;
+            }
+        }
+        return total;
+    }
+
+    void *FrameArena::do_allocate(std::size_t aSize, std::size_t aAlignment)
+    {
+        auto &half = _halves[_active.load(std::memory_order_acquire)];
+        // Reserving the worst case padding lets the offset be bumped before knowing the address
+        const auto reserved = aSize + aAlignment - 1;
+
+        while (true) {
+            auto *block = half.current.load(std::memory_order_acquire);
+
+            if (block != nullptr) {
+                const auto offset = block->used.fetch_add(reserved, std::memory_order_relaxed);
+
+                if (offset + reserved <= block->size) {
+                    const auto address = reinterpret_cast<std::uintptr_t>(block->data.get()) + offset;
+
+                    return block->data.get() + offset + (aAlignment - address % aAlignment) % aAlignment;
+                }
+            }
+            nextBlock(half, block, reserved);
+        }
+    }
+
+    void FrameArena::nextBlock(Half &aHalf, Block *aFull, std::size_t aSize)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Another thread already moved the half past the full block
+        if (aHalf.current.load(std::memory_order_acquire) != aFull) {
+            return;
+        }
+        if (aFull != nullptr) {
+            aHalf.currentBlock++;
+        }
+        // The blocks kept from the previous frames are reused when they are large enough
+        while (aHalf.currentBlock < aHalf.blocks.size() && aHalf.blocks[aHalf.currentBlock]->size < aSize) {
+            aHalf.currentBlock++;
+        }
+        if (aHalf.currentBlock >= aHalf.blocks.size()) {
+            const auto size = std::max(blockSize, aSize);
+            auto block = std::make_unique<Block>();
+
+            block->data = std::make_unique<std::byte[]>(size);
+            block->size = size;
+            aHalf.currentBlock = aHalf.blocks.size();
+            aHalf.blocks.push_back(std::move(block));
+        }
+        aHalf.blocks[aHalf.currentBlock]->used.store(0, std::memory_order_relaxed);
+        aHalf.current.store(aHalf.blocks[aHalf.currentBlock].get(), std::memory_order_release);
+    }
+} // namespace Engine::Core
@@ -0,0 +1,144 @@
+#include "Core/Spatial/HashGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine::Core {
+    namespace {
+        /**
+         * @brief The cells are kept in this range, so the cell count of any range fits in a std::size_t
+         */
+        constexpr double cellLimit = 1 << 30;
+
+        void eraseFrom(std::vector<std::size_t> &aEntities, std::size_t aEntity)
+        {
+            const auto found = std::ranges::find(aEntities, aEntity);
+
+            *found = aEntities.back();
+            aEntities.pop_back();
+        }
+    } // namespace
+
+    HashGrid::HashGrid(float aCellSize)
+        : _cellSize(aCellSize)
+    {
+        if (!(aCellSize > 0)) {
+            throw SpatialException("The cell size of a hash grid must be positive");
+        }
+    }
+
+    void HashGrid::queryAABB(const Aabb &aBox, std::vector<id> &aEntities) const
+    {
+        const auto range = rangeOf(aBox);
+        const auto visit = [this, &aBox, &aEntities, &range](std::int32_t aX, std::int32_t aY,
+                                                             const std::vector<id> &aCell) {
+            for (const auto entity : aCell) {
+                const auto &entityRange = _ranges[entity];
+
+                // Only reported by the first cell it shares with the query
+                if (aX == std::max(entityRange.minX, range.minX) && aY == std::max(entityRange.minY, range.minY)
+                    && _bounds[entity].overlaps(aBox)) {
+                    aEntities.push_back(entity);
+                }
+            }
+        };
+
+        for (const auto entity : _oversized) {
+            if (_bounds[entity].overlaps(aBox)) {
+                aEntities.push_back(entity);
+            }
+        }
+        if (range.count() > _cells.size()) {
+            for (const auto &[cellKey, cell] : _cells) {
+                const auto x = static_cast<std::int32_t>(static_cast<std::uint32_t>(cellKey >> 32));
+                const auto y = static_cast<std::int32_t>(static_cast<std::uint32_t>(cellKey));
+
+                if (x >= range.minX && x <= range.maxX && y >= range.minY && y <= range.maxY) {
+                    visit(x, y, cell);
+                }
+            }
+            return;
+        }
+        for (auto x = range.minX; x <= range.maxX; x++) {
+            for (auto y = range.minY; y <= range.maxY; y++) {
+                if (const auto cell = _cells.find(key(x, y)); cell != _cells.end()) {
+                    visit(x, y, cell->second);
+                }
+            }
+        }
+    }
+
+    void HashGrid::insertEntity(id aEntity)
+    {
+        if (aEntity >= _ranges.size()) {
+            _ranges.resize(aEntity + 1);
+        }
+        _ranges[aEntity] = rangeOf(_bounds[aEntity]);
+        link(aEntity, _ranges[aEntity]);
+    }
+
+    void HashGrid::moveEntity(id aEntity, const Aabb & /*previous*/)
+    {
+        const auto range = rangeOf(_bounds[aEntity]);
+
+        // Most moves stay in the same cells
+        if (range == _ranges[aEntity]) {
+            return;
+        }
+        unlink(aEntity, _ranges[aEntity]);
+        _ranges[aEntity] = range;
+        link(aEntity, range);
+    }
+
+    void HashGrid::eraseEntity(id aEntity)
+    {
+        unlink(aEntity, _ranges[aEntity]);
+    }
+
+    void HashGrid::clearEntities()
+    {
+        _cells.clear();
+        _ranges.clear();
+        _oversized.clear();
+    }
+
+    HashGrid::CellRange HashGrid::rangeOf(const Aabb &aBox) const noexcept
+    {
+        const auto cell = [this](float aCoordinate) {
+            return static_cast<std::int32_t>(
+                std::clamp(std::floor(static_cast<double>(aCoordinate) / _cellSize), -cellLimit, cellLimit));
+        };
+
+        return CellRange {cell(aBox.minX), cell(aBox.minY), cell(aBox.maxX), cell(aBox.maxY)};
+    }
+
+    void HashGrid::link(id aEntity, const CellRange &aRange)
+    {
+        if (aRange.count() > maxCellsPerEntity) {
+            _oversized.push_back(aEntity);
+            return;
+        }
+        for (auto x = aRange.minX; x <= aRange.maxX; x++) {
+            for (auto y = aRange.minY; y <= aRange.maxY; y++) {
+                _cells[key(x, y)].push_back(aEntity);
+            }
+        }
+    }
+
+    void HashGrid::unlink(id aEntity, const CellRange &aRange)
+    {
+        if (aRange.count() > maxCellsPerEntity) {
+            eraseFrom(_oversized, aEntity);
+            return;
+        }
+        for (auto x = aRange.minX; x <= aRange.maxX; x++) {
+            for (auto y = aRange.minY; y <= aRange.maxY; y++) {
+                const auto cell = _cells.find(key(x, y));
+
+                eraseFrom(cell->second, aEntity);
+                if (cell->second.empty()) {
+                    _cells.erase(cell);
+                }
+            }
+        }
+    }
+} // namespace Engine::Core
@@ -0,0 +1,143 @@
+#include "Core/Relations/Hierarchy.hpp"
+#include <algorithm>
+#include <string>
+
+namespace Engine::Core {
+    void Hierarchy::setParent(id aChild, id aParent)
+    {
+        grow(std::max(aChild, aParent));
+        for (auto ancestor = aParent; ancestor != npos; ancestor = _parents[ancestor]) {
+            if (ancestor == aChild) {
+                throw HierarchyExceptionCycle("Entity " + std::to_string(aChild) + " can't be a child of "
+                                              + std::to_string(aParent) + ", it is one of its ancestors");
+            }
+        }
+        if (_parents[aChild] == aParent) {
+            return;
+        }
+        if (_parents[aChild] != npos) {
+            unlink(aChild);
+        }
+        _parents[aChild] = aParent;
+        _childSlots[aChild] = _children[aParent].size();
+        _children[aParent].push_back(aChild);
+        shiftSubtree(aChild, static_cast<std::ptrdiff_t>(_depths[aParent] + 1)
+                                 - static_cast<std::ptrdiff_t>(_depths[aChild]));
+    }
+
+    void Hierarchy::removeParent(id aChild)
+    {
+        if (getParent(aChild) == npos) {
+            return;
+        }
+        unlink(aChild);
+        shiftSubtree(aChild, -static_cast<std::ptrdiff_t>(_depths[aChild]));
+    }
+
+    void Hierarchy::remove(id aEntity)
+    {
+        if (aEntity >= _parents.size()) {
+            return;
+        }
+        while (!_children[aEntity].empty()) {
+            removeParent(_children[aEntity].back());
+        }
+        removeParent(aEntity);
+    }
+
+    void Hierarchy::collectDescendants(id aEntity, std::vector<id> &aDescendants) const
+    {
+        const auto first = aDescendants.size();
+        const auto children = getChildren(aEntity);
+
+        aDescendants.insert(aDescendants.end(), children.begin(), children.end());
+        for (auto idx = first; idx < aDescendants.size(); idx++) {
+            const auto grandChildren = getChildren(aDescendants[idx]);
+
+            aDescendants.insert(aDescendants.end(), grandChildren.begin(), grandChildren.end());
+        }
+    }
+
+    void Hierarchy::clear()
+    {
+        _parents.clear();
+        _depths.clear();
+        _levelSlots.clear();
+        _childSlots.clear();
+        _children.clear();
+        _levels.clear();
+    }
+
+    void Hierarchy::grow(id aEntity)
+    {
+        if (aEntity < _parents.size()) {
+            return;
+        }
+        _parents.resize(aEntity + 1, npos);
+        _depths.resize(aEntity + 1, 0);
+        _levelSlots.resize(aEntity + 1, 0);
+        _childSlots.resize(aEntity + 1, 0);
+        _children.resize(aEntity + 1);
+    }
+
+    void Hierarchy::shiftSubtree(id aEntity, std::ptrdiff_t aShift)
+    {
+        if (aShift == 0) {
+            return;
+        }
+        std::vector<id> pending {aEntity};
+
+        // Only the moved subtree is visited, the rest of the levels is untouched
+        while (!pending.empty()) {
+            const auto entity = pending.back();
+            const auto depth = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(_depths[entity]) + aShift);
+
+            pending.pop_back();
+            if (_depths[entity] != 0) {
+                leaveLevel(entity);
+            }
+            _depths[entity] = depth;
+            if (depth != 0) {
+                enterLevel(entity, depth);
+            }
+            pending.insert(pending.end(), _children[entity].begin(), _children[entity].end());
+        }
+        while (!_levels.empty() && _levels.back().empty()) {
+            _levels.pop_back();
+        }
+    }
+
+    void Hierarchy::enterLevel(id aEntity, std::size_t aDepth)
+    {
+        if (_levels.size() < aDepth) {
+            _levels.resize(aDepth);
+        }
+        auto &level = _levels[aDepth - 1];
+
+        _levelSlots[aEntity] = level.size();
+        level.push_back(aEntity);
+    }
+
+    void Hierarchy::leaveLevel(id aEntity)
+    {
+        auto &level = _levels[_depths[aEntity] - 1];
+        const auto slot = _levelSlots[aEntity];
+        const auto last = level.back();
+
+        level[slot] = last;
+        _levelSlots[last] = slot;
+        level.pop_back();
+    }
+
+    void Hierarchy::unlink(id aChild)
+    {
+        auto &siblings = _children[_parents[aChild]];
+        const auto slot = _childSlots[aChild];
+        const auto last = siblings.back();
+
+        siblings[slot] = last;
+        _childSlots[last] = slot;
+        siblings.pop_back();
+        _parents[aChild] = npos;
+    }
+} // namespace Engine::Core
@@ -0,0 +1,173 @@
+#include "Core/Jobs/JobSystem.hpp"
+#include <chrono>
+#include <utility>
+
+namespace Engine::Core {
+    namespace {
+        thread_local const JobSystem *currentSystem = nullptr;
+        thread_local std::size_t currentWorker = JobSystem::npos;
+    } // namespace
+
+    JobSystem::JobSystem(std::size_t aThreadCount)
+        : _workerCount(std::max<std::size_t>(1, aThreadCount))
+    {
+        // One queue per worker, the last one is shared by the threads outside the pool
+        for (std::size_t idx = 0; idx <= _workerCount; idx++) {
+            _queues.push_back(std::make_unique<Queue>());
+        }
+        _threads.reserve(_workerCount);
+        for (std::size_t idx = 0; idx < _workerCount; idx++) {
+            _threads.emplace_back(&JobSystem::workerLoop, this, idx);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+
+            _running = false;
+        }
+        _wakeUp.notify_all();
+        for (auto &thread : _threads) {
+            thread.join();
+        }
+    }
+
+    JobSystem &JobSystem::getInstance()
+    {
+        static JobSystem instance;
+
+        return instance;
+    }
+
+    std::size_t JobSystem::getThreadCount() const
+    {
+        return _workerCount;
+    }
+
+    std::size_t JobSystem::getCurrentWorker() const
+    {
+        return currentSystem == this ? currentWorker : npos;
+    }
+
+    void JobSystem::submit(job aJob, JobCounter &aCounter)
+    {
+        const auto worker = getCurrentWorker();
+
+        push(*_queues[worker == npos ? _workerCount : worker], std::move(aJob), aCounter, false);
+    }
+
+    void JobSystem::submitTo(std::size_t aWorker, job aJob, JobCounter &aCounter)
+    {
+        push(*_queues[aWorker % _workerCount], std::move(aJob), aCounter, true);
+    }
+
+    void JobSystem::wait(JobCounter &aCounter)
+    {
+        const auto worker = getCurrentWorker();
+
+        while (!aCounter.done()) {
+            if (!runOne(worker)) {
+                std::this_thread::yield();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(aCounter._mutex);
+
+        if (aCounter._exception) {
+            std::rethrow_exception(std::exchange(aCounter._exception, nullptr));
+        }
+    }
+
+    void JobSystem::push(Queue &aQueue, job aJob, JobCounter &aCounter, bool aPinned)
+    {
+        aCounter._pending.fetch_add(1, std::memory_order_relaxed);
+
+        auto wrapped = [func = std::move(aJob), &aCounter] {
+            try {
+                func();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(aCounter._mutex);
+
+                if (!aCounter._exception) {
+                    aCounter._exception = std::current_exception();
+                }
+            }
+            aCounter._pending.fetch_sub(1, std::memory_order_acq_rel);
+        };
+        {
+            std::lock_guard<std::mutex> lock(aQueue.mutex);
+
+            (aPinned ? aQueue.pinned : aQueue.jobs).emplace_back(std::move(wrapped));
+        }
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+
+            (aPinned ? aQueue.pinnedCount : _queued).fetch_add(1, std::memory_order_release);
+        }
+        if (aPinned) {
+            _wakeUp.notify_all();
+        } else {
+            _wakeUp.notify_one();
+        }
+    }
+
+    bool JobSystem::popFrom(Queue &aQueue, bool aOwner, bool aPinned, job &aJob)
+    {
+        std::lock_guard<std::mutex> lock(aQueue.mutex);
+        auto &jobs = aPinned ? aQueue.pinned : aQueue.jobs;
+
+        if (jobs.empty()) {
+            return false;
+        }
+        if (aOwner) {
+            aJob = std::move(jobs.back());
+            jobs.pop_back();
+        } else {
+            aJob = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        (aPinned ? aQueue.pinnedCount : _queued).fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool JobSystem::runOne(std::size_t aWorker)
+    {
+        job current;
+        const auto shared = _workerCount;
+        bool found = false;
+
+        if (aWorker != npos) {
+            found = popFrom(*_queues[aWorker], true, true, current) || popFrom(*_queues[aWorker], true, false, current);
+        }
+        found = found || popFrom(*_queues[shared], false, false, current);
+        for (std::size_t offset = 1; !found && offset <= shared; offset++) {
+            const auto victim = ((aWorker == npos ? 0 : aWorker) + offset) % shared;
+
+            found = popFrom(*_queues[victim], false, false, current);
+        }
+        if (found) {
+            current();
+        }
+        return found;
+    }
+
+    void JobSystem::workerLoop(std::size_t aWorker)
+    {
+        currentSystem = this;
+        currentWorker = aWorker;
+        while (_running) {
+            if (runOne(aWorker)) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+
+            _wakeUp.wait_for(lock, std::chrono::milliseconds(1), [this, &queue = *_queues[aWorker]] {
+                return !_running || _queued.load(std::memory_order_acquire) > 0
+                       || queue.pinnedCount.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+} // namespace Engine::Core
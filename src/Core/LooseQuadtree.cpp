@@ -0,0 +1,156 @@
+#include "Core/Spatial/LooseQuadtree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace Engine::Core {
+    LooseQuadtree::LooseQuadtree(const Aabb &aArea, std::size_t aDepth)
+        : _area(aArea),
+          _depth(aDepth)
+    {
+        if (!(aArea.maxX > aArea.minX) || !(aArea.maxY > aArea.minY)) {
+            throw SpatialException("The area of a loose quadtree can't be empty");
+        }
+        if (aDepth > maxDepth) {
+            throw SpatialException("The depth of a loose quadtree can't exceed " + std::to_string(maxDepth));
+        }
+        _nodes.resize(aDepth + 1);
+        for (std::size_t depth = 0; depth <= aDepth; depth++) {
+            _nodes[depth].resize(std::size_t(1) << (2 * depth));
+        }
+        _depthCounts.resize(aDepth + 1, 0);
+    }
+
+    void LooseQuadtree::queryAABB(const Aabb &aBox, std::vector<id> &aEntities) const
+    {
+        const auto width = static_cast<double>(_area.maxX) - _area.minX;
+        const auto height = static_cast<double>(_area.maxY) - _area.minY;
+
+        for (const auto entity : _outside) {
+            if (_bounds[entity].overlaps(aBox)) {
+                aEntities.push_back(entity);
+            }
+        }
+        for (std::size_t depth = 0; depth <= _depth; depth++) {
+            if (_depthCounts[depth] == 0) {
+                continue;
+            }
+            const auto side = std::size_t(1) << depth;
+            const auto last = static_cast<double>(side - 1);
+            // The loose bounds of a cell reach half a cell past it on each side
+            const auto minX = std::ceil((aBox.minX - _area.minX) / width * static_cast<double>(side) - 1.5);
+            const auto minY = std::ceil((aBox.minY - _area.minY) / height * static_cast<double>(side) - 1.5);
+            const auto maxX = std::floor((aBox.maxX - _area.minX) / width * static_cast<double>(side) + 0.5);
+            const auto maxY = std::floor((aBox.maxY - _area.minY) / height * static_cast<double>(side) + 0.5);
+
+            if (maxX < 0 || maxY < 0 || minX > last || minY > last) {
+                continue;
+            }
+            const auto cell = [last](double aCoordinate) {
+                return static_cast<std::size_t>(std::clamp(aCoordinate, 0.0, last));
+            };
+
+            for (auto y = cell(minY); y <= cell(maxY); y++) {
+                for (auto x = cell(minX); x <= cell(maxX); x++) {
+                    for (const auto entity : _nodes[depth][y * side + x]) {
+                        if (_bounds[entity].overlaps(aBox)) {
+                            aEntities.push_back(entity);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LooseQuadtree::insertEntity(id aEntity)
+    {
+        if (aEntity >= _locations.size()) {
+            _locations.resize(aEntity + 1);
+        }
+        link(aEntity, locate(_bounds[aEntity]));
+    }
+
+    void LooseQuadtree::moveEntity(id aEntity, const Aabb & /*previous*/)
+    {
+        const auto location = locate(_bounds[aEntity]);
+
+        // A move inside the loose bounds of the node keeps the entity where it is
+        if (location.depth == _locations[aEntity].depth && location.cell == _locations[aEntity].cell) {
+            return;
+        }
+        unlink(aEntity);
+        link(aEntity, location);
+    }
+
+    void LooseQuadtree::eraseEntity(id aEntity)
+    {
+        unlink(aEntity);
+    }
+
+    void LooseQuadtree::clearEntities()
+    {
+        for (auto &nodes : _nodes) {
+            for (auto &node : nodes) {
+                node.clear();
+            }
+        }
+        std::ranges::fill(_depthCounts, 0);
+        _locations.clear();
+        _outside.clear();
+    }
+
+    LooseQuadtree::Location LooseQuadtree::locate(const Aabb &aBounds) const noexcept
+    {
+        auto width = static_cast<double>(_area.maxX) - _area.minX;
+        auto height = static_cast<double>(_area.maxY) - _area.minY;
+        const auto sizeX = static_cast<double>(aBounds.maxX) - aBounds.minX;
+        const auto sizeY = static_cast<double>(aBounds.maxY) - aBounds.minY;
+        const auto centerX = (static_cast<double>(aBounds.minX) + aBounds.maxX) / 2;
+        const auto centerY = (static_cast<double>(aBounds.minY) + aBounds.maxY) / 2;
+
+        // Written so a NaN coordinate ends up outside
+        if (!(centerX >= _area.minX && centerX <= _area.maxX && centerY >= _area.minY && centerY <= _area.maxY
+              && sizeX <= width && sizeY <= height)) {
+            return Location {outside, 0, 0};
+        }
+        std::size_t depth = 0;
+
+        // The deepest node whose cell is as big as the entity
+        while (depth < _depth && sizeX * 2 <= width && sizeY * 2 <= height) {
+            depth++;
+            width /= 2;
+            height /= 2;
+        }
+        const auto side = std::size_t(1) << depth;
+        const auto x = std::min(side - 1, static_cast<std::size_t>((centerX - _area.minX) / width));
+        const auto y = std::min(side - 1, static_cast<std::size_t>((centerY - _area.minY) / height));
+
+        return Location {depth, y * side + x, 0};
+    }
+
+    void LooseQuadtree::link(id aEntity, Location aLocation)
+    {
+        auto &node = aLocation.depth == outside ? _outside : _nodes[aLocation.depth][aLocation.cell];
+
+        aLocation.slot = node.size();
+        node.push_back(aEntity);
+        if (aLocation.depth != outside) {
+            _depthCounts[aLocation.depth]++;
+        }
+        _locations[aEntity] = aLocation;
+    }
+
+    void LooseQuadtree::unlink(id aEntity)
+    {
+        const auto location = _locations[aEntity];
+        auto &node = location.depth == outside ? _outside : _nodes[location.depth][location.cell];
+        const auto last = node.back();
+
+        node[location.slot] = last;
+        _locations[last].slot = location.slot;
+        node.pop_back();
+        if (location.depth != outside) {
+            _depthCounts[location.depth]--;
+        }
+    }
+} // namespace Engine::Core
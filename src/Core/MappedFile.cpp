@@ -0,0 +1,92 @@
+#include "Core/Serialization/MappedFile.hpp"
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define STELLAR_HAS_MMAP 1
+#else
+    #define STELLAR_HAS_MMAP 0
+#endif
+
+namespace Engine::Core {
+    MappedFile::MappedFile(const std::filesystem::path &aPath)
+    {
+#if STELLAR_HAS_MMAP
+        const int file = ::open(aPath.c_str(), O_RDONLY);
+        struct stat info {};
+
+        if (file < 0 || ::fstat(file, &info) != 0) {
+            if (file >= 0) {
+                ::close(file);
+            }
+            throw SnapshotExceptionFile("Can't open " + aPath.string());
+        }
+        _size = static_cast<std::size_t>(info.st_size);
+        if (_size != 0) {
+            // A private writable mapping of a read-only file: the written pages are copied, never written back
+            void *data = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+
+            if (data != MAP_FAILED) {
+                _data = static_cast<std::byte *>(data);
+                _mapped = true;
+            }
+        }
+        // The mapping keeps its own reference on the file
+        ::close(file);
+        if (_mapped || _size == 0) {
+            return;
+        }
+#endif
+        std::ifstream stream(aPath, std::ios::binary);
+
+        if (!stream) {
+            throw SnapshotExceptionFile("Can't open " + aPath.string());
+        }
+        _fallback.resize(static_cast<std::size_t>(std::filesystem::file_size(aPath)));
+        if (!stream.read(reinterpret_cast<char *>(_fallback.data()), static_cast<std::streamsize>(_fallback.size()))) {
+            throw SnapshotExceptionFile("Can't read " + aPath.string());
+        }
+        _data = _fallback.data();
+        _size = _fallback.size();
+    }
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _mapped(std::exchange(other._mapped, false)),
+          _fallback(std::move(other._fallback))
+    {}
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other) {
+            unmap();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _mapped = std::exchange(other._mapped, false);
+            _fallback = std::move(other._fallback);
+        }
+        return *this;
+    }
+
+    void MappedFile::unmap() noexcept
+    {
+#if STELLAR_HAS_MMAP
+        if (_mapped) {
+            ::munmap(_data, _size);
+        }
+#endif
+        _data = nullptr;
+        _size = 0;
+        _mapped = false;
+    }
+} // namespace Engine::Core
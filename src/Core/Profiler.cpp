@@ -0,0 +1,206 @@
+#include "Core/Profiling/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace Engine::Core {
+    namespace {
+        thread_local void *currentRing = nullptr;
+
+        void writeEscaped(std::ostream &aStream, std::string_view aString)
+        {
+            for (const auto chr : aString) {
+                if (chr == '"' || chr == '\\') {
+                    aStream << '\\' << chr;
+                } else if (static_cast<unsigned char>(chr) < ' ') {
+                    aStream << ' ';
+                } else {
+                    aStream << chr;
+                }
+            }
+        }
+
+        /**
+         * @brief Write nanoseconds as microseconds with a fixed 3-digit fraction, exact at any magnitude
+         */
+        void writeMicroseconds(std::ostream &aStream, std::int64_t aNanoseconds)
+        {
+            constexpr std::int64_t microsecond = 1000;
+
+            if (aNanoseconds < 0) {
+                aStream << '-';
+                aNanoseconds = -aNanoseconds;
+            }
+            aStream << aNanoseconds / microsecond << '.' << std::setw(3) << std::setfill('0')
+                    << aNanoseconds % microsecond << std::setfill(' ');
+        }
+    } // namespace
+
+    Profiler &Profiler::getInstance()
+    {
+        static Profiler instance;
+
+        return instance;
+    }
+
+    Profiler::nameId Profiler::intern(std::string_view aName)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto found = std::ranges::find(_names, aName);
+
+        if (found != _names.end()) {
+            return static_cast<nameId>(found - _names.begin());
+        }
+        _names.emplace_back(aName);
+        return static_cast<nameId>(_names.size() - 1);
+    }
+
+    std::string Profiler::getName(nameId aName) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return aName < _names.size() ? _names[aName] : std::string();
+    }
+
+    Profiler::Ring &Profiler::getRing()
+    {
+        if (currentRing == nullptr) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto ring = std::make_shared<Ring>();
+
+            ring->thread = static_cast<std::uint32_t>(_rings.size());
+            _rings.push_back(ring);
+            currentRing = ring.get();
+        }
+        return *static_cast<Ring *>(currentRing);
+    }
+
+    void Profiler::record(ProfileSample aSample)
+    {
+        auto &ring = getRing();
+        const auto head = ring.head.load(std::memory_order_relaxed);
+
+        aSample.thread = ring.thread;
+        ring.samples[head % ringCapacity] = aSample;
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    std::vector<ProfileSample> Profiler::getSamples() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<ProfileSample> samples;
+
+        for (const auto &ring : _rings) {
+            const auto head = ring->head.load(std::memory_order_acquire);
+
+            for (auto idx = head - std::min<std::uint64_t>(head, ringCapacity); idx < head; idx++) {
+                samples.push_back(ring->samples[idx % ringCapacity]);
+            }
+        }
+        std::ranges::sort(samples, {}, &ProfileSample::start);
+        return samples;
+    }
+
+    ProfileStats Profiler::getStats(std::string_view aName) const
+    {
+        const auto samples = getSamples();
+        nameId name = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const auto found = std::ranges::find(_names, aName);
+
+            if (found == _names.end()) {
+                return {};
+            }
+            name = static_cast<nameId>(found - _names.begin());
+        }
+
+        std::vector<std::int64_t> durations;
+        std::vector<std::uint64_t> frames;
+        std::size_t entities = 0;
+
+        for (const auto &sample : samples) {
+            if (sample.name == name) {
+                durations.push_back(sample.duration);
+                frames.push_back(sample.frame);
+                entities += sample.entities;
+            }
+        }
+        if (durations.empty()) {
+            return {};
+        }
+        std::ranges::sort(durations);
+        std::ranges::sort(frames);
+
+        constexpr double nanoseconds = 1e9;
+        const auto calls = durations.size();
+        const auto p99 = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(calls))) - 1;
+        double total = 0;
+        ProfileStats stats;
+
+        for (const auto duration : durations) {
+            total += static_cast<double>(duration);
+        }
+        stats.calls = calls;
+        const auto uniqueFrames = std::ranges::unique(frames);
+
+        stats.frames = static_cast<std::size_t>(std::ranges::distance(frames.begin(), uniqueFrames.begin()));
+        stats.minTime = static_cast<double>(durations.front()) / nanoseconds;
+        stats.averageTime = total / static_cast<double>(calls) / nanoseconds;
+        stats.p99Time = static_cast<double>(durations[p99]) / nanoseconds;
+        stats.maxTime = static_cast<double>(durations.back()) / nanoseconds;
+        stats.entitiesPerCall = static_cast<double>(entities) / static_cast<double>(calls);
+        stats.callsPerFrame = static_cast<double>(calls) / static_cast<double>(stats.frames);
+        return stats;
+    }
+
+    void Profiler::writeChromeTrace(std::ostream &aStream) const
+    {
+        const auto samples = getSamples();
+        std::vector<std::string> names;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            names = _names;
+        }
+
+        bool first = true;
+
+        aStream << "{\"traceEvents\":[";
+        for (const auto &sample : samples) {
+            aStream << (first ? "" : ",") << "\n{\"name\":\"";
+            writeEscaped(aStream, sample.name < names.size() ? names[sample.name] : std::string_view());
+            // Written from the integer nanoseconds: a double at the default precision rounds past a few seconds
+            aStream << "\",\"cat\":\"system\",\"ph\":\"X\",\"pid\":1,\"tid\":" << sample.thread << ",\"ts\":";
+            writeMicroseconds(aStream, sample.start);
+            aStream << ",\"dur\":";
+            writeMicroseconds(aStream, sample.duration);
+            aStream << ",\"args\":{\"frame\":" << sample.frame << ",\"entities\":" << sample.entities << "}}";
+            first = false;
+        }
+        aStream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    void Profiler::writeChromeTrace(const std::filesystem::path &aPath) const
+    {
+        std::ofstream file(aPath);
+
+        if (!file) {
+            throw ProfilerException("Can't open " + aPath.string());
+        }
+        writeChromeTrace(file);
+        if (!file) {
+            throw ProfilerException("Can't write " + aPath.string());
+        }
+    }
+
+    void Profiler::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (const auto &ring : _rings) {
+            ring->head.store(0, std::memory_order_relaxed);
+        }
+    }
+} // namespace Engine::Core
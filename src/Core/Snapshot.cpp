@@ -0,0 +1,90 @@
+#include "Core/Serialization/Snapshot.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <string>
+
+namespace Engine::Core {
+    namespace {
+        bool isWordChar(char aChar)
+        {
+            return std::isalnum(static_cast<unsigned char>(aChar)) != 0 || aChar == '_';
+        }
+    } // namespace
+
+    void SnapshotWriter::write(const void *aData, std::size_t aSize)
+    {
+        if (aSize != 0) {
+            std::memcpy(grow(aSize), aData, aSize);
+        }
+    }
+
+    std::byte *SnapshotWriter::grow(std::size_t aSize)
+    {
+        const auto offset = _buffer.size();
+
+        _buffer.resize(offset + aSize);
+        return _buffer.data() + offset;
+    }
+
+    void SnapshotWriter::align()
+    {
+        _buffer.resize((_buffer.size() + snapshotAlignment - 1) / snapshotAlignment * snapshotAlignment);
+    }
+
+    std::span<const std::byte> SnapshotReader::read(std::size_t aSize)
+    {
+        if (aSize > _data.size() - _offset) {
+            throw SnapshotExceptionCorrupted("Unexpected end of snapshot at offset " + std::to_string(_offset));
+        }
+        _offset += aSize;
+        return _data.subspan(_offset - aSize, aSize);
+    }
+
+    void SnapshotReader::align()
+    {
+        seek((_offset + snapshotAlignment - 1) / snapshotAlignment * snapshotAlignment);
+    }
+
+    void SnapshotReader::seek(std::size_t aOffset)
+    {
+        if (aOffset > _data.size()) {
+            throw SnapshotExceptionCorrupted("Offset " + std::to_string(aOffset) + " past the end of the snapshot");
+        }
+        _offset = aOffset;
+    }
+
+    std::string normalizeTypeName(std::string_view aName)
+    {
+        // The spellings of clang, GCC and MSVC
+        constexpr std::array<std::string_view, 3> anonymous {"(anonymous namespace)", "{anonymous}",
+                                                             "`anonymous namespace'"};
+        constexpr std::array<std::string_view, 4> keywords {"struct ", "class ", "enum ", "union "};
+        std::string name;
+
+        name.reserve(aName.size());
+        for (std::size_t pos = 0; pos < aName.size();) {
+            const auto rest = aName.substr(pos);
+            const auto startsWith = [rest](std::string_view aPrefix) {
+                return rest.starts_with(aPrefix);
+            };
+
+            if (const auto *spelling = std::ranges::find_if(anonymous, startsWith); spelling != anonymous.end()) {
+                name += "(anonymous)";
+                pos += spelling->size();
+            } else if (const auto *keyword = std::ranges::find_if(keywords, startsWith);
+                       keyword != keywords.end() && (pos == 0 || !isWordChar(aName[pos - 1]))) {
+                pos += keyword->size();
+            } else if (aName[pos] == ' ') {
+                if (!name.empty() && isWordChar(name.back()) && pos + 1 < aName.size()
+                    && isWordChar(aName[pos + 1])) {
+                    name += ' ';
+                }
+                pos++;
+            } else {
+                name += aName[pos++];
+            }
+        }
+        return name;
+    }
+} // namespace Engine::Core
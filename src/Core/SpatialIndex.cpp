@@ -0,0 +1,90 @@
+#include "Core/Spatial/SpatialIndex.hpp"
+#include <algorithm>
+#include <mutex>
+
+namespace Engine::Core {
+    void ISpatialIndex::update(id aEntity, const Aabb &aBounds)
+    {
+        if (aEntity >= _indexed.size()) {
+            _bounds.resize(aEntity + 1);
+            _indexed.resize(aEntity + 1, false);
+            _slots.resize(aEntity + 1, 0);
+        }
+        const auto previous = _bounds[aEntity];
+
+        _bounds[aEntity] = aBounds;
+        if (_indexed[aEntity]) {
+            moveEntity(aEntity, previous);
+            return;
+        }
+        _indexed[aEntity] = true;
+        _slots[aEntity] = _entities.size();
+        _entities.push_back(aEntity);
+        insertEntity(aEntity);
+    }
+
+    void ISpatialIndex::remove(id aEntity)
+    {
+        if (!contains(aEntity)) {
+            return;
+        }
+        eraseEntity(aEntity);
+        const auto last = _entities.back();
+
+        _entities[_slots[aEntity]] = last;
+        _slots[last] = _slots[aEntity];
+        _entities.pop_back();
+        _indexed[aEntity] = false;
+    }
+
+    void ISpatialIndex::clear()
+    {
+        clearEntities();
+        _bounds.clear();
+        _indexed.clear();
+        _entities.clear();
+        _slots.clear();
+    }
+
+    void ISpatialIndex::queryRadius(float aX, float aY, float aRadius, std::vector<id> &aEntities) const
+    {
+        const auto first = aEntities.size();
+
+        queryAABB(Aabb {aX - aRadius, aY - aRadius, aX + aRadius, aY + aRadius}, aEntities);
+        // The corners of the box are farther than the radius
+        const auto farther = std::remove_if(aEntities.begin() + static_cast<std::ptrdiff_t>(first), aEntities.end(),
+                                            [this, aX, aY, aRadius](id aEntity) {
+                                                return _bounds[aEntity].distanceSquared(aX, aY) > aRadius * aRadius;
+                                            });
+
+        aEntities.erase(farther, aEntities.end());
+    }
+
+    std::vector<ISpatialIndex::pair> ISpatialIndex::findPairs(JobSystem &aJobSystem, std::size_t aBatchSize) const
+    {
+        std::vector<pair> pairs;
+        std::mutex mutex;
+
+        aJobSystem.parallelFor(0, _entities.size(), aBatchSize,
+                               [this, &pairs, &mutex](std::size_t aBegin, std::size_t aEnd) {
+                                   std::vector<pair> batch;
+                                   std::vector<id> overlapping;
+
+                                   for (auto slot = aBegin; slot < aEnd; slot++) {
+                                       const auto entity = _entities[slot];
+
+                                       overlapping.clear();
+                                       queryAABB(_bounds[entity], overlapping);
+                                       for (const auto other : overlapping) {
+                                           if (other > entity) {
+                                               batch.emplace_back(entity, other);
+                                           }
+                                       }
+                                   }
+                                   std::lock_guard<std::mutex> lock(mutex);
+
+                                   pairs.insert(pairs.end(), batch.begin(), batch.end());
+                               });
+        return pairs;
+    }
+} // namespace Engine::Core
@@ -1,44 +1,846 @@
 #include "World.hpp"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <queue>
+#include <string>
+#include <boost/container/flat_set.hpp>
 #include <spdlog/spdlog.h>
 
 namespace Engine::Core {
-    std::size_t World::createEntity()
+    namespace {
+        /**
+         * @brief The header of the block of a component in a snapshot
+         */
+        struct SnapshotBlock
+        {
+                std::string name;
+                std::size_t end;
+        };
+
+        /**
+         * @brief Read the header of a block, the reader is left on its first byte
+         * @throw SnapshotExceptionCorrupted If the block is past the end of the snapshot
+         */
+        SnapshotBlock readBlock(SnapshotReader &aReader)
+        {
+            aReader.align();
+            const auto nameSize = aReader.read<std::uint32_t>();
+            const auto nameBytes = aReader.read(nameSize);
+            std::string name(reinterpret_cast<const char *>(nameBytes.data()), nameBytes.size());
+            const auto blockSize = aReader.read<std::uint64_t>();
+
+            if (blockSize > aReader.getData().size() - aReader.offset()) {
+                throw SnapshotExceptionCorrupted("The block of " + name + " is past the end of the snapshot");
+            }
+            return SnapshotBlock {std::move(name), aReader.offset() + static_cast<std::size_t>(blockSize)};
+        }
+
+        /**
+         * @brief Check that the blocks of a snapshot and the serializable storages name the same components
+         * @throw SnapshotExceptionMismatch If a block has no storage, or a storage has no block
+         */
+        void checkBlocks(SnapshotReader aReader, std::uint32_t aBlocks,
+                         const boost::container::flat_map<std::string, ISparseArray *> &aStorages)
+        {
+            boost::container::flat_set<std::string> found;
+
+            for (std::uint32_t block = 0; block < aBlocks; block++) {
+                auto [name, end] = readBlock(aReader);
+
+                if (!aStorages.contains(name)) {
+                    throw SnapshotExceptionMismatch("The component " + name + " of the snapshot isn't registered");
+                }
+                found.insert(std::move(name));
+                aReader.seek(end);
+            }
+            for (const auto &[name, storage] : aStorages) {
+                if (!found.contains(name)) {
+                    throw SnapshotExceptionMismatch("The component " + name + " isn't in the snapshot");
+                }
+            }
+        }
+    } // namespace
+
+    World::World(World &&other) noexcept
+        : _components(std::move(other._components)),
+          _resource(other._resource),
+          _signatures(std::move(other._signatures)),
+          _ids(std::move(other._ids)),
+          _nextId(other._nextId),
+          _generations(std::move(other._generations)),
+          _alive(std::move(other._alive)),
+          _hierarchy(std::move(other._hierarchy)),
+          _spatial(std::move(other._spatial)),
+          _spatialComponent(other._spatialComponent),
+          _spatialRefresh(other._spatialRefresh),
+          _spatialTick(other._spatialTick),
+          _systems(std::move(other._systems)),
+          _schedules(std::move(other._schedules)),
+          _systemOrder(std::move(other._systemOrder)),
+          _scheduleDirty(other._scheduleDirty),
+          _commandBuffers(std::move(other._commandBuffers)),
+          _commandJobSystem(other._commandJobSystem),
+          _eventManager(std::move(other._eventManager)),
+          _frameTime(other._frameTime),
+          _changeTick(other._changeTick),
+          _fixedDeltaTime(other._fixedDeltaTime),
+          _maxFixedSteps(other._maxFixedSteps),
+          _accumulator(other._accumulator),
+          _frameClock(other._frameClock),
+          _stepProfileName(other._stepProfileName)
+    {
+        bindStorages();
+    }
+
+    World &World::operator=(World &&other) noexcept
+    {
+        if (this == &other) {
+            return *this;
+        }
+        _components = std::move(other._components);
+        _resource = other._resource;
+        _signatures = std::move(other._signatures);
+        _ids = std::move(other._ids);
+        _nextId = other._nextId;
+        _generations = std::move(other._generations);
+        _alive = std::move(other._alive);
+        _hierarchy = std::move(other._hierarchy);
+        _spatial = std::move(other._spatial);
+        _spatialComponent = other._spatialComponent;
+        _spatialRefresh = other._spatialRefresh;
+        _spatialTick = other._spatialTick;
+        _systems = std::move(other._systems);
+        _schedules = std::move(other._schedules);
+        _systemOrder = std::move(other._systemOrder);
+        _scheduleDirty = other._scheduleDirty;
+        _commandBuffers = std::move(other._commandBuffers);
+        _commandJobSystem = other._commandJobSystem;
+        _eventManager = std::move(other._eventManager);
+        _frameTime = other._frameTime;
+        _changeTick = other._changeTick;
+        _fixedDeltaTime = other._fixedDeltaTime;
+        _maxFixedSteps = other._maxFixedSteps;
+        _accumulator = other._accumulator;
+        _frameClock = other._frameClock;
+        _stepProfileName = other._stepProfileName;
+        bindStorages();
+        return *this;
+    }
+
+    Entity World::createEntity()
     {
         std::size_t newIdx = 0;
 
         if (_ids.empty()) {
             newIdx = _nextId;
             _nextId++;
+            _generations.push_back(0);
+            _alive.push_back(false);
         } else {
-            const auto smallestIdx = std::min_element(_ids.begin(), _ids.end());
-
-            _ids.erase(smallestIdx);
-            newIdx = *smallestIdx;
+            newIdx = _ids.back();
+            _ids.pop_back();
         }
         spdlog::debug("Creating entity {}", newIdx);
+        _alive[newIdx] = true;
+        if (newIdx >= _signatures.size()) {
+            _signatures.resize(newIdx + 1);
+        }
+        _signatures[newIdx].reset();
         for (const auto &component : _components) {
-            component.second->init(newIdx);
+            if (component) {
+                component->init(newIdx);
+            }
         }
-        return newIdx;
+        return Entity {newIdx, _generations[newIdx]};
     }
 
-    void World::killEntity(std::size_t aIndex)
+    void World::killEntity(std::size_t aIndex, ChildPolicy aChildren)
     {
+        if (!isAlive(aIndex)) {
+            throw WorldExceptionDeadEntity("No entity alive at index " + std::to_string(aIndex));
+        }
+        if (!_hierarchy.getChildren(aIndex).empty()) {
+            const auto entity = getEntity(aIndex);
+
+            killEntities(std::span(&entity, 1), aChildren);
+            return;
+        }
         spdlog::debug("Killing entity {}", aIndex);
+        _hierarchy.remove(aIndex);
+        if (_spatial) {
+            _spatial->remove(aIndex);
+        }
+        for (const auto &component : _components) {
+            if (component) {
+                component->erase(aIndex);
+            }
+        }
+        _alive[aIndex] = false;
+        _generations[aIndex]++;
         _ids.push_back(aIndex);
+    }
+
+    void World::killEntity(Entity aEntity, ChildPolicy aChildren)
+    {
+        killEntity(checkAlive(aEntity), aChildren);
+    }
+
+    std::vector<Entity> World::createEntities(std::size_t aCount)
+    {
+        std::vector<Entity> entities;
+
+        if (aCount == 0) {
+            return entities;
+        }
+        spdlog::debug("Creating {} entities", aCount);
+        entities.reserve(aCount);
+        for (; !_ids.empty() && entities.size() < aCount; _ids.pop_back()) {
+            entities.push_back(Entity {_ids.back(), _generations[_ids.back()]});
+        }
+        for (; entities.size() < aCount; _nextId++) {
+            entities.push_back(Entity {_nextId, 0});
+        }
+        _generations.resize(_nextId, 0);
+        _alive.resize(_nextId, false);
+        if (_signatures.size() < _nextId) {
+            _signatures.resize(_nextId);
+        }
+        for (const auto &entity : entities) {
+            _alive[entity.index] = true;
+            _signatures[entity.index].reset();
+        }
+        for (const auto &component : _components) {
+            if (component) {
+                component->init(_nextId - 1);
+            }
+        }
+        return entities;
+    }
+
+    void World::killEntities(std::span<const Entity> aEntities, ChildPolicy aChildren)
+    {
+        std::vector<std::size_t> indexes;
+
+        for (const auto &entity : aEntities) {
+            checkAlive(entity);
+        }
+        indexes.reserve(aEntities.size());
+        for (const auto &entity : aEntities) {
+            if (_alive[entity.index]) {
+                _alive[entity.index] = false;
+                indexes.push_back(entity.index);
+            }
+        }
+        if (aChildren == ChildPolicy::Kill) {
+            // The descendants are appended breadth-first while walking the batch
+            for (std::size_t slot = 0; slot < indexes.size(); slot++) {
+                for (const auto child : _hierarchy.getChildren(indexes[slot])) {
+                    if (_alive[child]) {
+                        _alive[child] = false;
+                        indexes.push_back(child);
+                    }
+                }
+            }
+        } else if (const auto childOf = _components.template find<ChildOf>(); childOf != containerMap::npos) {
+            for (const auto idx : indexes) {
+                for (const auto child : _hierarchy.getChildren(idx)) {
+                    _components[childOf]->erase(child);
+                }
+            }
+        }
+        // Deepest first, so the entities have no child left when they leave the hierarchy
+        for (auto idx = indexes.rbegin(); idx != indexes.rend(); idx++) {
+            _hierarchy.remove(*idx);
+            if (_spatial) {
+                _spatial->remove(*idx);
+            }
+        }
+        spdlog::debug("Killing {} entities", indexes.size());
+        for (const auto &component : _components) {
+            if (component) {
+                for (const auto idx : indexes) {
+                    component->erase(idx);
+                }
+            }
+        }
+        for (const auto idx : indexes) {
+            _generations[idx]++;
+            _ids.push_back(idx);
+        }
+    }
+
+    void World::setParent(Entity aChild, Entity aParent)
+    {
+        checkAlive(aChild);
+        if (_components.template find<ChildOf>() == containerMap::npos) {
+            registerComponent<ChildOf>();
+        }
+        addComponentToEntity(aChild, ChildOf(aParent));
+    }
+
+    void World::removeParent(Entity aChild)
+    {
+        checkAlive(aChild);
+        if (_components.template find<ChildOf>() != containerMap::npos) {
+            removeComponentFromEntity<ChildOf>(aChild);
+        }
+    }
+
+    std::optional<Entity> World::getParent(Entity aChild) const
+    {
+        const auto parent = _hierarchy.getParent(checkAlive(aChild));
+
+        if (parent == Hierarchy::npos) {
+            return std::nullopt;
+        }
+        return getEntity(parent);
+    }
+
+    void World::bindStorages() noexcept
+    {
+        // The storages point to the signatures and the tick of the World they were registered in
+        for (std::size_t componentId = 0; componentId < _components.size(); componentId++) {
+            if (_components[componentId]) {
+                _components[componentId]->bindSignatures(&_signatures, componentId);
+                _components[componentId]->bindChangeTick(&_changeTick);
+            }
+        }
+    }
+
+    void World::rebuildHierarchy()
+    {
+        _hierarchy.clear();
+        if (_components.template find<ChildOf>() == containerMap::npos) {
+            return;
+        }
+        const auto &childOf = getComponent<ChildOf>();
+
+        for (const auto idx : childOf.entities()) {
+            const auto parent = childOf.get(idx).parent;
+
+            if (!isAlive(idx) || !isAlive(parent)) {
+                throw SnapshotExceptionCorrupted("The parent of entity " + std::to_string(idx) + " isn't alive");
+            }
+            try {
+                _hierarchy.setParent(idx, parent.index);
+            } catch (const HierarchyExceptionCycle &e) {
+                throw SnapshotExceptionCorrupted(e.what());
+            }
+        }
+    }
+
+    ISpatialIndex &World::spatial()
+    {
+        if (!_spatial) {
+            throw WorldException("No spatial index, see enableSpatial");
+        }
+        return *_spatial;
+    }
+
+    const ISpatialIndex &World::spatial() const
+    {
+        if (!_spatial) {
+            throw WorldException("No spatial index, see enableSpatial");
+        }
+        return *_spatial;
+    }
+
+    void World::updateSpatial(JobSystem &aJobSystem)
+    {
+        if (_spatialRefresh != nullptr) {
+            _spatialRefresh(*this, aJobSystem);
+        }
+    }
+
+    std::vector<std::byte> World::snapshot() const
+    {
+        constexpr std::size_t bits = 64;
+        SnapshotWriter writer;
+        std::vector<std::uint64_t> alive((_nextId + bits - 1) / bits, 0);
+        std::uint32_t blocks = 0;
+
+        writer.write(snapshotMagic);
+        writer.write(snapshotVersion);
+        writer.write(static_cast<std::uint64_t>(_nextId));
+        const auto blocksOffset = writer.size();
+
+        writer.write(blocks);
+        writer.align();
+        writer.write(_generations.data(), _generations.size() * sizeof(Entity::generationType));
+        for (std::size_t idx = 0; idx < _nextId; idx++) {
+            if (_alive[idx]) {
+                alive[idx / bits] |= std::uint64_t(1) << (idx % bits);
+            }
+        }
+        writer.align();
+        writer.write(alive.data(), alive.size() * sizeof(std::uint64_t));
+        for (const auto &component : _components) {
+            if (!component || !component->isSerializable()) {
+                continue;
+            }
+            const auto name = component->getSerialName();
+
+            writer.align();
+            writer.write(static_cast<std::uint32_t>(name.size()));
+            writer.write(name.data(), name.size());
+            const auto sizeOffset = writer.size();
+
+            // The size of the block lets a reader skip the types it doesn't know
+            writer.write(std::uint64_t(0));
+            component->serialize(writer, _nextId);
+            writer.patch(sizeOffset, static_cast<std::uint64_t>(writer.size() - sizeOffset - sizeof(std::uint64_t)));
+            blocks++;
+        }
+        writer.patch(blocksOffset, blocks);
+        spdlog::debug("Snapshot of {} entities and {} components, {} bytes", _nextId, blocks, writer.size());
+        return std::move(writer.getBuffer());
+    }
+
+    void World::snapshot(std::ostream &aStream) const
+    {
+        const auto data = snapshot();
+
+        aStream.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    void World::restore(std::span<const std::byte> aSnapshot, RestorePolicy aPolicy)
+    {
+        restore(SnapshotReader(aSnapshot), aPolicy);
+    }
+
+    void World::restore(SnapshotReader aReader, RestorePolicy aPolicy)
+    {
+        constexpr std::size_t bits = 64;
+
+        if (aReader.getData().size() < sizeof(snapshotMagic) || aReader.read<std::uint32_t>() != snapshotMagic) {
+            throw SnapshotExceptionVersion("Not a World snapshot");
+        }
+        if (const auto version = aReader.read<std::uint32_t>(); version != snapshotVersion) {
+            throw SnapshotExceptionVersion("Unsupported snapshot version " + std::to_string(version));
+        }
+        const auto entityCount = static_cast<std::size_t>(aReader.read<std::uint64_t>());
+        const auto blocks = aReader.read<std::uint32_t>();
 
+        aReader.align();
+        const auto generations = aReader.read(entityCount * sizeof(Entity::generationType));
+
+        aReader.align();
+        const auto alive = aReader.read((entityCount + bits - 1) / bits * sizeof(std::uint64_t));
+        boost::container::flat_map<std::string, ISparseArray *> storages;
+
+        for (const auto &component : _components) {
+            if (component && component->isSerializable()) {
+                storages[component->getSerialName()] = component.get();
+            }
+        }
+        if (aPolicy == RestorePolicy::Strict) {
+            checkBlocks(aReader, blocks, storages);
+        }
+        for (const auto &component : _components) {
+            if (component) {
+                component->clear();
+            }
+        }
+        _nextId = entityCount;
+        _generations.resize(entityCount);
+        std::memcpy(_generations.data(), generations.data(), generations.size());
+        _alive.assign(entityCount, false);
+        _ids.clear();
+        _signatures.assign(entityCount, Signature {});
+        for (std::size_t idx = 0; idx < entityCount; idx++) {
+            std::uint64_t word = 0;
+
+            std::memcpy(&word, alive.data() + idx / bits * sizeof(std::uint64_t), sizeof(std::uint64_t));
+            _alive[idx] = (word >> (idx % bits) & 1) != 0;
+        }
+        // The lowest dead index is reused first
+        for (auto idx = entityCount; idx > 0; idx--) {
+            if (!_alive[idx - 1]) {
+                _ids.push_back(idx - 1);
+            }
+        }
+
+        boost::container::flat_set<const ISparseArray *> restored;
+
+        for (std::uint32_t block = 0; block < blocks; block++) {
+            const auto [name, end] = readBlock(aReader);
+            const auto storage = storages.find(name);
+
+            if (storage == storages.end()) {
+                spdlog::warn("Skipping the component {} of the snapshot, it isn't registered", name);
+            } else {
+                storage->second->deserialize(aReader, entityCount);
+                restored.insert(storage->second);
+                if (aReader.offset() != end) {
+                    throw SnapshotExceptionCorrupted("The block of " + name + " doesn't match its size");
+                }
+            }
+            aReader.seek(end);
+        }
+        // The restored storages made their slots, a ColumnArray may even have adopted the columns of the snapshot
         for (const auto &component : _components) {
-            component.second->erase(aIndex);
+            if (component && entityCount != 0 && !restored.contains(component.get())) {
+                component->init(entityCount - 1);
+            }
+        }
+        rebuildHierarchy();
+        if (_spatial) {
+            _spatial->clear();
+            _spatialTick = 0;
+        }
+        spdlog::debug("Restored {} entities and {} components", entityCount, blocks);
+    }
+
+    void World::restore(std::istream &aStream, RestorePolicy aPolicy)
+    {
+        std::vector<std::byte> data;
+        std::array<char, 64 * 1024> chunk {};
+
+        while (aStream.read(chunk.data(), chunk.size()) || aStream.gcount() > 0) {
+            const auto *begin = reinterpret_cast<const std::byte *>(chunk.data());
+
+            data.insert(data.end(), begin, begin + aStream.gcount());
+        }
+        restore(data, aPolicy);
+    }
+
+    void World::snapshot(const std::filesystem::path &aPath) const
+    {
+        std::ofstream file(aPath, std::ios::binary);
+
+        if (!file) {
+            throw SnapshotExceptionFile("Can't open " + aPath.string());
+        }
+        snapshot(file);
+        if (!file) {
+            throw SnapshotExceptionFile("Can't write " + aPath.string());
+        }
+    }
+
+    void World::restore(const std::filesystem::path &aPath, RestorePolicy aPolicy)
+    {
+        auto file = std::make_shared<MappedFile>(aPath);
+        const auto data = file->getMutableData();
+
+        restore(SnapshotReader(data, std::move(file)), aPolicy);
+    }
+
+    void World::runSystems(JobSystem &aJobSystem)
+    {
+        _frameTime.frame++;
+        _changeTick++;
+        runStage(SystemStage::Fixed, aJobSystem);
+        runStage(SystemStage::Variable, aJobSystem);
+    }
+
+    void World::runStage(SystemStage aStage, JobSystem &aJobSystem)
+    {
+        if (_scheduleDirty) {
+            buildSchedule();
+        }
+
+        const auto &schedule = _schedules[static_cast<std::size_t>(aStage)];
+        [[maybe_unused]] const auto frame = _frameTime.frame;
+
+        updateSpatial(aJobSystem);
+        prepareCommandBuffers(aJobSystem);
+        if (schedule.size() <= 1) {
+            try {
+                for (const auto &node : schedule) {
+                    STELLAR_PROFILE_SCOPE(node.profileName, frame);
+
+                    node.system->update();
+                }
+            } catch (...) {
+                clearCommands();
+                throw;
+            }
+            flushCommands();
+            return;
+        }
+
+        std::vector<std::atomic<std::size_t>> remaining(schedule.size());
+        JobCounter counter;
+        std::function<void(std::size_t)> launch;
+
+        for (std::size_t idx = 0; idx < schedule.size(); idx++) {
+            remaining[idx].store(schedule[idx].dependencies, std::memory_order_relaxed);
+        }
+        // A finished system launches the systems it was the last dependency of
+        launch = [&schedule, &aJobSystem, &counter, &remaining, &launch, frame](std::size_t aNode) {
+            aJobSystem.submit(
+                [&schedule, &remaining, &launch, aNode, frame] {
+                    {
+                        STELLAR_PROFILE_SCOPE(schedule[aNode].profileName, frame);
+
+                        schedule[aNode].system->update();
+                    }
+                    for (const auto next : schedule[aNode].next) {
+                        if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                            launch(next);
+                        }
+                    }
+                },
+                counter);
+        };
+        for (std::size_t idx = 0; idx < schedule.size(); idx++) {
+            if (schedule[idx].dependencies == 0) {
+                launch(idx);
+            }
+        }
+        try {
+            aJobSystem.wait(counter);
+        } catch (...) {
+            // The commands of an interrupted stage must not be applied by the next flush
+            clearCommands();
+            throw;
+        }
+        flushCommands();
+    }
+
+    void World::step(double aDeltaTime, JobSystem &aJobSystem)
+    {
+        _frameTime.frame++;
+        _changeTick++;
+        STELLAR_PROFILE_SCOPE(_stepProfileName, _frameTime.frame);
+
+        _frameTime.frameDeltaTime = aDeltaTime;
+        _frameTime.fixedSteps = 0;
+        _accumulator += aDeltaTime;
+        _frameTime.deltaTime = _fixedDeltaTime;
+        while (_accumulator >= _fixedDeltaTime && _frameTime.fixedSteps < _maxFixedSteps) {
+            runStage(SystemStage::Fixed, aJobSystem);
+            _accumulator -= _fixedDeltaTime;
+            _frameTime.fixedSteps++;
+            _frameTime.time += _fixedDeltaTime;
+        }
+        if (_accumulator >= _fixedDeltaTime) {
+            // Too far behind: drop the time that can't be caught up instead of spiraling
+            spdlog::debug("Dropping {}s of simulation", _accumulator - std::fmod(_accumulator, _fixedDeltaTime));
+            _accumulator = std::fmod(_accumulator, _fixedDeltaTime);
         }
+        _frameTime.alpha = _accumulator / _fixedDeltaTime;
+        _frameTime.deltaTime = aDeltaTime;
+        runStage(SystemStage::Variable, aJobSystem);
     }
 
-    void World::runSystems()
+    void World::tick(JobSystem &aJobSystem)
     {
-        for (auto &system : _systems) {
-            system.second->update();
+        // The clock counts in milliseconds
+        step(_frameClock.restart() / 1000, aJobSystem);
+    }
+
+    void World::setFixedTimestep(double aFixedDeltaTime, std::size_t aMaxFixedSteps)
+    {
+        if (aFixedDeltaTime <= 0) {
+            throw WorldException("The fixed timestep must be positive");
+        }
+        _fixedDeltaTime = aFixedDeltaTime;
+        _maxFixedSteps = std::max<std::size_t>(1, aMaxFixedSteps);
+    }
+
+    CommandBuffer &World::commands()
+    {
+        const auto worker = _commandJobSystem == nullptr ? JobSystem::npos : _commandJobSystem->getCurrentWorker();
+
+        if (_commandBuffers.empty()) {
+            _commandBuffers.push_back(std::make_unique<CommandBuffer>(0));
+        }
+        return *_commandBuffers[worker == JobSystem::npos ? 0 : worker + 1];
+    }
+
+    void World::prepareCommandBuffers(JobSystem &aJobSystem)
+    {
+        // Buffer 0 is shared by the threads outside the job system, then one per worker
+        while (_commandBuffers.size() <= aJobSystem.getThreadCount()) {
+            _commandBuffers.push_back(std::make_unique<CommandBuffer>(_commandBuffers.size()));
+        }
+        _commandJobSystem = &aJobSystem;
+    }
+
+    void World::clearCommands()
+    {
+        for (auto &buffer : _commandBuffers) {
+            buffer->clear();
+        }
+    }
+
+    void World::flushCommands()
+    {
+        std::size_t spawns = 0;
+
+        if (std::ranges::all_of(_commandBuffers, [](const auto &aBuffer) {
+                return aBuffer->empty();
+            })) {
+            return;
+        }
+
+        for (const auto &buffer : _commandBuffers) {
+            spawns += buffer->getSpawnCount();
+        }
+        try {
+            std::vector<std::vector<Entity>> spawned(_commandBuffers.size());
+            std::vector<const CommandBuffer::Command *> commands;
+            std::vector<Entity> kills;
+            const auto entities = createEntities(spawns);
+            auto next = entities.begin();
+
+            for (std::size_t buffer = 0; buffer < _commandBuffers.size(); buffer++) {
+                for (std::size_t spawn = 0; spawn < _commandBuffers[buffer]->getSpawnCount(); spawn++) {
+                    spawned[buffer].push_back(*next++);
+                }
+            }
+            const auto resolve = [&spawned](Entity aEntity) {
+                if (!CommandBuffer::isPending(aEntity)) {
+                    return aEntity;
+                }
+                const auto local = aEntity.index & ~CommandBuffer::pendingBit;
+
+                return spawned.at(local >> CommandBuffer::bufferShift).at(local & CommandBuffer::spawnMask);
+            };
+
+            for (const auto &buffer : _commandBuffers) {
+                for (const auto &command : buffer->getCommands()) {
+                    commands.push_back(&command);
+                }
+                for (const auto kill : buffer->getKills()) {
+                    kills.push_back(resolve(kill));
+                }
+            }
+            // Grouped per component, the commands of a storage run back to back
+            std::ranges::stable_sort(commands, {}, [](const CommandBuffer::Command *aCommand) {
+                return aCommand->componentId;
+            });
+            for (const auto *command : commands) {
+                const auto entity = resolve(command->entity);
+
+                // The entity may have been killed since the command was recorded, its index even reused
+                if (isAlive(entity)) {
+                    command->apply(*this, entity.index, command->payload);
+                }
+            }
+            std::vector<Entity> killed;
+
+            for (const auto kill : kills) {
+                if (isAlive(kill)) {
+                    killed.push_back(kill);
+                }
+            }
+            killEntities(killed);
+        } catch (...) {
+            clearCommands();
+            throw;
+        }
+        clearCommands();
+    }
+
+    const std::vector<std::string> &World::getSystemOrder()
+    {
+        if (_scheduleDirty) {
+            buildSchedule();
+        }
+        return _systemOrder;
+    }
+
+    void World::buildSchedule()
+    {
+        const auto count = _systems.size();
+        std::vector<std::vector<std::size_t>> constraints(count);
+        std::vector<std::size_t> constrained(count, 0);
+        const auto indexOf = [this, count](const std::string &aName) {
+            const auto found = _systems.find(aName);
+
+            return found == _systems.end() ? count : static_cast<std::size_t>(found - _systems.begin());
+        };
+        const auto constrain = [&constraints, &constrained, count](std::size_t aFirst, std::size_t aThen) {
+            if (aFirst != count && aThen != count) {
+                constraints[aFirst].push_back(aThen);
+                constrained[aThen]++;
+            }
+        };
+
+        for (std::size_t idx = 0; idx < count; idx++) {
+            const auto &system = *(_systems.begin() + static_cast<std::ptrdiff_t>(idx))->second;
+
+            for (const auto &name : system.getBefore()) {
+                constrain(idx, indexOf(name));
+            }
+            for (const auto &name : system.getAfter()) {
+                constrain(indexOf(name), idx);
+            }
+        }
+
+        // Order the systems by their constraints, the names break the ties
+        std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> ready;
+        std::vector<std::size_t> order;
+
+        for (std::size_t idx = 0; idx < count; idx++) {
+            if (constrained[idx] == 0) {
+                ready.push(idx);
+            }
+        }
+        while (!ready.empty()) {
+            const auto idx = ready.top();
+
+            ready.pop();
+            order.push_back(idx);
+            for (const auto then : constraints[idx]) {
+                if (--constrained[then] == 0) {
+                    ready.push(then);
+                }
+            }
+        }
+        if (order.size() != count) {
+            throw WorldExceptionSystemCycle("The before / after constraints of the systems form a cycle");
+        }
+
+        // Each stage has its own graph, a system waits for the systems of its stage it conflicts with or is
+        // constrained by that come before it
+        std::vector<std::size_t> position(count);
+
+        _systemOrder.clear();
+        for (std::size_t stage = 0; stage < stageCount; stage++) {
+            auto &schedule = _schedules[stage];
+
+            schedule.clear();
+            for (const auto idx : order) {
+                const auto &entry = *(_systems.begin() + static_cast<std::ptrdiff_t>(idx));
+
+                if (static_cast<std::size_t>(entry.second->getStage()) == stage) {
+                    position[idx] = schedule.size();
+                    schedule.push_back(
+                        SystemNode {entry.second.get(), {}, 0, Profiler::getInstance().intern(entry.first)});
+                    _systemOrder.push_back(entry.first);
+                }
+            }
+        }
+        for (const auto idx : order) {
+            const auto &system = *(_systems.begin() + static_cast<std::ptrdiff_t>(idx))->second;
+            auto &schedule = _schedules[static_cast<std::size_t>(system.getStage())];
+            const auto first = position[idx];
+            std::vector<std::size_t> constrainedNext;
+
+            for (const auto then : constraints[idx]) {
+                if ((_systems.begin() + static_cast<std::ptrdiff_t>(then))->second->getStage() == system.getStage()) {
+                    constrainedNext.push_back(position[then]);
+                }
+            }
+            for (auto then = first + 1; then < schedule.size(); then++) {
+                if (system.getAccess().conflictsWith(schedule[then].system->getAccess())
+                    || std::ranges::find(constrainedNext, then) != constrainedNext.end()) {
+                    schedule[first].next.push_back(then);
+                    schedule[then].dependencies++;
+                }
+            }
         }
+        _scheduleDirty = false;
     }
 
     std::size_t World::getCurrentId() const
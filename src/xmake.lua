@@ -45,5 +45,12 @@ target("Stellar-Engine")
         set_symbols("hidden")
     end
 
+    -- Compile the profiling instrumentation in or out, for the engine and its users
+    if has_config("profiling") then
+        add_defines("STELLAR_PROFILING=1", {public = true})
+    else
+        add_defines("STELLAR_PROFILING=0", {public = true})
+    end
+
     -- Define the _CRT_SECURE_NO_WARNINGS macro for the MSVC compiler (in case)
     add_defines("_CRT_SECURE_NO_WARNINGS")
@@ -1,8 +1,12 @@
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "Component.hpp"
 #include "ECS.hpp"
 #include <catch2/catch_test_macros.hpp>
@@ -49,3 +53,99 @@ TEST_CASE("App", "[App]")
         REQUIRE(app[0] != tmp);
     }
 }
+
+class StepCounterSystem : public Engine::Core::System
+{
+    public:
+        StepCounterSystem(Engine::Core::World &aWorld, std::atomic<int> &aSteps, std::function<void()> aOnStep = {})
+            : Engine::Core::System(aWorld),
+              _steps(aSteps),
+              _onStep(std::move(aOnStep))
+        {}
+
+        void update() override
+        {
+            _steps.get()++;
+            if (_onStep) {
+                _onStep();
+            }
+        }
+
+    private:
+        std::reference_wrapper<std::atomic<int>> _steps;
+        std::function<void()> _onStep;
+};
+
+TEST_CASE("App stepping", "[App]")
+{
+    Engine::App app;
+    Engine::Core::JobSystem jobs(4);
+    std::vector<std::atomic<int>> steps(8);
+
+    for (std::size_t key = 0; key < steps.size(); key++) {
+        auto &world = app.addWorld(key);
+        auto system = std::make_pair<std::string, std::unique_ptr<Engine::Core::System>>(
+            "counter", std::make_unique<StepCounterSystem>(*world, steps[key]));
+
+        world->addSystem(system);
+    }
+
+    SECTION("Every world is stepped once per stepAll")
+    {
+        app.stepAll(0.5, jobs);
+        app.stepAll(0.5, jobs);
+        for (const auto &count : steps) {
+            REQUIRE(count == 2);
+        }
+        REQUIRE(app[3]->getDeltaTime() == 0.5);
+        REQUIRE(app.getWorldStats(3).steps == 2);
+        REQUIRE(app.getWorldStats(3).maxStepTime >= app.getWorldStats(3).getAverageStepTime());
+    }
+    SECTION("Paused worlds are skipped")
+    {
+        app.pauseWorld(2);
+        app.stepAll(0, jobs);
+        REQUIRE(app.isWorldPaused(2));
+        REQUIRE(steps[2] == 0);
+        REQUIRE(steps[1] == 1);
+        app.resumeWorld(2);
+        app.runAll(jobs);
+        REQUIRE(steps[2] == 1);
+        REQUIRE_THROWS_AS(app.pauseWorld(42), Engine::AppExceptionKeyNotFound);
+    }
+    SECTION("A world with an affinity is stepped on its worker")
+    {
+        std::atomic<int> pinnedSteps = 0;
+        std::atomic<std::size_t> worker = Engine::Core::JobSystem::npos;
+        auto &world = app.addWorld(100);
+        auto system = std::make_pair<std::string, std::unique_ptr<Engine::Core::System>>(
+            "pinned", std::make_unique<StepCounterSystem>(*world, pinnedSteps, [&jobs, &worker] {
+                worker = jobs.getCurrentWorker();
+            }));
+
+        world->addSystem(system);
+        app.setWorldAffinity(100, 3);
+        app.stepAll(0, jobs);
+        REQUIRE(pinnedSteps == 1);
+        REQUIRE(worker == 3);
+    }
+    SECTION("A world can be removed while the others are stepping")
+    {
+        std::atomic<int> removerSteps = 0;
+        auto &world = app.addWorld(100);
+        auto system = std::make_pair<std::string, std::unique_ptr<Engine::Core::System>>(
+            "remover", std::make_unique<StepCounterSystem>(*world, removerSteps, [&app] {
+                app.removeWorld(5);
+                app.addWorld(200);
+            }));
+
+        world->addSystem(system);
+        app.stepAll(0, jobs);
+        REQUIRE_THROWS_AS(app[5], Engine::AppExceptionKeyNotFound);
+        REQUIRE_NOTHROW(app[200]);
+        app.removeWorld(100);
+        app.stepAll(0, jobs);
+        REQUIRE(steps[4] == 2);
+        REQUIRE(steps[5] <= 1);
+    }
+}
@@ -0,0 +1,103 @@
+#include <cstddef>
+#include <span>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct position : public Engine::Component
+{
+    public:
+        explicit position(int aX)
+            : x(aX)
+        {}
+
+        int x;
+};
+
+struct velocity : public Engine::Component
+{
+    public:
+        explicit velocity(int aDx)
+            : dx(aDx)
+        {}
+
+        int dx;
+};
+
+TEST_CASE("ArchetypeWorld", "[Archetype]")
+{
+    Engine::Core::ArchetypeWorld world;
+
+    world.registerComponents<position, velocity>();
+
+    SECTION("Add components moves the entity between archetypes")
+    {
+        auto entity = world.createEntity();
+
+        world.addComponentToEntity(entity, position {1});
+        world.addComponentToEntity(entity, velocity {2});
+
+        REQUIRE(world.hasComponents<position, velocity>(entity));
+        REQUIRE(world.getComponentOfEntity<position>(entity).x == 1);
+        REQUIRE(world.getComponentOfEntity<velocity>(entity).dx == 2);
+        REQUIRE(world.getArchetypeCount() == 3);
+        REQUIRE(world.getStats().moves == 2);
+        REQUIRE(world.getStats().componentsMoved == 1);
+    }
+    SECTION("Remove a component keeps the other ones")
+    {
+        auto entity = world.createEntity();
+
+        world.addComponentToEntity(entity, position {1});
+        world.addComponentToEntity(entity, velocity {2});
+        world.removeComponentFromEntity<velocity>(entity);
+
+        REQUIRE_FALSE(world.hasComponents<velocity>(entity));
+        REQUIRE(world.getComponentOfEntity<position>(entity).x == 1);
+        REQUIRE_THROWS_AS(world.getComponentOfEntity<velocity>(entity),
+                          Engine::Core::ArchetypeWorldExceptionComponentNotFound);
+    }
+    SECTION("Query streams through the matching archetypes")
+    {
+        constexpr int count = 5000;
+
+        for (int idx = 0; idx < count; idx++) {
+            auto entity = world.createEntity();
+
+            world.addComponentToEntity(entity, position {idx});
+            if (idx % 2 == 0) {
+                world.addComponentToEntity(entity, velocity {1});
+            }
+        }
+        world.query<position, velocity>().forEach(
+            0, [](Engine::Core::ArchetypeWorld & /*world*/, double /*deltaTime*/, std::size_t /*idx*/,
+                  position &pos, velocity &vel) {
+                pos.x += vel.dx;
+            });
+
+        std::size_t chunks = 0;
+        world.query<position, velocity>().forEachChunk(
+            [&chunks](std::span<const std::size_t> ids, std::span<position> /*pos*/, std::span<velocity> vel) {
+                REQUIRE(ids.size() == vel.size());
+                chunks++;
+            });
+
+        REQUIRE(chunks > 1);
+        REQUIRE(world.query<position, velocity>().getAllEntities().size() == count / 2);
+        REQUIRE(world.getComponentOfEntity<position>(0).x == 1);
+        REQUIRE(world.getComponentOfEntity<position>(1).x == 1);
+    }
+    SECTION("Kill an entity keeps the others in place")
+    {
+        auto first = world.createEntity();
+        auto second = world.createEntity();
+
+        world.addComponentToEntity(first, position {1});
+        world.addComponentToEntity(second, position {2});
+        world.killEntity(first);
+
+        REQUIRE(world.getComponentOfEntity<position>(second).x == 2);
+        REQUIRE_THROWS_AS(world.hasComponents<position>(first), Engine::Core::ArchetypeWorldExceptionEntityNotFound);
+        REQUIRE(world.createEntity() == first);
+    }
+}
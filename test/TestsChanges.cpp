@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <vector>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct tracked : public Engine::Component
+{
+    public:
+        int value = 0;
+};
+
+struct packedTracked : public Engine::Component
+{
+    public:
+        using storageTag = Engine::Core::PackedStorage;
+
+        int value = 0;
+};
+
+TEST_CASE("Change detection", "[Changes]")
+{
+    Engine::Core::World world;
+    std::vector<Engine::Core::Entity> entities;
+
+    world.registerComponents<tracked, packedTracked>();
+    for (int idx = 0; idx < 1000; idx++) {
+        const auto entity = world.createEntity();
+
+        entities.push_back(entity);
+        world.emplaceComponentToEntity<tracked>(entity);
+        world.emplaceComponentToEntity<packedTracked>(entity);
+    }
+    const auto start = world.getChangeTick();
+
+    auto collect = [](auto &&aQuery) {
+        std::vector<std::size_t> result;
+
+        aQuery.forEach([&result](std::size_t idx, const auto &...) {
+            result.push_back(idx);
+        });
+        return result;
+    };
+
+    SECTION("Added components")
+    {
+        world.advanceChangeTick();
+        const auto tick = world.getChangeTick();
+
+        REQUIRE(collect(world.query<const tracked>().filter<Engine::Core::Added<tracked>>(start - 1)).size() == 1000);
+        REQUIRE(collect(world.query<const tracked>().filter<Engine::Core::Added<tracked>>(start)).empty());
+
+        const auto entity = world.createEntity();
+
+        world.emplaceComponentToEntity<tracked>(entity);
+        REQUIRE(collect(world.query<const tracked>().filter<Engine::Core::Added<tracked>>(start))
+                == std::vector<std::size_t> {entity.index});
+        REQUIRE(collect(world.query<const tracked>().filter<Engine::Core::Added<tracked>>(tick)).empty());
+    }
+
+    SECTION("Mutable accesses are changes")
+    {
+        world.advanceChangeTick();
+        world.getComponent<tracked>()[entities[3].index].value = 1;
+        world.getComponent<packedTracked>().get(entities[700].index).value = 1;
+
+        REQUIRE(collect(world.query<const tracked>().changedSince(start))
+                == std::vector<std::size_t> {entities[3].index});
+        REQUIRE(collect(world.query<const packedTracked>().changedSince(start))
+                == std::vector<std::size_t> {entities[700].index});
+        REQUIRE(collect(world.query<const tracked, const packedTracked>().changedSince(start))
+                == std::vector<std::size_t> {entities[3].index, entities[700].index});
+        REQUIRE(collect(world.query<const tracked>().filter<Engine::Core::Changed<packedTracked>>(start))
+                == std::vector<std::size_t> {entities[700].index});
+        REQUIRE(collect(world.query<const tracked>().filter<Engine::Core::Added<tracked>>(start)).empty());
+
+        // Visiting an entity through a mutable query is a change
+        collect(world.query<tracked>().filter<Engine::Core::Changed<packedTracked>>(start));
+        REQUIRE(collect(world.query<const tracked>().changedSince(start))
+                == std::vector<std::size_t> {entities[3].index, entities[700].index});
+    }
+
+    SECTION("Read-only accesses aren't changes")
+    {
+        world.advanceChangeTick();
+        int sum = 0;
+
+        world.query<const tracked, const packedTracked>().forEach([&sum](const tracked &a, const packedTracked &b) {
+            sum += a.value + b.value;
+        });
+        REQUIRE(sum == 0);
+        REQUIRE(collect(world.query<const tracked, const packedTracked>().changedSince(start)).empty());
+
+        world.query<tracked>().forEach([](tracked &comp) {
+            comp.value++;
+        });
+        REQUIRE(collect(world.query<const packedTracked>().changedSince(start)).empty());
+        REQUIRE(collect(world.query<const tracked>().changedSince(start)).size() == 1000);
+    }
+
+    SECTION("A moved World stamps its own tick")
+    {
+        Engine::Core::World moved(std::move(world));
+
+        moved.advanceChangeTick();
+        moved.getComponent<tracked>()[entities[5].index].value = 1;
+        REQUIRE(collect(moved.query<const tracked>().changedSince(start))
+                == std::vector<std::size_t> {entities[5].index});
+    }
+
+    SECTION("Systems advance the tick")
+    {
+        std::size_t seen = 0;
+        auto lastTick = world.getChangeTick();
+
+        auto writer = Engine::Core::createSystem<tracked>(world, "writer", [](tracked &comp) {
+            comp.value++;
+        });
+        auto reader = Engine::Core::createSystem<const tracked>(world, "reader", [](const tracked &) {});
+
+        world.addSystem(writer);
+        world.addSystem(reader);
+        world.runSystems();
+        REQUIRE(world.getChangeTick() == lastTick + 1);
+        world.query<const tracked>().changedSince(lastTick).forEach([&seen](const tracked &) {
+            seen++;
+        });
+        REQUIRE(seen == 1000);
+        REQUIRE(collect(world.query<const tracked>().changedSince(world.getChangeTick())).empty());
+    }
+}
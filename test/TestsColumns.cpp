@@ -0,0 +1,265 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct vec3
+{
+    public:
+        float x = 0;
+        float y = 0;
+        float z = 0;
+
+        static constexpr auto fields = std::make_tuple(&vec3::x, &vec3::y, &vec3::z);
+        static constexpr std::string_view serialName = "vec3";
+};
+
+struct speed
+{
+    public:
+        float x = 0;
+        std::int32_t steps = 0;
+
+        static constexpr auto fields = std::make_tuple(&speed::x, &speed::steps);
+};
+
+struct sparseVec3 : public vec3
+{
+    public:
+        using storageTag = Engine::Core::SparseStorage;
+};
+
+struct plainFlag
+{
+    public:
+        int value = 0;
+};
+
+TEST_CASE("Column storage", "[Columns]")
+{
+    STATIC_REQUIRE(Engine::ComponentConcept<plainFlag>);
+    STATIC_REQUIRE_FALSE(std::is_polymorphic_v<vec3>);
+    STATIC_REQUIRE(std::is_same_v<Engine::Core::StorageOf<vec3>, Engine::Core::ColumnArray<vec3>>);
+    STATIC_REQUIRE(std::is_same_v<Engine::Core::StorageOf<sparseVec3>, Engine::Core::SparseArray<sparseVec3>>);
+    STATIC_REQUIRE(std::is_same_v<Engine::Core::StorageOf<plainFlag>, Engine::Core::SparseArray<plainFlag>>);
+
+    Engine::Core::World world;
+
+    world.registerComponents<vec3, speed, plainFlag>();
+    for (int idx = 0; idx < 3000; idx++) {
+        const auto entity = world.createEntity();
+
+        world.addComponentToEntity(entity, vec3 {static_cast<float>(idx), 0, 0});
+        if (idx % 10 != 0) {
+            world.addComponentToEntity(entity, speed {1, 0});
+        }
+        world.addComponentToEntity(entity, plainFlag {idx});
+    }
+    auto &positions = world.getComponent<vec3>();
+
+    SECTION("Components are scattered in aligned columns")
+    {
+        const auto &constPositions = positions;
+
+        REQUIRE(reinterpret_cast<std::uintptr_t>(positions.column<&vec3::x>().data()) % 64 == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(positions.column<&vec3::z>().data()) % 64 == 0);
+        REQUIRE(positions.column<&vec3::x>()[42] == 42);
+        REQUIRE(constPositions.get(42).x == 42);
+
+        positions.get(42).field<&vec3::y>() = 3;
+        positions[43] = vec3 {1, 2, 3};
+        REQUIRE(constPositions[42].y == 3);
+        REQUIRE(static_cast<vec3>(positions[43]).z == 3);
+        REQUIRE(world.getComponent<plainFlag>().get(43).value == 43);
+
+        world.removeComponentFromEntity<vec3>(43);
+        REQUIRE_FALSE(positions.contains(43));
+        REQUIRE(positions.column<&vec3::z>()[43] == 0);
+        REQUIRE_THROWS_AS(constPositions.get(43), Engine::Core::SparseArrayExceptionEmpty);
+    }
+
+    SECTION("Batches are runs of matching entities")
+    {
+        constexpr std::size_t batchSize = 256;
+        std::size_t visited = 0;
+        bool bounded = true;
+
+        world.query<vec3, const speed>().forEachBatch(
+            [&visited, &bounded](auto aPosition, auto aSpeed) {
+                auto x = aPosition.template field<&vec3::x>();
+                const auto vx = aSpeed.template field<&speed::x>();
+
+                for (std::size_t idx = 0; idx < x.size(); idx++) {
+                    x[idx] += vx[idx];
+                }
+                bounded = bounded && x.size() <= batchSize && aPosition.first() / batchSize
+                          == (aPosition.first() + x.size() - 1) / batchSize;
+                visited += x.size();
+            },
+            batchSize);
+        REQUIRE(bounded);
+        REQUIRE(visited == 2700);
+
+        const auto &constPositions = positions;
+
+        REQUIRE(constPositions.get(0).x == 0);
+        REQUIRE(constPositions.get(1).x == 2);
+        REQUIRE(constPositions.get(2999).x == 3000);
+    }
+
+    SECTION("A null batch size uses the default one")
+    {
+        std::size_t batches = 0;
+
+        world.query<const vec3>().forEachBatch(
+            [&batches](auto aPosition) {
+                batches += static_cast<std::size_t>(aPosition.size() <= Engine::Core::World::defaultBatchSize);
+            },
+            0);
+        REQUIRE(batches == (3000 + Engine::Core::World::defaultBatchSize - 1) / Engine::Core::World::defaultBatchSize);
+    }
+
+    SECTION("Batches stamp the mutable columns as changed")
+    {
+        const auto tick = world.getChangeTick();
+
+        world.advanceChangeTick();
+        world.query<const vec3, speed>().forEachBatch([](auto, auto) {});
+        REQUIRE(world.query<const vec3>().changedSince(tick).getAllEntities().empty());
+        REQUIRE(world.query<const speed>().changedSince(tick).getAllEntities().size() == 2700);
+    }
+
+    SECTION("forEach reads copies of the const components")
+    {
+        float sum = 0;
+
+        world.query<const vec3, const plainFlag>().forEach([&sum](const vec3 &aPosition, const plainFlag &aFlag) {
+            sum += aPosition.x - static_cast<float>(aFlag.value);
+        });
+        REQUIRE(sum == 0);
+    }
+
+    SECTION("forEach and view write through ColumnRefs")
+    {
+        const auto &constPositions = positions;
+
+        world.query<vec3, const plainFlag>().forEach(
+            [](Engine::Core::ColumnRef<vec3> aPosition, const plainFlag &aFlag) {
+                aPosition.field<&vec3::y>() = static_cast<float>(aFlag.value);
+            });
+        for (auto [idx, position] : world.view<vec3>()) {
+            position.field<&vec3::z>() += 1;
+        }
+        for (auto &[idx, position] : world.query<vec3>().getAll()) {
+            position = vec3 {static_cast<vec3>(position).x, static_cast<vec3>(position).y * 2, 5};
+        }
+        REQUIRE(constPositions.get(1234).y == 2468);
+        REQUIRE(constPositions.get(1234).z == 5);
+    }
+
+    SECTION("Systems write column components")
+    {
+        auto lift = Engine::Core::createSystem<vec3>(world, "lift", [](auto aPosition) {
+            aPosition.template field<&vec3::y>() = 7;
+        });
+
+        world.addSystem(lift);
+        world.runSystems();
+        REQUIRE(std::as_const(positions).get(2999).y == 7);
+    }
+
+    SECTION("Snapshots of columns restore in any storage")
+    {
+        Engine::Core::World other;
+
+        other.registerComponents<sparseVec3>();
+        other.restore(world.snapshot());
+        REQUIRE(other.getComponent<sparseVec3>().count() == 3000);
+        REQUIRE(other.getComponent<sparseVec3>().get(1234).x == 1234);
+
+        Engine::Core::World columns;
+
+        columns.registerComponents<vec3>();
+        columns.restore(other.snapshot());
+        REQUIRE(columns.getComponent<vec3>().count() == 3000);
+        REQUIRE(std::as_const(columns.getComponent<vec3>()).get(2345).x == 2345);
+    }
+
+    SECTION("Snapshots copy the runs of a column with holes")
+    {
+        Engine::Core::World copy;
+
+        world.getComponent<speed>().get(11).field<&speed::steps>() = 4;
+        copy.registerComponents<vec3, speed>();
+        copy.restore(world.snapshot());
+
+        const auto &speeds = std::as_const(copy.getComponent<speed>());
+
+        REQUIRE(speeds.count() == 2700);
+        REQUIRE_FALSE(speeds.contains(10));
+        REQUIRE(speeds.column<&speed::x>()[10] == 0);
+        REQUIRE(speeds.get(11).steps == 4);
+        REQUIRE(speeds.get(2999).x == 1);
+        REQUIRE(copy.query<const vec3, const speed>().getAllEntities().size() == 2700);
+
+        // Less than half of the entities have the component, the columns are packed
+        for (std::size_t idx = 0; idx < 2000; idx++) {
+            world.removeComponentFromEntity<speed>(idx);
+        }
+        copy.restore(world.snapshot());
+        REQUIRE(speeds.count() == 900);
+        REQUIRE_FALSE(speeds.contains(11));
+        REQUIRE(speeds.get(2001).x == 1);
+        REQUIRE(speeds.column<&speed::x>()[1999] == 0);
+    }
+
+    SECTION("Snapshot files lend their pages to the columns")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "stellarColumnsTest.bin";
+        Engine::Core::World first;
+        Engine::Core::World second;
+
+        world.snapshot(path);
+        first.registerComponents<vec3, speed>();
+        second.registerComponents<vec3>();
+        first.restore(path);
+        second.restore(path);
+
+        auto &mapped = first.getComponent<vec3>();
+
+#if defined(__unix__) || defined(__APPLE__)
+        REQUIRE(mapped.isMapped());
+        REQUIRE(first.getComponent<speed>().isMapped());
+#endif
+        REQUIRE(std::as_const(mapped).get(1234).x == 1234);
+        mapped.get(1234).field<&vec3::x>() = -1;
+        first.removeComponentFromEntity<vec3>(std::size_t {12});
+        REQUIRE(std::as_const(mapped).get(1234).x == -1);
+        REQUIRE(mapped.column<&vec3::x>()[12] == 0);
+        // The writes stay in the World that made them
+        REQUIRE(std::as_const(second.getComponent<vec3>()).get(1234).x == 1234);
+        REQUIRE(std::as_const(second.getComponent<vec3>()).get(12).x == 12);
+
+        for (std::size_t idx = 0; idx < 100; idx++) {
+            first.addComponentToEntity(first.createEntity(), vec3 {});
+        }
+        REQUIRE_FALSE(mapped.isMapped());
+        REQUIRE(std::as_const(mapped).get(1234).x == -1);
+        REQUIRE(mapped.count() == 3099);
+
+        Engine::Core::World third;
+
+        third.registerComponents<vec3>();
+        third.restore(path);
+        REQUIRE(std::as_const(third.getComponent<vec3>()).get(1234).x == 1234);
+        std::filesystem::remove(path);
+        REQUIRE(std::as_const(third.getComponent<vec3>()).get(2999).x == 2999);
+    }
+}
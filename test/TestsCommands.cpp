@@ -0,0 +1,165 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct ammo : public Engine::Component
+{
+    public:
+        explicit ammo(int aCount)
+            : count(aCount)
+        {}
+
+        int count;
+};
+
+struct label : public Engine::Component
+{
+    public:
+        explicit label(std::string aName)
+            : name(std::move(aName))
+        {}
+
+        std::string name;
+};
+
+TEST_CASE("CommandBuffer", "[Commands]")
+{
+    Engine::Core::World world;
+
+    world.registerComponents<ammo, label>();
+
+    SECTION("Commands are applied on flush only")
+    {
+        const auto entity = world.createEntity();
+        auto &commands = world.commands();
+
+        commands.add(entity, ammo {3});
+        REQUIRE_FALSE(world.hasComponents<ammo>(entity));
+        world.flushCommands();
+        REQUIRE(world.getComponent<ammo>().get(entity.index).count == 3);
+        REQUIRE(commands.empty());
+        commands.remove<ammo>(entity);
+        world.flushCommands();
+        REQUIRE_FALSE(world.hasComponents<ammo>(entity));
+    }
+    SECTION("Pending entities are resolved on flush")
+    {
+        auto &commands = world.commands();
+        const auto first = commands.spawn(ammo {1}, label {"first"});
+        const auto second = commands.spawn();
+
+        REQUIRE(Engine::Core::CommandBuffer::isPending(first));
+        commands.emplace<label>(second, "second");
+        REQUIRE(world.getCurrentId() == 0);
+        world.flushCommands();
+        REQUIRE(world.getCurrentId() == 2);
+        REQUIRE(world.getComponent<label>().get(0).name == "first");
+        REQUIRE(world.getComponent<ammo>().get(0).count == 1);
+        REQUIRE(world.getComponent<label>().get(1).name == "second");
+        REQUIRE_FALSE(world.hasComponents<ammo>(1));
+    }
+    SECTION("Commands on a component keep their order, kills come last")
+    {
+        const auto entity = world.createEntity();
+        auto &commands = world.commands();
+
+        commands.kill(entity);
+        commands.add(entity, ammo {1});
+        commands.remove<ammo>(entity);
+        commands.add(entity, ammo {2});
+        commands.kill(entity);
+        world.flushCommands();
+        REQUIRE_FALSE(world.hasComponents<ammo>(entity));
+        REQUIRE_FALSE(world.isAlive(entity));
+        REQUIRE(world.createEntity().index == entity.index);
+        REQUIRE(world.createEntity().index == entity.index + 1);
+    }
+    SECTION("Commands on an entity killed before the flush are dropped")
+    {
+        const auto entity = world.createEntity();
+        auto &commands = world.commands();
+
+        commands.add(entity, ammo {7});
+        commands.remove<label>(entity);
+        world.killEntity(entity);
+        world.flushCommands();
+        REQUIRE_FALSE(world.hasComponents<ammo>(entity.index));
+        REQUIRE(world.query<ammo>().getAllEntities().empty());
+    }
+    SECTION("Commands on a stale handle don't reach the entity reusing its index")
+    {
+        const auto entity = world.createEntity();
+        auto &commands = world.commands();
+
+        commands.add(entity, ammo {7});
+        commands.kill(entity);
+        world.killEntity(entity);
+        const auto reused = world.createEntity();
+
+        world.flushCommands();
+        REQUIRE(reused.index == entity.index);
+        REQUIRE(world.isAlive(reused));
+        REQUIRE_FALSE(world.hasComponents<ammo>(reused));
+    }
+    SECTION("A throwing system drops the commands of its stage")
+    {
+        Engine::Core::JobSystem jobs(2);
+        const auto entity = world.createEntity();
+
+        world.addComponentToEntity(entity, ammo {1});
+        auto recorder = Engine::Core::createSystem<const ammo>(world, "recorder", [&world](std::size_t idx,
+                                                                                         const ammo &) {
+            world.commands().add(world.getEntity(idx), label {"late"});
+            world.commands().spawn(ammo {2});
+        });
+        auto thrower = Engine::Core::createSystem<const ammo>(world, "thrower", [](const ammo &) {
+            throw std::runtime_error("system failed");
+        });
+
+        thrower.second->after("recorder");
+        world.addSystem(recorder);
+        world.addSystem(thrower);
+        REQUIRE_THROWS_AS(world.runSystems(jobs), std::runtime_error);
+        world.flushCommands();
+        REQUIRE_FALSE(world.hasComponents<label>(entity));
+        REQUIRE(world.getCurrentId() == 1);
+    }
+    SECTION("Structural changes from a query and from parallel systems")
+    {
+        Engine::Core::JobSystem jobs(4);
+
+        for (int idx = 0; idx < 1000; idx++) {
+            world.addComponentToEntity(world.createEntity(), ammo {idx});
+        }
+        world.query<ammo>().forEachParallel(
+            [&world](std::size_t idx, ammo &comp) {
+                if (comp.count % 2 == 0) {
+                    world.commands().kill(world.getEntity(idx));
+                }
+            },
+            16, jobs);
+        world.flushCommands();
+        REQUIRE(world.query<ammo>().getAll().size() == 500);
+
+        auto spawner = Engine::Core::createSystem<const ammo>(world, "spawner", [&world](const ammo &comp) {
+            world.commands().spawn(label {std::to_string(comp.count)});
+        });
+        auto reloader = Engine::Core::createSystem<const label>(world, "reloader", [&world](std::size_t idx,
+                                                                                          const label &) {
+            world.commands().add(world.getEntity(idx), ammo {0});
+        });
+
+        world.addSystem(spawner);
+        world.addSystem(reloader);
+        world.runSystems(jobs);
+        REQUIRE(world.query<label>().getAll().size() == 500);
+        REQUIRE(world.query<ammo>().getAll().size() == 500);
+        world.runSystems(jobs);
+        REQUIRE(world.query<label>().getAll().size() == 1000);
+        REQUIRE(world.query<ammo>().getAll().size() == 1000);
+    }
+}
@@ -3,6 +3,9 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include "Component.hpp"
 #include "ECS.hpp"
 #include <catch2/catch_test_macros.hpp>
@@ -17,6 +20,19 @@ struct testEvent : public Engine::Event::Event
         int hp;
 };
 
+class EventPusherSystem : public Engine::Core::System
+{
+    public:
+        explicit EventPusherSystem(Engine::Core::World &aWorld)
+            : Engine::Core::System(aWorld)
+        {}
+
+        void update() override
+        {
+            _world.get().getEventManager().pushEvent(testEvent {1});
+        }
+};
+
 TEST_CASE("Events")
 {
     Engine::Event::EventManager EventManager;
@@ -26,6 +42,8 @@ TEST_CASE("Events")
         EventManager.initEventHandler<testEvent>();
 
         EventManager.pushEvent(testEvent {10});
+        REQUIRE(EventManager.getEvents<testEvent>().empty());
+        EventManager.swapBuffers();
 
         REQUIRE(EventManager.getEvents<testEvent>().size() == 1);
         REQUIRE(EventManager.getEvents<testEvent>()[0].hp == 10);
@@ -35,6 +53,7 @@ TEST_CASE("Events")
     {
         EventManager.initEventHandler<testEvent>();
         EventManager.pushEvent(testEvent {10});
+        EventManager.swapBuffers();
         EventManager.keepEventsAndClear();
 
         REQUIRE(EventManager.getEvents<testEvent>().size() == 0);
@@ -44,32 +63,230 @@ TEST_CASE("Events")
     {
         EventManager.initEventHandler<testEvent>();
         EventManager.pushEvent(testEvent {10});
-        EventManager.keepEventsAndClear();
+        EventManager.swapBuffers();
         EventManager.pushEvent(testEvent {20});
+        EventManager.keepEventsAndClear();
 
         REQUIRE(EventManager.getEvents<testEvent>().size() == 1);
         REQUIRE(EventManager.getEvents<testEvent>()[0].hp == 20);
     }
 
-    SECTION("Register an event and push it then push another one and remove the first one")
+    SECTION("Register an event and push it then push another one and consume the first one")
     {
         EventManager.initEventHandler<testEvent>();
         EventManager.pushEvent(testEvent {10});
         EventManager.pushEvent(testEvent {20});
-        EventManager.removeEvent<testEvent>(0);
+        EventManager.swapBuffers();
+        EventManager.consumeEvent<testEvent>(0);
 
-        REQUIRE(EventManager.getEvents<testEvent>().size() == 1);
-        REQUIRE(EventManager.getEvents<testEvent>()[0].hp == 20);
+        std::vector<int> unconsumed;
+
+        EventManager.forEachEvent<testEvent>([&unconsumed](std::size_t /*idx*/, const testEvent &aEvent) {
+            unconsumed.push_back(aEvent.hp);
+        });
+        REQUIRE(EventManager.getEvents<testEvent>().size() == 2);
+        REQUIRE(EventManager.isEventConsumed<testEvent>(0));
+        REQUIRE_FALSE(EventManager.isEventConsumed<testEvent>(1));
+        REQUIRE(unconsumed == std::vector<int> {20});
     }
 
-    SECTION("Register an event and push it then push another one and remove the second one")
+    SECTION("Kept events survive the swap unless consumed")
     {
+        const std::vector<std::size_t> consumed = {1, 2};
+
         EventManager.initEventHandler<testEvent>();
         EventManager.pushEvent(testEvent {10});
         EventManager.pushEvent(testEvent {20});
-        EventManager.removeEvent<testEvent>(1);
+        EventManager.pushEvent(testEvent {30});
+        EventManager.swapBuffers();
+        EventManager.consumeEvents<testEvent>(consumed);
+        EventManager.pushEvent(testEvent {40});
+        EventManager.keepEventsAndClear<testEvent>();
+
+        const auto events = EventManager.getEvents<testEvent>();
 
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].hp == 10);
+        REQUIRE(events[1].hp == 40);
+        REQUIRE_FALSE(EventManager.isEventConsumed<testEvent>(0));
+    }
+
+    SECTION("Subscribers are called by priority, immediately or on swap")
+    {
+        std::vector<std::string> calls;
+
+        EventManager.subscribe<testEvent>(
+            [&calls](const testEvent &aEvent) {
+                calls.push_back("low " + std::to_string(aEvent.hp));
+            },
+            -1);
+        EventManager.subscribe<testEvent>(
+            [&calls](const testEvent &aEvent) {
+                calls.push_back("high " + std::to_string(aEvent.hp));
+            },
+            5);
+        EventManager.subscribe<testEvent>(
+            [&calls](const testEvent &aEvent) {
+                calls.push_back("now " + std::to_string(aEvent.hp));
+            },
+            0, Engine::Event::DispatchMode::Immediate);
+
+        EventManager.pushEvent(testEvent {1});
+        REQUIRE(calls == std::vector<std::string> {"now 1"});
+        EventManager.swapBuffers();
+        REQUIRE(calls == std::vector<std::string> {"now 1", "high 1", "low 1"});
+        EventManager.swapBuffers();
+        REQUIRE(calls.size() == 3);
+    }
+
+    SECTION("Unsubscribe, from outside or from the callback")
+    {
+        int calls = 0;
+        int onceCalls = 0;
+        Engine::Event::SubscriptionHandle once;
+        const auto handle = EventManager.subscribe<testEvent>([&calls](const testEvent &) {
+            calls++;
+        });
+
+        once = EventManager.subscribe<testEvent>([&EventManager, &onceCalls, &once](const testEvent &) {
+            onceCalls++;
+            EventManager.unsubscribe(once);
+        });
+        EventManager.pushEvent(testEvent {1});
+        EventManager.pushEvent(testEvent {2});
+        EventManager.swapBuffers();
+        REQUIRE(calls == 2);
+        REQUIRE(onceCalls == 1);
+        EventManager.unsubscribe(handle);
+        EventManager.unsubscribe(handle);
+        EventManager.pushEvent(testEvent {3});
+        EventManager.swapBuffers();
+        REQUIRE(calls == 2);
+        REQUIRE(onceCalls == 1);
         REQUIRE(EventManager.getEvents<testEvent>().size() == 1);
-        REQUIRE(EventManager.getEvents<testEvent>()[0].hp == 10);
+    }
+
+    SECTION("Immediate subscribers can't unsubscribe")
+    {
+        Engine::Event::SubscriptionHandle self;
+        bool refused = false;
+
+        self = EventManager.subscribe<testEvent>(
+            [&EventManager, &self, &refused](const testEvent &) {
+                try {
+                    EventManager.unsubscribe(self);
+                } catch (const Engine::Event::EventHandlerExceptionImmediateUnsubscribe &) {
+                    refused = true;
+                }
+            },
+            0, Engine::Event::DispatchMode::Immediate);
+        EventManager.pushEvent(testEvent {1});
+        REQUIRE(refused);
+        refused = false;
+        EventManager.unsubscribe(self);
+        EventManager.pushEvent(testEvent {2});
+        REQUIRE_FALSE(refused);
+    }
+
+    SECTION("Push events from several threads")
+    {
+        constexpr int producers = 8;
+        constexpr int eventsPerProducer = 5000;
+        std::vector<std::thread> threads;
+
+        EventManager.initEventHandler<testEvent>();
+        for (int producer = 0; producer < producers; producer++) {
+            threads.emplace_back([&EventManager, producer] {
+                for (int idx = 0; idx < eventsPerProducer; idx++) {
+                    EventManager.pushEvent(testEvent {producer * eventsPerProducer + idx});
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        EventManager.swapBuffers();
+
+        const auto events = EventManager.getEvents<testEvent>();
+        std::vector<int> lastOfProducer(producers, -1);
+        bool ordered = true;
+
+        REQUIRE(events.size() == producers * eventsPerProducer);
+        for (const auto &event : events) {
+            const auto producer = event.hp / eventsPerProducer;
+
+            ordered = ordered && event.hp > lastOfProducer[producer];
+            lastOfProducer[producer] = event.hp;
+        }
+        REQUIRE(ordered);
+    }
+
+    SECTION("Queued events live in the per-frame arena")
+    {
+        EventManager.initEventHandler<testEvent>();
+        for (int frame = 0; frame < 4; frame++) {
+            for (int idx = 0; idx < 1000; idx++) {
+                EventManager.pushEvent(testEvent {idx});
+            }
+            EventManager.swapBuffers();
+            REQUIRE(EventManager.getEvents<testEvent>().size() == 1000);
+            REQUIRE(EventManager.getEvents<testEvent>()[999].hp == 999);
+        }
+        // The two halves of the arena are warm, the next frames reuse their blocks
+        const auto capacity = EventManager.getArena().capacity();
+
+        for (int frame = 0; frame < 4; frame++) {
+            for (int idx = 0; idx < 1000; idx++) {
+                EventManager.pushEvent(testEvent {idx});
+            }
+            EventManager.swapBuffers();
+        }
+        REQUIRE(capacity > 0);
+        REQUIRE(EventManager.getArena().capacity() == capacity);
+    }
+}
+
+TEST_CASE("World events", "[Events]")
+{
+    Engine::Core::World first;
+    Engine::Core::World second;
+
+    first.getEventManager().initEventHandler<testEvent>();
+    second.getEventManager().initEventHandler<testEvent>();
+
+    SECTION("Each World has its own events")
+    {
+        first.getEventManager().pushEvent(testEvent {1});
+        first.getEventManager().swapBuffers();
+        second.getEventManager().swapBuffers();
+
+        REQUIRE(first.getEventManager().getEvents<testEvent>().size() == 1);
+        REQUIRE(second.getEventManager().getEvents<testEvent>().empty());
+        REQUIRE(&first.getEventManager() != &Engine::Event::EventManager::getInstance());
+    }
+    SECTION("Systems push through their World, worlds run in parallel")
+    {
+        constexpr int frames = 200;
+        std::vector<std::thread> threads;
+
+        for (auto *world : {&first, &second}) {
+            auto system = std::make_pair<std::string, std::unique_ptr<Engine::Core::System>>(
+                "pusher", std::make_unique<EventPusherSystem>(*world));
+
+            world->addSystem(system);
+            threads.emplace_back([world] {
+                Engine::Core::JobSystem jobs(1);
+
+                for (int frame = 0; frame < frames; frame++) {
+                    world->runSystems(jobs);
+                }
+                world->getEventManager().swapBuffers();
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        REQUIRE(first.getEventManager().getEvents<testEvent>().size() == frames);
+        REQUIRE(second.getEventManager().getEvents<testEvent>().size() == frames);
     }
 }
@@ -0,0 +1,141 @@
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct localOffset : public Engine::Component
+{
+    public:
+        explicit localOffset(int aValue)
+            : value(aValue)
+        {}
+
+        int value;
+};
+
+struct globalOffset : public Engine::Component
+{
+    public:
+        explicit globalOffset(int aValue)
+            : value(aValue)
+        {}
+
+        int value;
+};
+
+TEST_CASE("Hierarchy", "[Hierarchy]")
+{
+    Engine::Core::World world;
+
+    world.registerComponents<localOffset, globalOffset, Engine::Core::ChildOf>();
+    const auto ship = world.createEntity();
+    const auto turret = world.createEntity();
+    const auto barrel = world.createEntity();
+    const auto wing = world.createEntity();
+
+    world.setParent(turret, ship);
+    world.addComponentToEntity(barrel, Engine::Core::ChildOf(turret));
+    world.setParent(wing, ship);
+    const auto &hierarchy = world.getHierarchy();
+
+    SECTION("Entities are sorted by depth")
+    {
+        REQUIRE(world.getParent(barrel) == turret);
+        REQUIRE_FALSE(world.getParent(ship).has_value());
+        REQUIRE(hierarchy.getChildren(ship.index).size() == 2);
+        REQUIRE(hierarchy.getLevelCount() == 2);
+        REQUIRE(hierarchy.getLevel(1).size() == 2);
+        REQUIRE(hierarchy.getLevel(2).front() == barrel.index);
+        REQUIRE(world.query<const Engine::Core::ChildOf>().getAll().size() == 3);
+        REQUIRE_THROWS_AS(world.setParent(ship, barrel), Engine::Core::HierarchyExceptionCycle);
+    }
+
+    SECTION("Reparenting moves the whole subtree")
+    {
+        world.setParent(turret, wing);
+        REQUIRE(hierarchy.getDepth(turret.index) == 2);
+        REQUIRE(hierarchy.getDepth(barrel.index) == 3);
+        REQUIRE(hierarchy.getLevel(1).size() == 1);
+
+        world.removeComponentFromEntity<Engine::Core::ChildOf>(turret);
+        REQUIRE(hierarchy.getDepth(turret.index) == 0);
+        REQUIRE(hierarchy.getDepth(barrel.index) == 1);
+        REQUIRE(hierarchy.getLevelCount() == 1);
+
+        world.commands().add(turret, Engine::Core::ChildOf(ship));
+        world.flushCommands();
+        REQUIRE(hierarchy.getDepth(barrel.index) == 2);
+    }
+
+    SECTION("Propagation visits the parents first")
+    {
+        for (std::size_t idx = 0; idx < world.getCurrentId(); idx++) {
+            world.addComponentToEntity(idx, localOffset {static_cast<int>(idx + 1)});
+            world.addComponentToEntity(idx, globalOffset {static_cast<int>(idx + 1)});
+        }
+
+        const auto propagate = [&world](std::size_t aIdx, const localOffset &aLocal, globalOffset &aGlobal) {
+            const auto parent = world.getHierarchy().getParent(aIdx);
+
+            aGlobal.value = aLocal.value + world.getComponent<globalOffset>().get(parent).value;
+        };
+
+        world.query<const localOffset, globalOffset>().forEachByDepth(propagate);
+        REQUIRE(world.getComponent<globalOffset>().get(barrel.index).value == 3 + 2 + 1);
+        REQUIRE(world.getComponent<globalOffset>().get(wing.index).value == 4 + 1);
+
+        Engine::Core::JobSystem jobSystem(4);
+
+        world.getComponent<localOffset>().get(turret.index).value = 10;
+        world.query<const localOffset, globalOffset>().forEachByDepthParallel(propagate, 1, jobSystem);
+        REQUIRE(world.getComponent<globalOffset>().get(barrel.index).value == 3 + 10 + 1);
+        REQUIRE(world.getComponent<globalOffset>().get(ship.index).value == 1);
+    }
+
+    SECTION("Killing a parent kills its descendants")
+    {
+        world.killEntity(turret);
+        REQUIRE_FALSE(world.isAlive(barrel));
+        REQUIRE(world.isAlive(wing));
+        REQUIRE(hierarchy.getChildren(ship.index).size() == 1);
+        REQUIRE(hierarchy.getLevelCount() == 1);
+
+        world.killEntities(std::vector {ship});
+        REQUIRE_FALSE(world.isAlive(wing));
+        REQUIRE(hierarchy.getLevelCount() == 0);
+        REQUIRE(world.getComponent<Engine::Core::ChildOf>().count() == 0);
+    }
+
+    SECTION("Killing a parent can orphan its children")
+    {
+        world.killEntity(ship, Engine::Core::ChildPolicy::Orphan);
+        REQUIRE(world.isAlive(turret));
+        REQUIRE_FALSE(world.hasComponents<Engine::Core::ChildOf>(turret));
+        REQUIRE(hierarchy.getDepth(barrel.index) == 1);
+        REQUIRE(hierarchy.getLevel(1).front() == barrel.index);
+    }
+
+    SECTION("Spawning a batch links its parents")
+    {
+        const auto children = world.spawnBatch<Engine::Core::ChildOf>(3, [&wing](std::size_t) {
+            return std::make_tuple(Engine::Core::ChildOf(wing));
+        });
+
+        REQUIRE(world.getParent(children[0]) == wing);
+        REQUIRE(hierarchy.getChildren(wing.index).size() == 3);
+        world.killEntity(wing);
+        REQUIRE_FALSE(world.isAlive(children[2]));
+    }
+
+    SECTION("Snapshots restore the hierarchy")
+    {
+        Engine::Core::World other;
+
+        other.registerComponents<Engine::Core::ChildOf>();
+        other.restore(world.snapshot());
+        REQUIRE(other.getParent(barrel) == turret);
+        REQUIRE(other.getHierarchy().getLevel(1).size() == 2);
+    }
+}
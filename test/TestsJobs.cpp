@@ -0,0 +1,127 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct counter : public Engine::Component
+{
+    public:
+        explicit counter(int aValue)
+            : value(aValue)
+        {}
+
+        int value;
+};
+
+TEST_CASE("JobSystem", "[Jobs]")
+{
+    Engine::Core::JobSystem jobs(4);
+
+    SECTION("parallelFor visits every index once")
+    {
+        std::vector<std::atomic<int>> visits(10000);
+
+        jobs.parallelFor(0, visits.size(), 64, [&visits](std::size_t aBegin, std::size_t aEnd) {
+            for (auto idx = aBegin; idx < aEnd; idx++) {
+                visits[idx]++;
+            }
+        });
+        for (const auto &visit : visits) {
+            REQUIRE(visit == 1);
+        }
+    }
+    SECTION("Nested parallelFor doesn't deadlock")
+    {
+        std::atomic<std::size_t> total = 0;
+
+        jobs.parallelFor(0, 16, 1, [&jobs, &total](std::size_t /*begin*/, std::size_t /*end*/) {
+            jobs.parallelFor(0, 100, 10, [&total](std::size_t aBegin, std::size_t aEnd) {
+                total += aEnd - aBegin;
+            });
+        });
+        REQUIRE(total == 1600);
+    }
+    SECTION("wait rethrows the exception of a job")
+    {
+        Engine::Core::JobCounter group;
+
+        jobs.submit(
+            [] {
+                throw std::runtime_error("job failed");
+            },
+            group);
+        REQUIRE_THROWS_AS(jobs.wait(group), std::runtime_error);
+    }
+    SECTION("Pinned jobs run on their worker")
+    {
+        Engine::Core::JobCounter group;
+        std::vector<std::size_t> workers(jobs.getThreadCount(), Engine::Core::JobSystem::npos);
+
+        for (std::size_t idx = 0; idx < workers.size(); idx++) {
+            jobs.submitTo(
+                idx,
+                [&jobs, &workers, idx] {
+                    workers[idx] = jobs.getCurrentWorker();
+                },
+                group);
+        }
+        jobs.wait(group);
+        for (std::size_t idx = 0; idx < workers.size(); idx++) {
+            REQUIRE(workers[idx] == idx);
+        }
+    }
+}
+
+TEST_CASE("Parallel queries", "[Jobs]")
+{
+    Engine::Core::JobSystem jobs(4);
+    constexpr int count = 20000;
+
+    SECTION("World")
+    {
+        Engine::Core::World world;
+
+        world.registerComponent<counter>();
+        for (int idx = 0; idx < count; idx++) {
+            auto entity = world.createEntity();
+
+            if (idx % 3 != 0) {
+                world.addComponentToEntity(entity, counter {idx});
+            }
+        }
+        world.query<counter>().forEachParallel(
+            [](counter &comp) {
+                comp.value *= 2;
+            },
+            128, jobs);
+
+        for (int idx = 0; idx < count; idx++) {
+            if (idx % 3 != 0) {
+                REQUIRE(world.getComponent<counter>().get(idx).value == idx * 2);
+            }
+        }
+    }
+    SECTION("ArchetypeWorld")
+    {
+        Engine::Core::ArchetypeWorld world;
+        std::atomic<std::size_t> visited = 0;
+
+        world.registerComponent<counter>();
+        for (int idx = 0; idx < count; idx++) {
+            world.addComponentToEntity(world.createEntity(), counter {idx});
+        }
+        world.query<counter>().forEachParallel(
+            0,
+            [&visited](std::size_t idx, counter &comp) {
+                comp.value -= static_cast<int>(idx);
+                visited++;
+            },
+            1, jobs);
+
+        REQUIRE(visited == count);
+        REQUIRE(world.getComponentOfEntity<counter>(count - 1).value == 0);
+    }
+}
@@ -0,0 +1,101 @@
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct sample : public Engine::Component
+{
+    public:
+        int value = 0;
+
+        explicit sample(int aValue)
+            : value(aValue)
+        {}
+};
+
+#if STELLAR_PROFILING
+TEST_CASE("Profiler", "[Profiler]")
+{
+    auto &profiler = Engine::Core::Profiler::getInstance();
+    Engine::Core::World world;
+    Engine::Core::JobSystem jobs(2);
+
+    world.registerComponent<sample>();
+    for (int idx = 0; idx < 10; idx++) {
+        world.addComponentToEntity(world.createEntity(), sample(idx));
+    }
+    auto first = Engine::Core::createSystem<sample>(world, "profiledFirst", [](sample &comp) {
+        comp.value++;
+    });
+    auto second = Engine::Core::createSystem<const sample>(world, "profiledSecond", [](const sample &) {});
+
+    world.addSystem(first);
+    world.addSystem(second);
+    profiler.clear();
+
+    SECTION("Nothing is recorded while disabled")
+    {
+        Engine::Core::Profiler::setEnabled(false);
+        world.step(0, jobs);
+        REQUIRE(profiler.getStats("profiledFirst").calls == 0);
+    }
+    SECTION("The systems are timed with the entities they visit")
+    {
+        Engine::Core::Profiler::setEnabled(true);
+        for (int frame = 0; frame < 4; frame++) {
+            world.step(0, jobs);
+        }
+        Engine::Core::Profiler::setEnabled(false);
+
+        const auto stats = profiler.getStats("profiledFirst");
+
+        REQUIRE(stats.calls == 4);
+        REQUIRE(stats.frames == 4);
+        REQUIRE(stats.callsPerFrame == 1);
+        REQUIRE(stats.entitiesPerCall == 10);
+        REQUIRE(stats.minTime <= stats.averageTime);
+        REQUIRE(stats.averageTime <= stats.p99Time);
+        REQUIRE(stats.p99Time <= stats.maxTime);
+        REQUIRE(profiler.getStats("profiledSecond").calls == 4);
+        REQUIRE(profiler.getStats("World::step").calls == 4);
+        REQUIRE(profiler.getStats("unknown").calls == 0);
+    }
+    SECTION("The samples are written as Chrome trace events")
+    {
+        std::ostringstream trace;
+
+        Engine::Core::Profiler::setEnabled(true);
+        world.step(0, jobs);
+        Engine::Core::Profiler::setEnabled(false);
+        profiler.writeChromeTrace(trace);
+        REQUIRE(trace.str().starts_with("{\"traceEvents\":["));
+        REQUIRE(trace.str().find("\"name\":\"profiledFirst\",\"cat\":\"system\",\"ph\":\"X\"") != std::string::npos);
+        REQUIRE(trace.str().find("\"entities\":10") != std::string::npos);
+    }
+    SECTION("Late timestamps keep their nanoseconds")
+    {
+        std::ostringstream trace;
+
+        profiler.record(Engine::Core::ProfileSample {profiler.intern("late"), 0, 1, 754'123'456'789, 1'500, 0});
+        profiler.writeChromeTrace(trace);
+
+        const auto text = trace.str();
+        const auto timestamp = text.find("\"ts\":", text.find("\"name\":\"late\""));
+
+        REQUIRE(timestamp != std::string::npos);
+        REQUIRE(std::stod(text.substr(timestamp + 5)) == 754'123'456.789);
+        REQUIRE(text.find("\"ts\":754123456.789,\"dur\":1.500,") != std::string::npos);
+    }
+    SECTION("The rings keep the most recent samples")
+    {
+        Engine::Core::Profiler::setEnabled(true);
+        for (std::size_t idx = 0; idx < Engine::Core::Profiler::ringCapacity + 10; idx++) {
+            STELLAR_PROFILE_SCOPE(profiler.intern("ring"), idx);
+        }
+        Engine::Core::Profiler::setEnabled(false);
+        REQUIRE(profiler.getStats("ring").calls == Engine::Core::Profiler::ringCapacity);
+    }
+}
+#endif
@@ -3,6 +3,8 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <ranges>
+#include <vector>
 #include "Component.hpp"
 #include "ECS.hpp"
 #include <catch2/catch_test_macros.hpp>
@@ -134,7 +136,87 @@ TEST_CASE("Query")
 
         auto query = world.query<hp1, hp2, Player>().getAll();
         REQUIRE(query.size() == 2);
-        REQUIRE(std::get<0>(query[0]) == idx1);
-        REQUIRE(std::get<0>(query[1]) == idx2);
+        REQUIRE(std::get<0>(query[0]) == idx1.index);
+        REQUIRE(std::get<0>(query[1]) == idx2.index);
+    }
+
+    SECTION("The rarest component drives the query")
+    {
+        world.registerComponents<hp1, Player>();
+
+        for (const auto &entity : world.createEntities(1000)) {
+            world.addComponentToEntity(entity, hp1 {hps});
+        }
+        world.addComponentToEntity(700, Player {});
+        world.addComponentToEntity(3, Player {});
+
+        // The entities come in the order of the list of Player, not in the order of the indexes
+        REQUIRE(world.query<hp1, Player>().getAllEntities() == std::vector<std::size_t> {700, 3});
+
+        std::vector<std::size_t> viewed;
+
+        for (auto [idx, comp1, player] : world.view<hp1, Player>()) {
+            viewed.push_back(idx);
+        }
+        REQUIRE(viewed == std::vector<std::size_t> {700, 3});
+        world.removeComponentFromEntity<Player>(700);
+        REQUIRE(world.query<hp1, Player>().getAllEntities() == std::vector<std::size_t> {3});
+    }
+
+    SECTION("forEach accepts the short signatures")
+    {
+        world.registerComponents<hp1, hp2, Player>();
+
+        world.createEntity();
+        world.createEntity();
+
+        world.addComponentToEntity(0, hp1 {hps});
+        world.addComponentToEntity(1, hp1 {hps});
+        world.addComponentToEntity(1, hp2 {hps});
+
+        std::size_t sum = 0;
+        world.query<hp1>().forEach([&sum](std::size_t idx, hp1 &comp) {
+            sum += idx;
+            comp.hp++;
+        });
+        world.query<hp1, hp2>().forEach([](hp1 &comp1, hp2 &comp2) {
+            comp1.hp += comp2.maxHp;
+        });
+
+        REQUIRE(sum == 1);
+        REQUIRE(world.getComponent<hp1>().get(0).hp == hps + 1);
+        REQUIRE(world.getComponent<hp1>().get(1).hp == hps + 1 + hps);
+    }
+
+    SECTION("view")
+    {
+        world.registerComponents<hp1, hp2, Player>();
+
+        world.createEntity();
+        world.createEntity();
+        world.createEntity();
+
+        world.addComponentToEntity(0, hp1 {hps});
+        world.addComponentToEntity(2, hp1 {hps});
+        world.addComponentToEntity(0, hp2 {1});
+        world.addComponentToEntity(1, hp2 {2});
+        world.addComponentToEntity(2, hp2 {3});
+
+        auto view = world.view<hp1, hp2>();
+        STATIC_REQUIRE(std::ranges::view<decltype(view)>);
+        STATIC_REQUIRE(std::ranges::forward_range<decltype(view)>);
+
+        std::vector<std::size_t> ids;
+        for (auto [idx, comp1, comp2] : view) {
+            ids.push_back(idx);
+            comp1.hp = comp2.maxHp;
+        }
+        REQUIRE(ids == std::vector<std::size_t> {0, 2});
+        REQUIRE(world.getComponent<hp1>().get(2).hp == 3);
+
+        auto filtered = view | std::views::filter([](const auto &tuple) {
+                            return std::get<2>(tuple).maxHp > 1;
+                        });
+        REQUIRE(std::ranges::distance(filtered) == 1);
     }
 }
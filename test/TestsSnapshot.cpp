@@ -0,0 +1,184 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct point : public Engine::Component
+{
+    public:
+        float x = 0;
+        float y = 0;
+        std::uint8_t flags = 0;
+
+        static constexpr auto fields = std::make_tuple(&point::x, &point::y, &point::flags);
+};
+
+struct packedPoint : public point
+{
+    public:
+        using storageTag = Engine::Core::PackedStorage;
+
+        static constexpr std::string_view serialName = "packedPoint";
+};
+
+struct sparseVec2 : public Engine::Component
+{
+    public:
+        float x = 0;
+        float y = 0;
+
+        static constexpr auto fields = std::make_tuple(&sparseVec2::x, &sparseVec2::y);
+};
+
+struct transient : public Engine::Component
+{
+    public:
+        int value = 0;
+};
+
+TEST_CASE("World snapshots", "[Snapshot]")
+{
+    Engine::Core::World world;
+    std::vector<Engine::Core::Entity> entities;
+
+    world.registerComponents<point, packedPoint, transient>();
+    for (int idx = 0; idx < 200; idx++) {
+        const auto entity = world.createEntity();
+
+        entities.push_back(entity);
+        if (idx % 2 == 0) {
+            auto &comp = world.emplaceComponentToEntity<point>(entity);
+
+            comp.x = static_cast<float>(idx);
+            comp.y = -static_cast<float>(idx);
+            comp.flags = static_cast<std::uint8_t>(idx);
+        }
+        if (idx % 3 == 0) {
+            world.emplaceComponentToEntity<packedPoint>(entity).x = static_cast<float>(idx);
+        }
+        world.emplaceComponentToEntity<transient>(entity);
+    }
+    world.killEntity(entities[7]);
+
+    SECTION("A restored World has the same entities and components")
+    {
+        const auto data = world.snapshot();
+        Engine::Core::World copy;
+
+        copy.registerComponents<point, packedPoint, transient>();
+        copy.restore(data);
+        REQUIRE(copy.getCurrentId() == world.getCurrentId());
+        REQUIRE_FALSE(copy.isAlive(entities[7]));
+        REQUIRE(copy.isAlive(entities[8]));
+        REQUIRE(copy.getComponent<point>().count() == 100);
+        REQUIRE(copy.getComponent<packedPoint>().count() == 67);
+        REQUIRE(copy.getComponent<transient>().count() == 0);
+        for (std::size_t idx = 0; idx < 200; idx += 2) {
+            REQUIRE(copy.getComponent<point>()[idx].x == static_cast<float>(idx));
+            REQUIRE(copy.getComponent<point>()[idx].y == -static_cast<float>(idx));
+            REQUIRE(copy.getComponent<point>()[idx].flags == static_cast<std::uint8_t>(idx));
+        }
+        REQUIRE(copy.getComponent<packedPoint>()[99].x == 99);
+        REQUIRE(copy.hasComponents<point>(entities[10]));
+        REQUIRE_FALSE(copy.hasComponents<point>(entities[11]));
+        REQUIRE(copy.createEntity().index == entities[7].index);
+    }
+    SECTION("Snapshots go through streams")
+    {
+        std::stringstream stream;
+        Engine::Core::World copy;
+
+        world.snapshot(stream);
+        copy.registerComponents<point, transient>();
+        copy.restore(stream);
+        REQUIRE(copy.getComponent<point>().count() == 100);
+        REQUIRE(copy.getComponent<point>()[198].x == 198);
+    }
+    SECTION("Restoring replaces the state of the World")
+    {
+        const auto data = world.snapshot();
+
+        world.killEntity(entities[0]);
+        world.removeComponentFromEntity<point>(entities[2]);
+        world.restore(data);
+        REQUIRE(world.isAlive(entities[0]));
+        REQUIRE(world.getComponent<point>()[2].x == 2);
+        REQUIRE(world.query<point>().getAllEntities().size() == 100);
+    }
+    SECTION("Snapshot files are memory-mapped")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "stellarSnapshotTest.bin";
+        Engine::Core::World copy;
+
+        world.snapshot(path);
+        {
+            const Engine::Core::MappedFile file(path);
+
+            REQUIRE(file.getData().size() == world.snapshot().size());
+#if defined(__unix__) || defined(__APPLE__)
+            REQUIRE(file.isMapped());
+#endif
+        }
+        copy.registerComponents<point, packedPoint>();
+        copy.restore(path);
+        REQUIRE(copy.getComponent<point>()[4].y == -4);
+        REQUIRE(copy.getComponent<packedPoint>().count() == 67);
+        std::filesystem::remove(path);
+        REQUIRE_THROWS_AS(copy.restore(path), Engine::Core::SnapshotExceptionFile);
+    }
+    SECTION("Bad snapshots are rejected")
+    {
+        auto data = world.snapshot();
+
+        REQUIRE_THROWS_AS(world.restore(std::span(data).first(3)), Engine::Core::SnapshotExceptionVersion);
+        data[4] = std::byte {99};
+        REQUIRE_THROWS_AS(world.restore(data), Engine::Core::SnapshotExceptionVersion);
+        data[4] = std::byte {Engine::Core::snapshotVersion};
+        REQUIRE_THROWS_AS(world.restore(std::span(data).first(data.size() - 1)),
+                          Engine::Core::SnapshotExceptionCorrupted);
+    }
+    SECTION("Components are named by their type unless they have a serial name")
+    {
+        REQUIRE(Engine::Core::serialName<point>() == "point");
+        REQUIRE(Engine::Core::serialName<packedPoint>() == "packedPoint");
+        REQUIRE(world.getComponent<transient>().getSerialName().empty());
+    }
+    SECTION("Type names are spelled the same by every compiler")
+    {
+        const std::string name = "(anonymous)::tagged<point,unsigned int>";
+
+        REQUIRE(Engine::Core::normalizeTypeName("(anonymous namespace)::tagged<point, unsigned int>") == name);
+        REQUIRE(Engine::Core::normalizeTypeName("{anonymous}::tagged<point, unsigned int>") == name);
+        REQUIRE(Engine::Core::normalizeTypeName("struct `anonymous namespace'::tagged<struct point,unsigned int>")
+                == name);
+        REQUIRE(Engine::Core::normalizeTypeName("subclass") == "subclass");
+    }
+    SECTION("A strict restore refuses the snapshots of other components")
+    {
+        const auto data = world.snapshot();
+        Engine::Core::World partial;
+        Engine::Core::World wider;
+
+        partial.registerComponents<point>();
+        partial.emplaceComponentToEntity<point>(partial.createEntity()).x = 5;
+        REQUIRE_THROWS_AS(partial.restore(data, Engine::Core::RestorePolicy::Strict),
+                          Engine::Core::SnapshotExceptionMismatch);
+        REQUIRE(partial.getCurrentId() == 1);
+        REQUIRE(partial.getComponent<point>()[0].x == 5);
+
+        wider.registerComponents<point, packedPoint, sparseVec2>();
+        REQUIRE_THROWS_AS(wider.restore(data, Engine::Core::RestorePolicy::Strict),
+                          Engine::Core::SnapshotExceptionMismatch);
+
+        partial.registerComponents<packedPoint, transient>();
+        partial.restore(data, Engine::Core::RestorePolicy::Strict);
+        REQUIRE(partial.getComponent<point>().count() == 100);
+    }
+}
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct spot : public Engine::Component
+{
+    public:
+        spot(float aX, float aY, float aRadius)
+            : x(aX),
+              y(aY),
+              radius(aRadius)
+        {}
+
+        float x;
+        float y;
+        float radius;
+};
+
+namespace {
+    std::vector<std::size_t> sorted(std::vector<std::size_t> aEntities)
+    {
+        std::ranges::sort(aEntities);
+        return aEntities;
+    }
+
+    /**
+     * @brief Check an index against a walk over every entity
+     */
+    void checkIndex(Engine::Core::World &aWorld)
+    {
+        const auto &index = aWorld.spatial();
+        const Engine::Core::Aabb box {100, 200, 400, 350};
+        std::vector<std::size_t> inBox;
+        std::vector<std::size_t> inRadius;
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+
+        aWorld.query<const spot>().forEach([&inBox, &inRadius, &box](std::size_t aIdx, const spot &aSpot) {
+            const auto bounds = Engine::Core::SpatialTraits<spot>::bounds(aSpot);
+
+            if (bounds.overlaps(box)) {
+                inBox.push_back(aIdx);
+            }
+            if (bounds.distanceSquared(500, 500) <= 120 * 120) {
+                inRadius.push_back(aIdx);
+            }
+        });
+        aWorld.query<const spot>().forEach([&aWorld, &pairs](std::size_t aIdx, const spot &aSpot) {
+            aWorld.query<const spot>().forEach([&pairs, aIdx, &aSpot](std::size_t aOther, const spot &aOtherSpot) {
+                if (aOther > aIdx
+                    && Engine::Core::SpatialTraits<spot>::bounds(aSpot).overlaps(
+                        Engine::Core::SpatialTraits<spot>::bounds(aOtherSpot))) {
+                    pairs.emplace_back(aIdx, aOther);
+                }
+            });
+        });
+        auto found = index.findPairs();
+
+        // The queries visit the entities in the order of their storage
+        std::ranges::sort(found);
+        std::ranges::sort(pairs);
+        REQUIRE(sorted(index.queryAABB(box)) == sorted(inBox));
+        REQUIRE(sorted(index.queryRadius(500, 500, 120)) == sorted(inRadius));
+        REQUIRE(found == pairs);
+    }
+} // namespace
+
+TEST_CASE("Spatial index", "[Spatial]")
+{
+    Engine::Core::World world;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> coordinate(-50, 1050);
+    std::uniform_real_distribution<float> radius(0, 30);
+
+    world.registerComponents<spot>();
+    for (std::size_t idx = 0; idx < 500; idx++) {
+        world.addComponentToEntity(world.createEntity(), spot {coordinate(random), coordinate(random), radius(random)});
+    }
+    // Bigger than the cells and the area
+    world.addComponentToEntity(world.createEntity(), spot {500, 500, 800});
+    REQUIRE_THROWS_AS(world.spatial(), Engine::Core::WorldException);
+
+    SECTION("A hash grid follows the positions")
+    {
+        auto &grid = world.enableSpatial<spot>(64.F);
+
+        world.updateSpatial();
+        REQUIRE(grid.size() == 501);
+        checkIndex(world);
+
+        world.advanceChangeTick();
+        world.query<spot>().forEach([](spot &aSpot) {
+            aSpot.x += 40;
+        });
+        world.killEntity(world.getEntity(3));
+        world.removeComponentFromEntity<spot>(4);
+        REQUIRE_FALSE(grid.contains(3));
+        REQUIRE_FALSE(grid.contains(4));
+        world.runSystems();
+        REQUIRE(grid.size() == 499);
+        checkIndex(world);
+    }
+
+    SECTION("A loose quadtree follows the positions")
+    {
+        const auto &tree = world.enableSpatial<spot, Engine::Core::LooseQuadtree>(Engine::Core::Aabb {0, 0, 1000, 1000},
+                                                                                   5);
+
+        world.updateSpatial();
+        REQUIRE(tree.getDepth(500) == Engine::Core::LooseQuadtree::outside);
+        checkIndex(world);
+
+        world.advanceChangeTick();
+        world.query<spot>().forEach([](std::size_t aIdx, spot &aSpot) {
+            if (aIdx % 2 == 0) {
+                aSpot.y -= 75;
+                aSpot.radius /= 2;
+            }
+        });
+        world.updateSpatial();
+        checkIndex(world);
+
+        world.restore(world.snapshot());
+        REQUIRE(tree.size() == 0);
+    }
+}
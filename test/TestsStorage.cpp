@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include "Component.hpp"
+#include "ECS.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+struct life : public Engine::Component
+{
+    public:
+        explicit life(int aValue)
+            : value(aValue)
+        {}
+
+        int value;
+};
+
+struct tag : public Engine::Component
+{
+    public:
+        using storageTag = Engine::Core::PackedStorage;
+
+        explicit tag(int aValue)
+            : value(aValue)
+        {}
+
+        int value;
+};
+
+TEST_CASE("PackedArray", "[Storage]")
+{
+    Engine::Core::PackedArray<life> array;
+
+    for (std::size_t idx = 0; idx < 4; idx++) {
+        array.init(idx);
+    }
+
+    SECTION("Set and get a component")
+    {
+        array.set(2, life {5});
+        REQUIRE(array.has(2));
+        REQUIRE_FALSE(array.has(1));
+        REQUIRE(array.get(2).value == 5);
+        REQUIRE(array.size() == 1);
+    }
+    SECTION("Get an empty or out of range component")
+    {
+        REQUIRE_THROWS_AS(array.get(1), Engine::Core::SparseArrayExceptionEmpty);
+        REQUIRE_THROWS_AS(array.get(10), Engine::Core::SparseArrayExceptionOutOfRange);
+    }
+    SECTION("Erase keeps the array packed")
+    {
+        array.emplace(0, 1);
+        array.emplace(1, 2);
+        array.emplace(3, 4);
+        array.erase(0);
+        array.erase(0);
+
+        REQUIRE(array.size() == 2);
+        REQUIRE_FALSE(array.has(0));
+        REQUIRE(array.get(1).value == 2);
+        REQUIRE(array.get(3).value == 4);
+        for (std::size_t slot = 0; slot < array.size(); slot++) {
+            REQUIRE(array.get(array.entities()[slot]).value == (array.begin() + slot)->value);
+        }
+    }
+    SECTION("Emplace past the end grows the sparse index")
+    {
+        array.emplace(42, 7);
+        REQUIRE(array.has(42));
+        REQUIRE(array.get(42).value == 7);
+    }
+}
+
+struct anchor : public Engine::Component
+{
+    public:
+        using storageTag = Engine::Core::PagedStorage;
+
+        explicit anchor(int aValue)
+            : value(aValue)
+        {}
+
+        int value;
+};
+
+TEST_CASE("PagedArray", "[Storage]")
+{
+    Engine::Core::PagedArray<life> array;
+    constexpr auto pageSize = Engine::Core::PagedArray<life>::pageSize;
+
+    SECTION("Set and get a component")
+    {
+        array.init(3);
+        array.set(2, life {5});
+        REQUIRE(array.has(2));
+        REQUIRE_FALSE(array.has(1));
+        REQUIRE(array.get(2).value == 5);
+        REQUIRE(array.count() == 1);
+        REQUIRE_THROWS_AS(array.get(1), Engine::Core::SparseArrayExceptionEmpty);
+        REQUIRE_THROWS_AS(array.get(10), Engine::Core::SparseArrayExceptionOutOfRange);
+    }
+    SECTION("Growing never moves the components")
+    {
+        auto *first = &array.emplace(0, 1);
+
+        for (std::size_t idx = 1; idx < pageSize * 8; idx++) {
+            array.emplace(idx, static_cast<int>(idx));
+        }
+        REQUIRE(&array.get(0) == first);
+        REQUIRE(first->value == 1);
+        REQUIRE(array.count() == pageSize * 8);
+    }
+    SECTION("Only the pages holding components are allocated")
+    {
+        array.emplace(pageSize * 100, 1);
+        REQUIRE(array.size() == pageSize * 100 + 1);
+        REQUIRE(array.pageCount() == 1);
+
+        array.erase(pageSize * 100);
+        REQUIRE(array.count() == 0);
+        REQUIRE_FALSE(array.contains(pageSize * 100));
+        array.clear();
+        REQUIRE(array.pageCount() == 0);
+    }
+    SECTION("Pages come from the memory resource")
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        Engine::Core::World world(&resource);
+
+        world.registerComponents<life, anchor>();
+        const auto entity = world.createEntity();
+
+        world.emplaceComponentToEntity<anchor>(entity, 3);
+        world.emplaceComponentToEntity<life>(entity, 4);
+        REQUIRE(world.getComponent<anchor>().get(entity.index).value == 3);
+        REQUIRE(world.query<const life, const anchor>().getAllEntities().size() == 1);
+    }
+}
+
+TEST_CASE("Storage selection", "[Storage]")
+{
+    Engine::Core::World world;
+
+    STATIC_REQUIRE(std::is_same_v<Engine::Core::StorageOf<life>, Engine::Core::SparseArray<life>>);
+    STATIC_REQUIRE(std::is_same_v<Engine::Core::StorageOf<tag>, Engine::Core::PackedArray<tag>>);
+    STATIC_REQUIRE(std::is_same_v<Engine::Core::StorageOf<anchor>, Engine::Core::PagedArray<anchor>>);
+
+    SECTION("Query a packed component next to a sparse one")
+    {
+        world.registerComponents<life, tag>();
+
+        for (int idx = 0; idx < 8; idx++) {
+            auto entity = world.createEntity();
+            world.addComponentToEntity(entity, life {idx});
+        }
+        world.addComponentToEntity(5, tag {1});
+        world.addComponentToEntity(2, tag {1});
+
+        auto entities = world.query<life, tag>().getAllEntities();
+        std::sort(entities.begin(), entities.end());
+        REQUIRE(entities.size() == 2);
+        REQUIRE(entities[0] == 2);
+        REQUIRE(entities[1] == 5);
+        REQUIRE(world.getComponent<tag>().size() == 2);
+    }
+    SECTION("Kill an entity holding a packed component")
+    {
+        world.registerComponents<life, tag>();
+        auto first = world.createEntity();
+        auto second = world.createEntity();
+
+        world.addComponentToEntity(first, tag {1});
+        world.addComponentToEntity(second, tag {2});
+        world.killEntity(first);
+
+        REQUIRE(world.getComponent<tag>().size() == 1);
+        REQUIRE(world.getComponent<tag>().get(second.index).value == 2);
+    }
+    SECTION("Signatures follow the storages")
+    {
+        world.registerComponents<life, tag>();
+        auto entity = world.createEntity();
+
+        world.addComponentToEntity(entity, life {1});
+        world.emplaceComponentToEntity<tag>(entity, 2);
+        REQUIRE(world.getSignature(entity.index).count() == 2);
+        REQUIRE(world.hasComponents<life, tag>(entity));
+
+        world.removeComponentFromEntity<life>(entity);
+        REQUIRE_FALSE(world.hasComponents<life, tag>(entity));
+        REQUIRE(world.hasComponents<tag>(entity));
+
+        world.killEntity(entity);
+        REQUIRE(world.getSignature(entity.index).none());
+    }
+    SECTION("A rare packed component drives the query")
+    {
+        world.registerComponents<life, tag>();
+
+        for (int idx = 0; idx < 1000; idx++) {
+            world.addComponentToEntity(world.createEntity(), life {idx});
+        }
+        world.addComponentToEntity(999, tag {1});
+        world.addComponentToEntity(10, tag {1});
+
+        std::vector<std::size_t> visited;
+        world.query<life, tag>().forEach([&visited](std::size_t idx, life & /*life*/, tag & /*tag*/) {
+            visited.push_back(idx);
+        });
+        REQUIRE(visited == std::vector<std::size_t> {999, 10});
+    }
+}
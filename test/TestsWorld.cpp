@@ -1,8 +1,15 @@
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include "Component.hpp"
 #include "ECS.hpp"
 #include <catch2/catch_test_macros.hpp>
@@ -26,6 +33,13 @@ struct hp2 : public Engine::Component
         int maxHp;
 };
 
+template<std::size_t Number>
+struct numbered : public Engine::Component
+{
+    public:
+        int value = 0;
+};
+
 template<typename... Components>
 class MySystemClass : public Engine::Core::System
 {
@@ -43,11 +57,10 @@ class MySystemClass : public Engine::Core::System
         void update() override
         {
             _world.get().template query<Components...>().forEach(
-                _clock.getElapsedTime(), [this](Engine::Core::World & /*world*/, double /*deltaTime*/, std::size_t idx,
-                                                Components &...components) {
-                    this->updateSystem(_world.get(), _clock.getElapsedTime(), idx, components...);
+                _world.get().getDeltaTime(), [this](Engine::Core::World & /*world*/, double deltaTime, std::size_t idx,
+                                                    Components &...components) {
+                    this->updateSystem(_world.get(), deltaTime, idx, components...);
                 });
-            _clock.restart();
         }
 
     private:
@@ -66,7 +79,7 @@ TEST_CASE("World", "[World]")
     SECTION("Create an entity")
     {
         auto entity = world.createEntity();
-        REQUIRE(entity == 0);
+        REQUIRE(entity.index == 0);
     }
     SECTION("Create an entity and check if it's not the same")
     {
@@ -77,7 +90,67 @@ TEST_CASE("World", "[World]")
     {
         auto entity = world.createEntity();
         world.killEntity(entity);
-        REQUIRE(entity == world.createEntity());
+        auto reused = world.createEntity();
+        REQUIRE(entity.index == reused.index);
+        REQUIRE(entity != reused);
+    }
+    SECTION("Stale handles are detected")
+    {
+        auto entity = world.createEntity();
+        world.registerComponent<hp1>();
+        REQUIRE(world.isAlive(entity));
+        world.killEntity(entity);
+        REQUIRE_FALSE(world.isAlive(entity));
+        REQUIRE_THROWS_AS(world.killEntity(entity), Engine::Core::WorldExceptionDeadEntity);
+        auto reused = world.createEntity();
+        REQUIRE(world.isAlive(reused));
+        REQUIRE(world.getEntity(reused.index) == reused);
+        REQUIRE_THROWS_AS(world.addComponentToEntity(entity, hp1 {1}), Engine::Core::WorldExceptionDeadEntity);
+        REQUIRE_FALSE(world.hasComponents<hp1>(entity));
+        world.addComponentToEntity(reused, hp1 {1});
+        REQUIRE(world.hasComponents<hp1>(reused));
+    }
+    SECTION("Spawn and kill entities in batches")
+    {
+        world.registerComponents<hp1, hp2>();
+        auto lonely = world.createEntity();
+        world.killEntity(lonely);
+
+        auto entities = world.spawnBatch<hp1, hp2>(100, [](std::size_t idx) {
+            return std::make_tuple(hp1 {static_cast<int>(idx)}, hp2 {static_cast<int>(idx) * 2});
+        });
+        REQUIRE(entities.size() == 100);
+        REQUIRE(entities[0].index == lonely.index);
+        REQUIRE(entities[0].generation == lonely.generation + 1);
+        REQUIRE(world.getCurrentId() == 100);
+        REQUIRE(world.query<hp1, hp2>().getAll().size() == 100);
+        REQUIRE(world.getComponent<hp2>().get(entities[42].index).maxHp == 84);
+
+        auto empty = world.createEntities(10);
+        REQUIRE(empty.size() == 10);
+        REQUIRE_FALSE(world.hasComponents<hp1>(empty[0]));
+
+        std::vector<Engine::Core::Entity> doomed(entities.begin(), entities.begin() + 50);
+        doomed.push_back(entities[0]);
+        world.killEntities(doomed);
+        REQUIRE(world.query<hp1>().getAll().size() == 50);
+        REQUIRE_FALSE(world.isAlive(entities[0]));
+        REQUIRE_THROWS_AS(world.killEntities(doomed), Engine::Core::WorldExceptionDeadEntity);
+        REQUIRE(world.createEntities(51).size() == 51);
+        REQUIRE(world.getCurrentId() == 111);
+    }
+    SECTION("Freed indexes are reused last in, first out")
+    {
+        std::vector<Engine::Core::Entity> entities;
+
+        for (int idx = 0; idx < 4; idx++) {
+            entities.push_back(world.createEntity());
+        }
+        world.killEntity(entities[1]);
+        world.killEntity(entities[3]);
+        REQUIRE(world.createEntity().index == 3);
+        REQUIRE(world.createEntity().index == 1);
+        REQUIRE(world.createEntity().index == 4);
     }
 
     SECTION("Register a component and create an entity")
@@ -95,7 +168,60 @@ TEST_CASE("World", "[World]")
         auto hp1Comp = world.addComponentToEntity(entity, hp1 {10});
         REQUIRE(hp1Comp.hp == 10);
         world.killEntity(entity);
-        REQUIRE_THROWS_AS(world.query<hp1>().getComponentsOfEntity(entity), Engine::Core::SparseArrayExceptionEmpty);
+        REQUIRE_THROWS_AS(world.query<hp1>().getComponentsOfEntity(entity.index),
+                          Engine::Core::SparseArrayExceptionEmpty);
+    }
+
+    SECTION("Component ids are dense and per World")
+    {
+        Engine::Core::World other;
+
+        world.registerComponents<hp1, hp2>();
+        other.registerComponent<hp2>();
+
+        REQUIRE(world.getComponentId<hp1>() == 0);
+        REQUIRE(world.getComponentId<hp2>() == 1);
+        REQUIRE(other.getComponentId<hp2>() == 0);
+        REQUIRE_THROWS_AS(other.getComponentId<hp1>(), Engine::Core::WorldExceptionComponentNotRegistered);
+        world.removeComponent<hp1>();
+        REQUIRE_THROWS_AS(world.getComponent<hp1>(), Engine::Core::WorldExceptionComponentNotRegistered);
+        REQUIRE(world.getComponentId<hp2>() == 1);
+    }
+
+    SECTION("The ids of removed components are reused")
+    {
+        world.registerComponents<hp1>();
+        world.removeComponent<hp1>();
+        // More registrations than signature bits, but never more than two components at once
+        [&world]<std::size_t... Numbers>(std::index_sequence<Numbers...>) {
+            ((world.registerComponent<numbered<Numbers>>(), world.removeComponent<numbered<Numbers>>()), ...);
+        }(std::make_index_sequence<Engine::Core::maxComponents + 10> {});
+        world.registerComponents<hp2, hp1>();
+        REQUIRE(world.getComponentId<hp2>() == 0);
+        REQUIRE(world.getComponentId<hp1>() == 1);
+
+        const auto entity = world.createEntity();
+
+        world.addComponentToEntity(entity, hp1 {4});
+        REQUIRE_FALSE(world.hasComponents<hp2>(entity.index));
+        REQUIRE(world.query<hp1>().getAllEntities() == std::vector<std::size_t> {entity.index});
+    }
+
+    SECTION("A moved World keeps its storages bound")
+    {
+        world.registerComponents<hp1>();
+        world.addComponentToEntity(world.createEntity(), hp1 {1});
+
+        Engine::Core::World moved(std::move(world));
+
+        moved.addComponentToEntity(moved.createEntity(), hp1 {2});
+        REQUIRE(moved.query<hp1>().getAll().size() == 2);
+
+        Engine::Core::World assigned;
+
+        assigned = std::move(moved);
+        assigned.removeComponentFromEntity<hp1>(0);
+        REQUIRE(assigned.query<hp1>().getAllEntities() == std::vector<std::size_t> {1});
     }
 
     SECTION("Register a component after having created an entity")
@@ -152,3 +278,169 @@ TEST_CASE("World", "[World]")
         REQUIRE(hp2Comp3.maxHp == hps);
     }
 }
+
+TEST_CASE("Systems scheduling", "[World]")
+{
+    Engine::Core::World world;
+    Engine::Core::JobSystem jobs(4);
+
+    world.registerComponents<hp1, hp2>();
+    for (int idx = 0; idx < 8; idx++) {
+        const auto entity = world.createEntity();
+
+        world.addComponentToEntity(entity, hp1 {idx});
+        world.addComponentToEntity(entity, hp2 {idx});
+    }
+
+    SECTION("A const component is declared as read")
+    {
+        auto system = Engine::Core::createSystem<const hp1, hp2>(world, "system", [](const hp1 &, hp2 &) {});
+        const auto &access = system.second->getAccess();
+
+        REQUIRE_FALSE(access.exclusive);
+        REQUIRE(access.reads.size() == 1);
+        REQUIRE(access.writes.size() == 1);
+        REQUIRE(access.conflictsWith(
+            Engine::Core::createSystem<hp1>(world, "writer", [](hp1 &) {}).second->getAccess()));
+        REQUIRE_FALSE(access.conflictsWith(
+            Engine::Core::createSystem<const hp1>(world, "reader", [](const hp1 &) {}).second->getAccess()));
+    }
+    SECTION("Conflicting systems run in the order of their constraints, then of their names")
+    {
+        std::vector<std::string> runs;
+
+        for (const std::string name : {"a", "b", "c"}) {
+            auto system = Engine::Core::createSystem<hp1>(world, name, [&runs, name](std::size_t idx, hp1 &) {
+                if (idx == 0) {
+                    runs.push_back(name);
+                }
+            });
+
+            if (name == "c") {
+                system.second->before("a");
+            }
+            world.addSystem(system);
+        }
+        world.runSystems(jobs);
+        REQUIRE(runs == std::vector<std::string> {"b", "c", "a"});
+        REQUIRE(world.getSystemOrder() == runs);
+    }
+    SECTION("Writers of the same component never overlap")
+    {
+        std::atomic<int> running = 0;
+        std::atomic<bool> overlapped = false;
+
+        for (const std::string name : {"a", "b", "c", "d"}) {
+            auto system = Engine::Core::createSystem<hp1>(world, name, [&running, &overlapped](hp1 &comp) {
+                if (running.fetch_add(1) != 0) {
+                    overlapped = true;
+                }
+                comp.hp++;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                running.fetch_sub(1);
+            });
+
+            world.addSystem(system);
+        }
+        world.runSystems(jobs);
+        REQUIRE_FALSE(overlapped);
+        REQUIRE(world.getComponent<hp1>().get(0).hp == 4);
+    }
+    SECTION("Systems using disjoint components run concurrently")
+    {
+        std::atomic<int> arrived = 0;
+        std::atomic<bool> metOther = false;
+        // Each system waits for the other one: run one after the other, they would time out
+        const auto rendezvous = [&arrived, &metOther](std::size_t idx) {
+            if (idx != 0) {
+                return;
+            }
+            arrived++;
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+
+            while (arrived < 2 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            if (arrived == 2) {
+                metOther = true;
+            }
+        };
+        auto first = Engine::Core::createSystem<hp1>(world, "first", [&rendezvous](std::size_t idx, hp1 &) {
+            rendezvous(idx);
+        });
+        auto second = Engine::Core::createSystem<hp2>(world, "second", [&rendezvous](std::size_t idx, hp2 &) {
+            rendezvous(idx);
+        });
+
+        world.addSystem(first);
+        world.addSystem(second);
+        world.runSystems(jobs);
+        REQUIRE(metOther);
+    }
+    SECTION("A cycle in the constraints throws")
+    {
+        auto first = Engine::Core::createSystem<hp1>(world, "first", [](hp1 &) {});
+        auto second = Engine::Core::createSystem<hp2>(world, "second", [](hp2 &) {});
+
+        first.second->after("second");
+        second.second->after("first");
+        world.addSystem(first);
+        world.addSystem(second);
+        REQUIRE_THROWS_AS(world.runSystems(jobs), Engine::Core::WorldExceptionSystemCycle);
+    }
+}
+
+TEST_CASE("Fixed timestep", "[World]")
+{
+    Engine::Core::World world;
+    Engine::Core::JobSystem jobs(2);
+    std::vector<double> fixedDeltas;
+    std::vector<double> variableDeltas;
+    auto fixed = Engine::Core::createSystem<hp1>(world, "fixed", [&fixedDeltas, &world](std::size_t idx, hp1 &) {
+        if (idx == 0) {
+            fixedDeltas.push_back(world.getDeltaTime());
+        }
+    });
+    auto variable = Engine::Core::createSystem<hp1>(world, "variable",
+                                                    [&variableDeltas, &world](std::size_t idx, hp1 &) {
+                                                        if (idx == 0) {
+                                                            variableDeltas.push_back(world.getDeltaTime());
+                                                        }
+                                                    });
+
+    world.registerComponent<hp1>();
+    world.addComponentToEntity(world.createEntity(), hp1 {0});
+    fixed.second->stage(Engine::Core::SystemStage::Fixed);
+    world.addSystem(fixed);
+    world.addSystem(variable);
+    world.setFixedTimestep(0.25, 3);
+
+    SECTION("The fixed stage runs once per fixed timestep accumulated")
+    {
+        world.step(0.1, jobs);
+        REQUIRE(fixedDeltas.empty());
+        REQUIRE(variableDeltas == std::vector<double> {0.1});
+        world.step(0.5, jobs);
+        REQUIRE(fixedDeltas == std::vector<double> {0.25, 0.25});
+        REQUIRE(world.getFrameTime().fixedSteps == 2);
+        REQUIRE(world.getFrameTime().time == 0.5);
+        REQUIRE(variableDeltas == std::vector<double> {0.1, 0.5});
+    }
+    SECTION("The alpha is the leftover time over the fixed timestep")
+    {
+        world.step(0.375, jobs);
+        REQUIRE(world.getAlpha() == 0.5);
+    }
+    SECTION("The catch-up steps are capped")
+    {
+        world.step(10, jobs);
+        REQUIRE(fixedDeltas.size() == 3);
+        REQUIRE(world.getAlpha() < 1);
+        world.step(0, jobs);
+        REQUIRE(fixedDeltas.size() == 3);
+    }
+    SECTION("The fixed timestep must be positive")
+    {
+        REQUIRE_THROWS_AS(world.setFixedTimestep(0), Engine::Core::WorldException);
+    }
+}
@@ -9,7 +9,15 @@ end
 set_languages("cxx23")
 add_rules("mode.debug", "mode.release")
 
+-- Build the per-system profiler instrumentation (xmake f --profiling=n to compile it out)
+option("profiling")
+    set_default(true)
+    set_showmenu(true)
+    set_description("Enable the STELLAR_PROFILE_* instrumentation")
+option_end()
+
 includes("src")
 includes("test")
+includes("bench")
 
 add_headerfiles("includes/(**.hpp)")